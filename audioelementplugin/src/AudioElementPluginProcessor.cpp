@@ -21,6 +21,7 @@
 #include "AudioElementPluginEditor.h"
 #include "AudioElementVersionConverter.h"
 #include "data_structures/src/AudioElementSpatialLayout.h"
+#include "data_structures/src/CompactTreeCodec.h"
 #include "data_structures/src/ParameterMetaData.h"
 #include "logger/logger.h"
 #include "processors/audioelementplugin_publisher/AudioElementPluginDataPublisher.h"
@@ -58,7 +59,7 @@ AudioElementPluginProcessor::AudioElementPluginProcessor()
       &audioElementSpatialLayoutRepository_, &syncClient_, &ambisonicsData_));
   audioProcessors_.push_back(std::make_unique<RoutingProcessor>(
       &audioElementSpatialLayoutRepository_, &syncClient_,
-      getBusesLayout().getMainOutputChannelSet().size()));
+      getBusesLayout().getMainOutputChannelSet().size(), this));
 
   Logger::getInstance().init("EclipsaAudioElementPlugin");
 
@@ -228,7 +229,7 @@ void AudioElementPluginProcessor::getStateInformation(
   persistentState_.setProperty("version", ECLIPSA_VERSION, nullptr);
 #endif
 
-  copyXmlToBinary(*persistentState_.createXml(), destData);
+  destData = CompactTreeCodec::encode(persistentState_);
   persistentState_.removeChild(automationTree, nullptr);
 }
 
@@ -236,18 +237,25 @@ void AudioElementPluginProcessor::setStateInformation(const void* data,
                                                       int sizeInBytes) {
   LOG_ANALYTICS(instanceId_,
                 "Audio Element Plugin Processor setStateInformation \n");
-  std::unique_ptr<juce::XmlElement> xmlState(
-      getXmlFromBinary(data, sizeInBytes));
-
-  if (xmlState.get() && xmlState->hasTagName(persistentState_.getType())) {
-    persistentState_ = juce::ValueTree::fromXml(*xmlState);
+  juce::ValueTree state = CompactTreeCodec::decode(data, sizeInBytes);
+  if (!state.isValid()) {
+    // Sessions saved before the compact encoding store XML
+    std::unique_ptr<juce::XmlElement> xmlState(
+        getXmlFromBinary(data, sizeInBytes));
+    if (xmlState.get()) {
+      state = juce::ValueTree::fromXml(*xmlState);
+    }
   }
 
-  // Check the version converstion to see if version upgrade is needed and apply
-  // upgrades Do this before updating repositories since if we load the
-  // repositories and then update their values, it will cause tree change events
-  // on the processors, which normally updating the repositories would not do.
-  AudioElementVersionConverter::convertToLatestVersion(xmlState);
+  if (state.hasType(persistentState_.getType())) {
+    // Check the version converstion to see if version upgrade is needed and
+    // apply upgrades Do this before updating repositories since if we load the
+    // repositories and then update their values, it will cause tree change
+    // events on the processors, which normally updating the repositories would
+    // not do.
+    AudioElementVersionConverter::convertToLatestVersion(state);
+    persistentState_ = state;
+  }
 
   juce::ValueTree audioElementSpatialLayoutTree =
       persistentState_.getChildWithName(
@@ -30,4 +30,16 @@ void AudioElementVersionConverter::convertToLatestVersion(
 void AudioElementVersionConverter::convertFrom_NoVersion_To_1p1p1(
     std::unique_ptr<juce::XmlElement>& xmlState) {
   xmlState->setAttribute("version", "1.1.1");
-}
\ No newline at end of file
+}
+
+void AudioElementVersionConverter::convertToLatestVersion(juce::ValueTree& state) {
+  // Kept in step with the XML conversions above
+  if (!state.hasProperty("version")) {
+    convertFrom_NoVersion_To_1p1p1(state);
+  }
+}
+
+void AudioElementVersionConverter::convertFrom_NoVersion_To_1p1p1(
+    juce::ValueTree& state) {
+  state.setProperty("version", "1.1.1", nullptr);
+}
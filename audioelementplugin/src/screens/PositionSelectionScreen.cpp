@@ -130,7 +130,7 @@ void PositionSelectionScreen::valueTreePropertyChanged(
   // disable the z-position control if elevation is not none or flat
   if (property == AudioElementSpatialLayout::kElevation) {
     updateDialVisibility(static_cast<Elevation>(
-        audioElementSpatialLayoutRepo_->get().getElevation()));
+        audioElementSpatialLayoutRepo_->getSnapshot()->item.getElevation()));
   }
 }
 
@@ -158,10 +158,8 @@ float PositionSelectionScreen::getValue(const std::string& parameterLabel) {
 }
 
 void PositionSelectionScreen::updateDialVisibility(const Elevation elevation) {
-  if (audioElementSpatialLayoutRepo_->get().getElevation() !=
-          AudioElementSpatialLayout::Elevation::kNone &&
-      audioElementSpatialLayoutRepo_->get().getElevation() !=
-          AudioElementSpatialLayout::Elevation::kFlat) {
+  if (elevation != AudioElementSpatialLayout::Elevation::kNone &&
+      elevation != AudioElementSpatialLayout::Elevation::kFlat) {
     positionDials[z_dial_index]->setEnabled(false);
     positionDials[z_dial_index]->dimLookAndFeel();
   } else {
@@ -108,8 +108,8 @@ void RoomViewScreen::timerCallback() {
   trackData.y = parameterTree_->getYPosition();
   trackData.z = parameterTree_->getZPosition();
   // Loudness as an average of channels.
-  const int kNumCh = audioElementSpatialLayoutRepository_->get()
-                         .getChannelLayout()
+  const int kNumCh = audioElementSpatialLayoutRepository_->getSnapshot()
+                         ->item.getChannelLayout()
                          .getNumChannels();
   std::vector<float> loudnesses;
   spkrData_.playbackLoudness.read(loudnesses);
@@ -134,21 +134,18 @@ void RoomViewScreen::timerCallback() {
 void RoomViewScreen::valueTreePropertyChanged(
     juce::ValueTree& treeWhosePropertyHasChanged,
     const juce::Identifier& property) {
+  const auto snapshot = audioElementSpatialLayoutRepository_->getSnapshot();
+  const AudioElementSpatialLayout& spatialLayout = snapshot->item;
   LOG_ANALYTICS(AudioElementPluginProcessor::instanceId_,
                 "RoomViewScreen::updateSpeakerSetup" +
-                    audioElementSpatialLayoutRepository_->get()
-                        .getChannelLayout()
-                        .toString()
-                        .toStdString());
+                    spatialLayout.getChannelLayout().toString().toStdString());
 
   if (property == AudioElementSpatialLayout::kLayout) {
-    room_->setSpeakers(
-        audioElementSpatialLayoutRepository_->get().getChannelLayout());
+    room_->setSpeakers(spatialLayout.getChannelLayout());
     room_->setDisplaySpeakers(true);
   }
 
   if (property == AudioElementSpatialLayout::kPanningEnabled) {
-    selRoomElevation_.setVisible(
-        audioElementSpatialLayoutRepository_->get().isPanningEnabled());
+    selRoomElevation_.setVisible(spatialLayout.isPanningEnabled());
   }
 }
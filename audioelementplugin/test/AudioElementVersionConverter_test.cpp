@@ -32,4 +32,14 @@ TEST(AudioElementVersionConverterTest, DoesNotOverwriteExistingVersion) {
 
   AudioElementVersionConverter::convertToLatestVersion(xml);
   EXPECT_EQ(xml->getStringAttribute("version"), "1.1.1");
-}
\ No newline at end of file
+}
+
+TEST(AudioElementVersionConverterTest, AddsVersionPropertyToRestoredTree) {
+  juce::ValueTree state("State");
+  AudioElementVersionConverter::convertToLatestVersion(state);
+  EXPECT_EQ(state["version"].toString(), "1.1.1");
+
+  state.setProperty("version", "1.2.0", nullptr);
+  AudioElementVersionConverter::convertToLatestVersion(state);
+  EXPECT_EQ(state["version"].toString(), "1.2.0");
+}
@@ -13,7 +13,7 @@
 # limitations under the License.
 
 message(STATUS "Fetching Boost")
-set(BOOST_INCLUDE_LIBRARIES algorithm math optional variant lockfree log log_setup thread filesystem)
+set(BOOST_INCLUDE_LIBRARIES algorithm math optional variant lockfree interprocess log log_setup thread filesystem)
 set(BOOST_ENABLE_CMAKE ON)
 include(FetchContent)
 FetchContent_Declare(
@@ -24,4 +24,4 @@ FetchContent_Declare(
   URL "https://github.com/boostorg/boost/releases/download/boost-1.82.0/boost-1.82.0.tar.gz"
   CMAKE_ARGS -DBUILD_SHARED_LIBS=OFF)
 FetchContent_MakeAvailable(Boost)
-find_package(Boost 1.82.0 REQUIRED COMPONENTS algorithm math optional variant lockfree log log_setup thread filesystem)
+find_package(Boost 1.82.0 REQUIRED COMPONENTS algorithm math optional variant lockfree interprocess log log_setup thread filesystem)
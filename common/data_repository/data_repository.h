@@ -35,6 +35,7 @@ END_JUCE_MODULE_DECLARATION
 #include "implementation/ActiveMixPresentationRepository.h"
 #include "implementation/AudioElementRepository.h"
 #include "implementation/AudioElementSpatialLayoutRepository.h"
+#include "implementation/ExportJobRepository.h"
 #include "implementation/FileExportRepository.h"
 #include "implementation/MSPlaybackRepository.h"
 #include "implementation/MixPresentationLoudnessRepository.h"
@@ -0,0 +1,32 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "data_repository/implementation/FileExportRepository.h"
+#include "data_repository/repository_base/RepositoryMultiBase.h"
+#include "data_structures/src/ExportJob.h"
+
+using ExportJobRepository = RepositoryMultiBase<ExportJob>;
+
+// Export jobs are stored as a child of the file export state so they are
+// persisted and restored along with the rest of the export configuration.
+inline ExportJobRepository getExportJobRepository(
+    FileExportRepository& fileExportRepository) {
+  return ExportJobRepository(
+      fileExportRepository.getTree().getOrCreateChildWithName(
+          ExportJob::kJobListType, nullptr));
+}
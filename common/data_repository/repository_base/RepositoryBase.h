@@ -19,22 +19,214 @@
 #include <data_structures/data_structures.h>
 #include <juce_data_structures/juce_data_structures.h>
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+// Implemented by repository listeners that would rather respond once to a
+// batch of changes than to every change in it. Registered with
+// registerTransactionListener. While a transaction is open on a repository its
+// transaction listeners receive none of its ValueTree callbacks, and are told
+// once when the transaction commits if anything changed.
+class RepositoryTransactionListener : public juce::ValueTree::Listener {
+ public:
+  virtual void repositoryTransactionCommitted(juce::ValueTree& state) = 0;
+};
+
 template <RepositoryItem T>
 class RepositoryBase {
  public:
+  // Groups changes to the repository, see RepositoryTransactionListener.
+  // Commits when it goes out of scope if not committed before. Transactions
+  // nest, only the outermost one notifies.
+  class Transaction {
+   public:
+    explicit Transaction(RepositoryBase& repository)
+        : repository_(&repository) {
+      ++repository_->transactionDepth_;
+    }
+    Transaction(Transaction&& other) noexcept
+        : repository_(std::exchange(other.repository_, nullptr)) {}
+    ~Transaction() { commit(); }
+
+    void commit() {
+      if (repository_ != nullptr) {
+        std::exchange(repository_, nullptr)->endTransaction();
+      }
+    }
+
+   private:
+    RepositoryBase* repository_;
+
+    JUCE_DECLARE_NON_COPYABLE(Transaction)
+  };
+
+  [[nodiscard]] Transaction beginTransaction() { return Transaction(*this); }
+  bool isInTransaction() const { return transactionDepth_ > 0; }
+
   void setStateTree(juce::ValueTree state) { state_ = state; }
+
+  // Changes whenever the state tree or anything in it changes. Versions are
+  // unique across all repositories of the same item type, so a reader can
+  // compare against the last version it saw to skip redundant work.
+  uint64_t getVersion() const {
+    return version_.load(std::memory_order_acquire);
+  }
+
   void writeToStream(juce::MemoryOutputStream& stream) const {
     state_.writeToStream(stream);
   }
   void registerListener(juce::ValueTree::Listener* listener) {
-    state_.addListener(listener);
+    listeners_.add(listener);
   }
   void deregisterListener(juce::ValueTree::Listener* listener) {
-    state_.removeListener(listener);
+    listeners_.remove(listener);
+  }
+  void registerTransactionListener(RepositoryTransactionListener* listener) {
+    transactionListeners_.add(listener);
+  }
+  void deregisterTransactionListener(RepositoryTransactionListener* listener) {
+    transactionListeners_.remove(listener);
   }
 
  protected:
-  RepositoryBase() = default;
-  RepositoryBase(juce::ValueTree state) : state_(state) {}
+  RepositoryBase() { state_.addListener(&forwarder_); }
+  RepositoryBase(juce::ValueTree state) : state_(state) {
+    state_.addListener(&forwarder_);
+  }
+  RepositoryBase(const RepositoryBase& other) : state_(other.state_) {
+    state_.addListener(&forwarder_);
+  }
+  ~RepositoryBase() { state_.removeListener(&forwarder_); }
+
+  RepositoryBase& operator=(const RepositoryBase& other) {
+    // The forwarder stays attached and is told of the redirection
+    state_ = other.state_;
+    return *this;
+  }
+
+  // Internal listeners see every change before any registered listener, so
+  // derived state such as indexes is current when listeners read it
+  void addInternalListener(juce::ValueTree::Listener* listener) {
+    internalListeners_.add(listener);
+  }
+  void removeInternalListener(juce::ValueTree::Listener* listener) {
+    internalListeners_.removeFirstMatchingValue(listener);
+  }
+
+  // Returns the cached snapshot if it was built from the current version,
+  // otherwise builds and caches a new one. Readers on any thread share the
+  // returned snapshot, which is never modified.
+  template <typename Snapshot, typename Build>
+  std::shared_ptr<const Snapshot> getCachedSnapshot(
+      std::shared_ptr<const Snapshot>& cache, Build&& build) const {
+    const uint64_t version = getVersion();
+    {
+      const juce::SpinLock::ScopedLockType lock(snapshotLock_);
+      if (cache != nullptr && cache->version == version) {
+        return cache;
+      }
+    }
+
+    std::shared_ptr<const Snapshot> snapshot = build(version);
+    const juce::SpinLock::ScopedLockType lock(snapshotLock_);
+    cache = snapshot;
+    return snapshot;
+  }
+
   juce::ValueTree state_;
+
+ private:
+  static uint64_t nextVersion() {
+    static std::atomic<uint64_t> counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+  }
+
+  // The only listener attached to the state tree. Bumps the version and
+  // passes each change on, first to the internal listeners and then to the
+  // registered ones. Transaction listeners are held back during a transaction.
+  class Forwarder final : public juce::ValueTree::Listener {
+   public:
+    explicit Forwarder(RepositoryBase& repository) : repository_(repository) {}
+
+    void valueTreePropertyChanged(juce::ValueTree& tree,
+                                  const juce::Identifier& property) override {
+      changed([&](juce::ValueTree::Listener& listener) {
+        listener.valueTreePropertyChanged(tree, property);
+      });
+    }
+    void valueTreeChildAdded(juce::ValueTree& parentTree,
+                             juce::ValueTree& child) override {
+      changed([&](juce::ValueTree::Listener& listener) {
+        listener.valueTreeChildAdded(parentTree, child);
+      });
+    }
+    void valueTreeChildRemoved(juce::ValueTree& parentTree,
+                               juce::ValueTree& child, int index) override {
+      changed([&](juce::ValueTree::Listener& listener) {
+        listener.valueTreeChildRemoved(parentTree, child, index);
+      });
+    }
+    void valueTreeChildOrderChanged(juce::ValueTree& parentTree, int oldIndex,
+                                    int newIndex) override {
+      changed([&](juce::ValueTree::Listener& listener) {
+        listener.valueTreeChildOrderChanged(parentTree, oldIndex, newIndex);
+      });
+    }
+    void valueTreeParentChanged(juce::ValueTree& tree) override {
+      forward([&](juce::ValueTree::Listener& listener) {
+        listener.valueTreeParentChanged(tree);
+      });
+    }
+    void valueTreeRedirected(juce::ValueTree& tree) override {
+      changed([&](juce::ValueTree::Listener& listener) {
+        listener.valueTreeRedirected(tree);
+      });
+    }
+
+   private:
+    template <typename Callback>
+    void changed(Callback&& callback) {
+      repository_.version_.store(nextVersion(), std::memory_order_release);
+      if (repository_.isInTransaction()) {
+        repository_.changedInTransaction_ = true;
+      }
+      forward(callback);
+    }
+
+    template <typename Callback>
+    void forward(Callback&& callback) {
+      for (juce::ValueTree::Listener* listener :
+           repository_.internalListeners_) {
+        callback(*listener);
+      }
+      repository_.listeners_.call(callback);
+      if (!repository_.isInTransaction()) {
+        repository_.transactionListeners_.call(callback);
+      }
+    }
+
+    RepositoryBase& repository_;
+  };
+
+  void endTransaction() {
+    jassert(transactionDepth_ > 0);
+    if (--transactionDepth_ > 0 || !changedInTransaction_) {
+      return;
+    }
+    changedInTransaction_ = false;
+    transactionListeners_.call([this](RepositoryTransactionListener& listener) {
+      listener.repositoryTransactionCommitted(state_);
+    });
+  }
+
+  Forwarder forwarder_{*this};
+  juce::Array<juce::ValueTree::Listener*> internalListeners_;
+  juce::ListenerList<juce::ValueTree::Listener> listeners_;
+  juce::ListenerList<RepositoryTransactionListener> transactionListeners_;
+  int transactionDepth_ = 0;
+  bool changedInTransaction_ = false;
+  std::atomic<uint64_t> version_{nextVersion()};
+  mutable juce::SpinLock snapshotLock_;
 };
\ No newline at end of file
@@ -16,13 +16,41 @@
 
 #pragma once
 
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
 #include "RepositoryBase.h"
 
 template <RepositoryItem T>
 class RepositoryMultiBase : public RepositoryBase<T> {
  public:
-  RepositoryMultiBase() : RepositoryBase<T>() {}
-  RepositoryMultiBase(juce::ValueTree state) : RepositoryBase<T>(state) {}
+  // Immutable copy of every item, in tree order, as of a repository version
+  struct Snapshot {
+    uint64_t version;
+    std::vector<T> items;
+  };
+
+  RepositoryMultiBase() : RepositoryBase<T>() {
+    this->addInternalListener(&indexListener_);
+    rebuildIndex();
+  }
+  RepositoryMultiBase(juce::ValueTree state) : RepositoryBase<T>(state) {
+    this->addInternalListener(&indexListener_);
+    rebuildIndex();
+  }
+  RepositoryMultiBase(const RepositoryMultiBase& other)
+      : RepositoryBase<T>(other.state_) {
+    this->addInternalListener(&indexListener_);
+    rebuildIndex();
+  }
+  ~RepositoryMultiBase() { this->removeInternalListener(&indexListener_); }
+
+  RepositoryMultiBase& operator=(const RepositoryMultiBase& other) {
+    // The index listener is told of the redirection
+    this->state_ = other.state_;
+    return *this;
+  }
 
   T getOrAdd(juce::Uuid id) {
     juce::ValueTree found = getChildWithId(id);
@@ -78,6 +106,19 @@ class RepositoryMultiBase : public RepositoryBase<T> {
     }
   }
 
+  // Rebuilt only when the tree has changed since the last call
+  std::shared_ptr<const Snapshot> getSnapshot() const {
+    return this->getCachedSnapshot(snapshot_, [this](const uint64_t version) {
+      auto snapshot = std::make_shared<Snapshot>();
+      snapshot->version = version;
+      snapshot->items.reserve(getItemCount());
+      for (auto item : this->state_) {
+        snapshot->items.push_back(T::fromTree(item));
+      }
+      return std::shared_ptr<const Snapshot>(std::move(snapshot));
+    });
+  }
+
   bool update(const T& item) {
     juce::ValueTree existingItem = getChildWithId(item.getId());
     if (!existingItem.isValid()) {
@@ -108,8 +149,97 @@ class RepositoryMultiBase : public RepositoryBase<T> {
   juce::ValueTree getValueTree() const { return this->state_; }
 
  private:
+  // Keeps the ID index in step with changes made to the state tree, whether
+  // through this repository or any other reference to the tree. The index is
+  // only ever modified here, so lookups never write to it.
+  class IndexListener final : public juce::ValueTree::Listener {
+   public:
+    explicit IndexListener(RepositoryMultiBase& repository)
+        : repository_(repository) {}
+
+    void valueTreeChildAdded(juce::ValueTree& parentTree,
+                             juce::ValueTree& childWhichHasBeenAdded) override {
+      if (parentTree == repository_.state_) {
+        repository_.indexChild(childWhichHasBeenAdded);
+      }
+    }
+
+    void valueTreeChildRemoved(juce::ValueTree& parentTree,
+                               juce::ValueTree& childWhichHasBeenRemoved,
+                               int indexFromWhichChildWasRemoved) override {
+      juce::ignoreUnused(indexFromWhichChildWasRemoved);
+      if (parentTree == repository_.state_) {
+        repository_.unindexChild(childWhichHasBeenRemoved);
+      }
+    }
+
+    void valueTreePropertyChanged(juce::ValueTree& treeWhosePropertyHasChanged,
+                                  const juce::Identifier& property) override {
+      if (property == T::kId &&
+          treeWhosePropertyHasChanged.getParent() == repository_.state_) {
+        repository_.rebuildIndex();
+      }
+    }
+
+    void valueTreeRedirected(
+        juce::ValueTree& treeWhichHasBeenChanged) override {
+      juce::ignoreUnused(treeWhichHasBeenChanged);
+      repository_.rebuildIndex();
+    }
+
+   private:
+    RepositoryMultiBase& repository_;
+  };
+
+  static juce::Uuid getChildId(const juce::ValueTree& child) {
+    return juce::Uuid(child[T::kId].toString());
+  }
+
+  void indexChild(const juce::ValueTree& child) {
+    // With duplicate IDs the first child keeps the entry, as with a linear
+    // search
+    idIndex_.emplace(getChildId(child), child);
+    ++indexedChildren_;
+  }
+
+  void unindexChild(const juce::ValueTree& child) {
+    --indexedChildren_;
+    auto found = idIndex_.find(getChildId(child));
+    if (found != idIndex_.end() && found->second == child) {
+      idIndex_.erase(found);
+      // A duplicate of the removed child may now be the first with its ID
+      if (indexedChildren_ != (int)idIndex_.size()) {
+        rebuildIndex();
+      }
+    }
+  }
+
+  void rebuildIndex() {
+    idIndex_.clear();
+    indexedChildren_ = 0;
+    for (const auto& child : this->state_) {
+      indexChild(child);
+    }
+  }
+
   juce::ValueTree getChildWithId(juce::Uuid id) const {
     jassert(this->state_.isValid());
-    return this->state_.getChildWithProperty(T::kId, id.toString());
+    // Listeners attached to the tree outside the repository may look items up
+    // before the index has seen a change, which shows as a child count
+    // mismatch. Search the tree itself until the index catches up.
+    if (indexedChildren_ != this->state_.getNumChildren()) {
+      return this->state_.getChildWithProperty(T::kId, id.toString());
+    }
+
+    auto found = idIndex_.find(id);
+    if (found == idIndex_.end()) {
+      return {};
+    }
+    return found->second;
   }
+
+  IndexListener indexListener_{*this};
+  mutable std::shared_ptr<const Snapshot> snapshot_;
+  std::unordered_map<juce::Uuid, juce::ValueTree> idIndex_;
+  int indexedChildren_ = 0;
 };
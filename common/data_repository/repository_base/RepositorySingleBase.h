@@ -21,6 +21,12 @@
 template <RepositoryItem T>
 class RepositorySingleBase : public RepositoryBase<T> {
  public:
+  // Immutable copy of the item as of a repository version
+  struct Snapshot {
+    uint64_t version;
+    T item;
+  };
+
   RepositorySingleBase() : RepositoryBase<T>() {}
 
   RepositorySingleBase(juce::ValueTree state) : RepositoryBase<T>(state) {
@@ -31,9 +37,20 @@ class RepositorySingleBase : public RepositoryBase<T> {
 
   T get() const { return T::fromTree(this->state_); }
 
+  // Rebuilt only when the tree has changed since the last call
+  std::shared_ptr<const Snapshot> getSnapshot() const {
+    return this->getCachedSnapshot(snapshot_, [this](const uint64_t version) {
+      return std::shared_ptr<const Snapshot>(std::make_shared<Snapshot>(
+          Snapshot{version, T::fromTree(this->state_)}));
+    });
+  }
+
   juce::ValueTree getTree() { return this->state_; }
 
   void update(const T& item) {
     this->state_.copyPropertiesFrom(item.toValueTree(), nullptr);
   }
+
+ private:
+  mutable std::shared_ptr<const Snapshot> snapshot_;
 };
\ No newline at end of file
@@ -159,6 +159,182 @@ TEST(test_base_repository, get_all) {
   ASSERT_NE(*array.getUnchecked(0), *array.getUnchecked(1));
 }
 
+TEST(test_base_repository, get_tracks_tree_changes) {
+  juce::ValueTree state{treeType};
+  TestRepositoryMulti repositoryInstance(state);
+  TestRepositoryItem first(juce::Uuid(), 1);
+  repositoryInstance.add(first);
+  ASSERT_TRUE(repositoryInstance.get(first.getId()).has_value());
+
+  // Changes made to the tree outside the repository are seen by lookups
+  TestRepositoryItem second(juce::Uuid(), 2);
+  state.appendChild(second.toValueTree(), nullptr);
+  ASSERT_EQ(repositoryInstance.get(second.getId()), second);
+  state.removeChild(0, nullptr);
+  ASSERT_FALSE(repositoryInstance.get(first.getId()).has_value());
+
+  // As is an ID changed in place
+  TestRepositoryItem renamed(juce::Uuid(), 2);
+  state.getChild(0).setProperty(TestRepositoryItem::kId,
+                                renamed.getId().toString(), nullptr);
+  ASSERT_FALSE(repositoryInstance.get(second.getId()).has_value());
+  ASSERT_EQ(repositoryInstance.get(renamed.getId()), renamed);
+
+  // And a replaced state tree
+  juce::ValueTree replacement{treeType};
+  replacement.appendChild(first.toValueTree(), nullptr);
+  repositoryInstance.setStateTree(replacement);
+  ASSERT_EQ(repositoryInstance.get(first.getId()), first);
+  ASSERT_FALSE(repositoryInstance.get(renamed.getId()).has_value());
+
+  // Copies index the tree they share
+  TestRepositoryMulti copy(repositoryInstance);
+  replacement.appendChild(second.toValueTree(), nullptr);
+  ASSERT_EQ(copy.get(second.getId()), second);
+}
+
+TEST(test_base_repository, get_from_earlier_tree_listener) {
+  // Attached to the tree before the repository, so it sees a new child
+  // before the repository's index does
+  struct EarlyListener final : juce::ValueTree::Listener {
+    TestRepositoryMulti* repository = nullptr;
+    std::optional<TestRepositoryItem> found;
+
+    void valueTreeChildAdded(juce::ValueTree& parentTree,
+                             juce::ValueTree& child) override {
+      juce::ignoreUnused(parentTree);
+      found = repository->get(
+          juce::Uuid(child[TestRepositoryItem::kId].toString()));
+    }
+  };
+
+  juce::ValueTree state{treeType};
+  EarlyListener listener;
+  state.addListener(&listener);
+  TestRepositoryMulti repositoryInstance(state);
+  listener.repository = &repositoryInstance;
+
+  TestRepositoryItem item(juce::Uuid(), 3);
+  repositoryInstance.add(item);
+  EXPECT_EQ(listener.found, item);
+  EXPECT_EQ(repositoryInstance.get(item.getId()), item);
+  state.removeListener(&listener);
+}
+
+TEST(test_base_repository, multi_snapshot) {
+  TestRepositoryMulti repositoryInstance(juce::ValueTree{treeType});
+  TestRepositoryItem testItem({}, 3);
+  repositoryInstance.add(testItem);
+
+  // Shared until the tree changes
+  const auto snapshot = repositoryInstance.getSnapshot();
+  ASSERT_EQ(snapshot->items.size(), 1u);
+  ASSERT_EQ(snapshot->items[0], testItem);
+  ASSERT_EQ(snapshot->version, repositoryInstance.getVersion());
+  ASSERT_EQ(repositoryInstance.getSnapshot(), snapshot);
+
+  testItem.testMember_ = 4;
+  repositoryInstance.update(testItem);
+  const auto updated = repositoryInstance.getSnapshot();
+  ASSERT_NE(updated, snapshot);
+  ASSERT_NE(updated->version, snapshot->version);
+  ASSERT_EQ(updated->items[0], testItem);
+  // Earlier snapshots are left as they were
+  ASSERT_EQ(snapshot->items[0].testMember_, 3);
+
+  repositoryInstance.setStateTree(juce::ValueTree{treeType});
+  ASSERT_TRUE(repositoryInstance.getSnapshot()->items.empty());
+}
+
+class CountingListener final : public juce::ValueTree::Listener {
+ public:
+  void valueTreePropertyChanged(juce::ValueTree&,
+                                const juce::Identifier&) override {
+    ++changes_;
+  }
+  void valueTreeChildAdded(juce::ValueTree&, juce::ValueTree&) override {
+    ++changes_;
+  }
+
+  int changes_ = 0;
+};
+
+class CountingTransactionListener final
+    : public RepositoryTransactionListener {
+ public:
+  void valueTreePropertyChanged(juce::ValueTree&,
+                                const juce::Identifier&) override {
+    ++changes_;
+  }
+  void valueTreeChildAdded(juce::ValueTree&, juce::ValueTree&) override {
+    ++changes_;
+  }
+  void repositoryTransactionCommitted(juce::ValueTree&) override {
+    ++commits_;
+  }
+
+  int changes_ = 0;
+  int commits_ = 0;
+};
+
+TEST(test_base_repository, transaction_coalesces_notifications) {
+  TestRepositoryMulti repositoryInstance(juce::ValueTree{treeType});
+  CountingListener plainListener;
+  CountingTransactionListener transactionListener;
+  repositoryInstance.registerListener(&plainListener);
+  repositoryInstance.registerTransactionListener(&transactionListener);
+
+  // Outside a transaction every listener sees every change
+  TestRepositoryItem first({}, 1);
+  repositoryInstance.add(first);
+  ASSERT_EQ(plainListener.changes_, 1);
+  ASSERT_EQ(transactionListener.changes_, 1);
+  ASSERT_EQ(transactionListener.commits_, 0);
+
+  {
+    auto transaction = repositoryInstance.beginTransaction();
+    ASSERT_TRUE(repositoryInstance.isInTransaction());
+    repositoryInstance.add({});
+    {
+      // Only the outermost transaction notifies
+      auto nested = repositoryInstance.beginTransaction();
+      first.testMember_ = 2;
+      repositoryInstance.update(first);
+    }
+    ASSERT_EQ(transactionListener.commits_, 0);
+    // The index and snapshots stay current within a transaction
+    ASSERT_EQ(repositoryInstance.get(first.getId()), first);
+  }
+  ASSERT_FALSE(repositoryInstance.isInTransaction());
+  ASSERT_EQ(plainListener.changes_, 3);
+  ASSERT_EQ(transactionListener.changes_, 1);
+  ASSERT_EQ(transactionListener.commits_, 1);
+
+  // A transaction that changed nothing is not announced
+  repositoryInstance.beginTransaction().commit();
+  ASSERT_EQ(transactionListener.commits_, 1);
+
+  repositoryInstance.deregisterTransactionListener(&transactionListener);
+  repositoryInstance.add({});
+  ASSERT_EQ(transactionListener.changes_, 1);
+  repositoryInstance.deregisterListener(&plainListener);
+}
+
+TEST(test_base_repository, single_snapshot) {
+  TestRepositorySingle repositoryInstance(juce::ValueTree{treeType});
+  const auto snapshot = repositoryInstance.getSnapshot();
+  ASSERT_EQ(repositoryInstance.getSnapshot(), snapshot);
+
+  TestRepositoryItem testItem({}, 5);
+  repositoryInstance.update(testItem);
+  ASSERT_NE(repositoryInstance.getVersion(), snapshot->version);
+  ASSERT_EQ(repositoryInstance.getSnapshot()->item, testItem);
+
+  // A copy never mistakes a snapshot of the original for its own
+  TestRepositorySingle copy(repositoryInstance);
+  ASSERT_NE(copy.getVersion(), repositoryInstance.getVersion());
+}
+
 TEST(test_base_repository, single_get) {
   TestRepositorySingle repositoryInstance(juce::ValueTree{treeType});
   TestRepositoryItem defaultItem = repositoryInstance.get();
@@ -18,10 +18,16 @@
 #include "src/AudioElement.cpp"
 #include "src/AudioElementSpatialLayout.cpp"
 #include "src/ChannelGains.cpp"
+#include "src/CompactStateCache.cpp"
+#include "src/CompactTreeCodec.cpp"
+#include "src/ExportJob.cpp"
 #include "src/FileExport.cpp"
 #include "src/LanguageCodeMetaData.cpp"
 #include "src/MixPresentation.cpp"
 #include "src/MixPresentationLoudness.cpp"
 #include "src/MixPresentationSoloMute.cpp"
 #include "src/PlaybackMS.cpp"
-#include "src/RoomSetup.cpp"
\ No newline at end of file
+#include "src/RepositorySync.cpp"
+#include "src/RoomSetup.cpp"
+#include "src/SharedAudioBus.cpp"
+#include "src/SyncConnectionManager.cpp"
\ No newline at end of file
@@ -38,6 +38,9 @@ END_JUCE_MODULE_DECLARATION
 #include "src/AudioElementCommunication.h"
 #include "src/AudioElementSpatialLayout.h"
 #include "src/ChannelGains.h"
+#include "src/CompactStateCache.h"
+#include "src/CompactTreeCodec.h"
+#include "src/ExportJob.h"
 #include "src/FileExport.h"
 #include "src/LanguageCodeMetaData.h"
 #include "src/LoudnessExportData.h"
@@ -47,5 +50,8 @@ END_JUCE_MODULE_DECLARATION
 #include "src/ParameterMetaData.h"
 #include "src/PlaybackMS.h"
 #include "src/RepositoryItem.h"
+#include "src/RepositorySync.h"
 #include "src/RoomSetup.h"
-#include "src/SpeakerMonitorData.h"
\ No newline at end of file
+#include "src/SharedAudioBus.h"
+#include "src/SpeakerMonitorData.h"
+#include "src/SyncConnectionManager.h"
\ No newline at end of file
@@ -19,12 +19,20 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_core/juce_core.h>
 
+#include <atomic>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
 #include <boost/unordered_map.hpp>
+#include <cstdint>
 #include <iostream>
+#include <limits>
+#include <memory>
 #include <thread>
+#include <vector>
 
 #include "ParameterMetaData.h"
 #include "boost/unordered/unordered_map_fwd.hpp"
+#include "logger/logger.h"
 #include "zmq.hpp"
 
 struct AudioElementUpdateData {
@@ -45,23 +53,211 @@ struct AudioElementUpdateData {
   }
 };
 
+// One audio element plugin's entry in an audio element table. The writer
+// bumps the sequence number to an odd value while it updates the data, so
+// readers can detect a torn read and retry without locking. A sequence number
+// of zero means the slot has not been written since it was claimed. The
+// timestamp is the millisecond counter at the last write, used to expire stale
+// entries.
+struct AudioElementSlot {
+  std::atomic<uint32_t> sequence;
+  std::atomic<uint32_t> owner;
+  std::atomic<uint32_t> timestampMs;
+  AudioElementUpdateData data;
+};
+
+// Fixed size table of audio element slots. An all-zero table is a valid empty
+// table, so a freshly created shared memory region needs no initialization.
+struct AudioElementSlotTable {
+  static_assert(std::atomic<uint32_t>::is_always_lock_free,
+                "Slot atomics must be lock free to be shared across processes");
+
+  inline static constexpr uint32_t kVersion = 3;
+  inline static constexpr int kNumSlots = 256;
+  // Entries not written for this long are treated as gone, and their slots
+  // reclaimed. Publishers resend unchanged data well within this interval.
+  inline static constexpr uint32_t kExpiryMs = 5000;
+
+  std::atomic<uint32_t> version;
+  AudioElementSlot slots[kNumSlots];
+
+  // Claim a free or expired slot for a nonzero owner token, returns -1 if the
+  // table is full. Expired slots are taken over, so entries left behind by a
+  // plugin that crashed do not fill the table.
+  int claim(const uint32_t owner,
+            const uint32_t nowMs = juce::Time::getMillisecondCounter()) {
+    for (int i = 0; i < kNumSlots; ++i) {
+      AudioElementSlot& slot = slots[i];
+      uint32_t expected = slot.owner.load(std::memory_order_acquire);
+      if (expected != 0 && !isStale(i, nowMs)) {
+        continue;
+      }
+      if (slot.owner.compare_exchange_strong(expected, owner)) {
+        // Hide the previous owner's data until the new owner writes
+        slot.sequence.store(0, std::memory_order_release);
+        slot.timestampMs.store(nowMs, std::memory_order_release);
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  // True while the slot still belongs to the owner.
+  bool owns(const int index, const uint32_t owner) const {
+    return slots[index].owner.load(std::memory_order_acquire) == owner;
+  }
+
+  void release(const int index, const uint32_t owner) {
+    if (!owns(index, owner)) {
+      return;
+    }
+    write(index, AudioElementUpdateData());
+    uint32_t expected = owner;
+    slots[index].owner.compare_exchange_strong(expected, 0);
+  }
+
+  void write(const int index, const AudioElementUpdateData& data) {
+    AudioElementSlot& slot = slots[index];
+    const uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&slot.data, &data, sizeof(AudioElementUpdateData));
+    slot.timestampMs.store(juce::Time::getMillisecondCounter(),
+                           std::memory_order_relaxed);
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+  }
+
+  // True if the slot has not been written since the given time.
+  bool isStale(const int index, const uint32_t nowMs,
+               const uint32_t expiryMs = kExpiryMs) const {
+    const uint32_t timestamp =
+        slots[index].timestampMs.load(std::memory_order_relaxed);
+    return timestamp == 0 || nowMs - timestamp > expiryMs;
+  }
+
+  // Read a consistent copy of a claimed slot. Returns false if the slot is
+  // free, stale, not yet written, or kept changing while being read.
+  bool read(const int index, AudioElementUpdateData& data,
+            const uint32_t nowMs = juce::Time::getMillisecondCounter()) const {
+    const AudioElementSlot& slot = slots[index];
+    for (int attempt = 0; attempt < 4; ++attempt) {
+      if (slot.owner.load(std::memory_order_acquire) == 0 ||
+          isStale(index, nowMs)) {
+        return false;
+      }
+      const uint32_t before = slot.sequence.load(std::memory_order_acquire);
+      if (before == 0) {
+        return false;
+      }
+      if (before & 1) {
+        continue;
+      }
+      std::memcpy(&data, &slot.data, sizeof(AudioElementUpdateData));
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.sequence.load(std::memory_order_relaxed) == before) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+// Maps the audio element table shared by the plugins on this host. Plugins
+// fall back to ZMQ when the region cannot be opened, or was created by an
+// incompatible version.
+class AudioElementSharedMemory {
+ public:
+  AudioElementSharedMemory() {
+    namespace bip = boost::interprocess;
+    try {
+      bip::shared_memory_object shm(bip::open_or_create, kName,
+                                    bip::read_write);
+      bip::offset_t size = 0;
+      if (!shm.get_size(size) || size < (bip::offset_t)sizeof(*table_)) {
+        shm.truncate(sizeof(*table_));
+      }
+      region_ = bip::mapped_region(shm, bip::read_write, 0, sizeof(*table_));
+    } catch (const bip::interprocess_exception&) {
+      return;
+    }
+
+    AudioElementSlotTable* table =
+        static_cast<AudioElementSlotTable*>(region_.get_address());
+    uint32_t version = 0;
+    if (table->version.compare_exchange_strong(
+            version, AudioElementSlotTable::kVersion) ||
+        version == AudioElementSlotTable::kVersion) {
+      table_ = table;
+    }
+  }
+
+  // Null if the shared table is unavailable.
+  AudioElementSlotTable* getTable() const { return table_; }
+
+ private:
+  inline static const char* kName = "EclipsaAudioElements";
+
+  boost::interprocess::mapped_region region_;
+  AudioElementSlotTable* table_ = nullptr;
+};
+
+// Publishes an audio element's updates through a slot of the shared table,
+// or over ZMQ while it has none. A slot lost to expiry, or not free when the
+// publisher was created, is claimed again at a bounded rate.
 class AudioElementPublisher {
   zmq::socket_t socket_;
   zmq::context_t context_;
+  bool socketConnected_;
+  AudioElementSharedMemory sharedMemory_;
+  const uint32_t owner_;
+  int slot_;
+  uint32_t lastClaimMs_;
+  bool claimFailureLogged_;
 
  public:
-  AudioElementPublisher() {
-    // Create a zmq context
-    context_ = zmq::context_t(1);
-    // Create a zmq socket
-    socket_ = zmq::socket_t(context_, ZMQ_PUB);
-    // Bind to the socket
-    socket_.connect("tcp://localhost:5555");
+  // Claiming scans the whole table, so a full table is not rescanned more
+  // often than this
+  inline static constexpr uint32_t kClaimRetryMs = 1000;
+
+  AudioElementPublisher()
+      : socketConnected_(false),
+        owner_((uint32_t)juce::Random::getSystemRandom().nextInt(
+                   std::numeric_limits<int>::max()) +
+               1),
+        slot_(-1),
+        lastClaimMs_(0),
+        claimFailureLogged_(false) {
+    // Publish through the shared table when possible
+    if (!claimSlot()) {
+      connectSocket();
+    }
   }
 
-  ~AudioElementPublisher() { socket_.close(); }
+  ~AudioElementPublisher() {
+    if (slot_ >= 0) {
+      sharedMemory_.getTable()->release(slot_, owner_);
+    }
+    socket_.close();
+  }
 
   void publishData(AudioElementUpdateData data) {
+    AudioElementSlotTable* table = sharedMemory_.getTable();
+    if (table != nullptr) {
+      // Reclaim a slot if ours expired and was taken over
+      if (slot_ >= 0 && !table->owns(slot_, owner_)) {
+        slot_ = -1;
+      }
+      if (slot_ >= 0 || claimSlot()) {
+        table->write(slot_, data);
+        return;
+      }
+      if (!claimFailureLogged_) {
+        claimFailureLogged_ = true;
+        LOG_WARNING(0, "Audio element table is full, publishing over ZMQ");
+      }
+      connectSocket();
+    }
+
     // Create a zmq message
     zmq::message_t message(sizeof(AudioElementUpdateData));
     // Copy the data into the message
@@ -69,6 +265,35 @@ class AudioElementPublisher {
     // Send the message
     socket_.send(message);
   }
+
+ private:
+  bool claimSlot() {
+    AudioElementSlotTable* table = sharedMemory_.getTable();
+    const uint32_t now = juce::Time::getMillisecondCounter();
+    if (table == nullptr ||
+        (lastClaimMs_ != 0 && now - lastClaimMs_ < kClaimRetryMs)) {
+      return false;
+    }
+    lastClaimMs_ = now | 1;  // Zero until the first claim
+    slot_ = table->claim(owner_, now);
+    if (slot_ >= 0) {
+      claimFailureLogged_ = false;
+    }
+    return slot_ >= 0;
+  }
+
+  void connectSocket() {
+    if (socketConnected_) {
+      return;
+    }
+    // Create a zmq context
+    context_ = zmq::context_t(1);
+    // Create a zmq socket
+    socket_ = zmq::socket_t(context_, ZMQ_PUB);
+    // Bind to the socket
+    socket_.connect("tcp://localhost:5555");
+    socketConnected_ = true;
+  }
 };
 
 struct AudioElementPluginUuidHash {
@@ -90,14 +315,24 @@ struct AudioElementPluginUuidEqual {
   }
 };
 
+// Receives audio element updates from the plugins on this host. Updates
+// arriving over ZMQ are written by the listener thread into a local slot
+// table, so readers never block the listener and vice versa.
 class AudioElementSubscriber {
-  boost::unordered_map<std::array<char, 16>, AudioElementUpdateData,
-                       AudioElementPluginUuidHash, AudioElementPluginUuidEqual>
-      dataMap;
-  juce::ReadWriteLock dataMapLock;
+  // The listener thread owns every slot of the local table
+  inline static constexpr uint32_t kListenerOwner = 1;
+  // Only touched by the listener thread, maps an element to its slot
+  boost::unordered_map<std::array<char, 16>, int, AudioElementPluginUuidHash,
+                       AudioElementPluginUuidEqual>
+      slotIndex;
+  std::unique_ptr<AudioElementSlotTable> zmqTable;
+  // Entries written at or before this time were cleared by clearData()
+  std::atomic<uint32_t> clearedAtMs;
   zmq::socket_t socket;
   zmq::context_t context;
   std::thread listenerThread;
+  // Plugins publishing through shared memory are read from here instead
+  AudioElementSharedMemory sharedMemory;
 
   // Variables for retrying the connections and handling premature deletion
   bool closing;
@@ -105,7 +340,10 @@ class AudioElementSubscriber {
   std::condition_variable connectionCondition;
 
  public:
-  AudioElementSubscriber() : closing(false) {
+  AudioElementSubscriber()
+      : zmqTable(std::make_unique<AudioElementSlotTable>()),
+        clearedAtMs(0),
+        closing(false) {
     // Start a zmq topic to listen for messages from subscriber
     // Create a zmq context
     context = zmq::context_t(1);
@@ -160,12 +398,17 @@ class AudioElementSubscriber {
           context.close();
           break;
         }
+        if (message.size() != sizeof(AudioElementUpdateData)) {
+          continue;
+        }
         // Copy the message into a data struct
         AudioElementUpdateData d;
         memcpy(&d, message.data(), sizeof(AudioElementUpdateData));
-        // Write the data to the data map
-        juce::ScopedWriteLock writeLock(dataMapLock);
-        dataMap[d.uuid] = d;
+        // Write the data to the element's slot
+        const int slot = findSlot(d.uuid);
+        if (slot >= 0) {
+          zmqTable->write(slot, d);
+        }
       }
     });
   }
@@ -179,22 +422,67 @@ class AudioElementSubscriber {
     listenerThread.join();
   };
 
-  AudioElementUpdateData getData(
-      std::function<void(AudioElementUpdateData)> callback) const {
-    // Read the data map
-    juce::ScopedReadLock readLock(dataMapLock);
-    // Iterate through each element, calling the callback
-    for (auto it = dataMap.begin(); it != dataMap.end(); ++it) {
-      callback(it->second);
+  // Copy the current, unexpired elements into the given vector. The vector's
+  // storage is reused, so callers polling on a timer should keep it around.
+  void getSnapshot(std::vector<AudioElementUpdateData>& snapshot) const {
+    snapshot.clear();
+    const uint32_t now = juce::Time::getMillisecondCounter();
+    const uint32_t clearedAt = clearedAtMs.load(std::memory_order_relaxed);
+    auto readTable = [&](const AudioElementSlotTable& table,
+                         const bool honourClear) {
+      AudioElementUpdateData data;
+      for (int i = 0; i < AudioElementSlotTable::kNumSlots; ++i) {
+        // Skip elements last written before clearData()
+        if (honourClear && clearedAt != 0 &&
+            table.isStale(i, now, now - clearedAt)) {
+          continue;
+        }
+        if (table.read(i, data, now)) {
+          snapshot.push_back(data);
+        }
+      }
+    };
+    readTable(*zmqTable, true);
+    // Then the elements published through the shared table
+    if (const AudioElementSlotTable* table = sharedMemory.getTable()) {
+      readTable(*table, false);
+    }
+  }
+
+  void getData(std::function<void(AudioElementUpdateData)> callback) const {
+    std::vector<AudioElementUpdateData> snapshot;
+    getSnapshot(snapshot);
+    for (const AudioElementUpdateData& data : snapshot) {
+      callback(data);
     }
   }
 
-  // This will need to be called occasionally, (maybe before prepareToPlay) to
-  // avoid the map growing wildly
+  // Hide the elements received so far over ZMQ. Elements that are still
+  // publishing reappear with their next update.
   void clearData() {
-    // Write lock the data map
-    juce::ScopedWriteLock writeLock(dataMapLock);
-    // Clear the data map
-    dataMap.clear();
+    clearedAtMs.store(juce::Time::getMillisecondCounter() | 1,
+                      std::memory_order_relaxed);
+  }
+
+ private:
+  // Find or claim the slot for an element. Claiming reuses the slots of
+  // expired elements. Returns -1 if no slot is available.
+  int findSlot(const std::array<char, 16>& uuid) {
+    auto it = slotIndex.find(uuid);
+    if (it != slotIndex.end()) {
+      return it->second;
+    }
+
+    const int slot = zmqTable->claim(kListenerOwner);
+    if (slot < 0) {
+      return slot;
+    }
+    // Forget the expired element that held the slot, if any
+    auto previous = slotIndex.find(zmqTable->slots[slot].data.uuid);
+    if (previous != slotIndex.end() && previous->second == slot) {
+      slotIndex.erase(previous);
+    }
+    slotIndex[uuid] = slot;
+    return slot;
   }
 };
\ No newline at end of file
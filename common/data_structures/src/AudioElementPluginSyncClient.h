@@ -19,13 +19,16 @@
 #include "data_repository/implementation/AudioElementRepository.h"
 #include "data_repository/implementation/AudioElementSpatialLayoutRepository.h"
 #include "data_structures/src/AudioElement.h"
+#include "data_structures/src/RepositorySync.h"
+#include "data_structures/src/SyncConnectionManager.h"
 
 class AudioElementPluginListener {
  public:
   virtual void audioElementsUpdated() = 0;
 };
 
-class AudioElementPluginSyncClient : public juce::InterprocessConnection {
+class AudioElementPluginSyncClient : public juce::InterprocessConnection,
+                                     SyncConnectionManager::Client {
  protected:
   AudioElementRepository
       rendererAudioElements_;  // Make protected so it can be set in unit tests
@@ -34,11 +37,15 @@ class AudioElementPluginSyncClient : public juce::InterprocessConnection {
   AudioElementSpatialLayoutRepository* toRegister_;
   std::vector<AudioElementPluginListener*> listeners_;
   juce::CriticalSection rendererAudioElementsLock_;
+  RepositorySync::Decoder decoder_;  // Guarded by rendererAudioElementsLock_
+  RepositorySync::Encoder encoder_;  // Guarded by sendLock_
+  juce::CriticalSection sendLock_;
   int port_;
   bool initialized_;
   std::atomic_bool connected_{false};
   std::atomic_bool terminationRequested_{false};
-  std::thread connectionThread_;
+  juce::SharedResourcePointer<SyncConnectionManager> connectionManager_;
+  juce::WeakReference<AudioElementPluginSyncClient> self_;
 
  public:
   AudioElementPluginSyncClient(
@@ -46,15 +53,21 @@ class AudioElementPluginSyncClient : public juce::InterprocessConnection {
       int port)
       : toRegister_(AudioElementSpatialLayoutRepository),
         port_(port),
-        initialized_(false) {}
+        initialized_(false) {
+    self_ = this;
+  }
 
-  ~AudioElementPluginSyncClient() override {}
+  ~AudioElementPluginSyncClient() override {
+    connectionManager_->remove(this);
+  }
 
-  bool disconnectClient() {
-    juce::ScopedLock lock(rendererAudioElementsLock_);
-    listeners_.clear();
+  void disconnectClient() {
     terminationRequested_ = true;
-    connectionThread_.join();
+    connectionManager_->remove(this);
+    {
+      juce::ScopedLock lock(rendererAudioElementsLock_);
+      listeners_.clear();
+    }
     disconnect(30000);
   }
 
@@ -91,43 +104,70 @@ class AudioElementPluginSyncClient : public juce::InterprocessConnection {
     }
   }
 
-  void tryConnect() {  // Start a thread here to try and perform the connection
-    connectionThread_ = std::thread([this] {
-      // Try and connect, checking to see if deletion
-      // has been requested and we need to stop
-      while (!connected_ && !terminationRequested_) {
-        rendererAudioElementsLock_.enter();
-        bool connected = connectToSocket("localhost", port_, 30000);
-        if (connected) {
-          rendererAudioElementsLock_.exit();
-          connected_ = true;
-          sendAudioElementSpatialLayoutRepository();
-          return;
-        }
-        rendererAudioElementsLock_.exit();
-        std::this_thread::sleep_for(std::chrono::seconds(10));
-      };
-    });
+  // Connect through the process wide connection manager, which retries with
+  // backoff until the renderer is reachable
+  void tryConnect() {
+    if (!terminationRequested_) {
+      connectionManager_->add(this);
+    }
   }
 
   void connect() { tryConnect(); }
 
+  bool attemptConnection(const int timeoutMs) override {
+    if (terminationRequested_) {
+      return true;
+    }
+    // A new connection starts over from the full state both ways. The
+    // renderer sends its repository as soon as the connection is made.
+    {
+      juce::ScopedLock lock(rendererAudioElementsLock_);
+      decoder_.reset();
+    }
+    {
+      juce::ScopedLock sendLock(sendLock_);
+      encoder_.reset();
+    }
+
+    // Connect without holding the repository lock, so the UI is not blocked
+    if (!connectToSocket("localhost", port_, timeoutMs)) {
+      return false;
+    }
+    connected_ = true;
+    // The layout is edited on the message thread, so it is sent from there
+    juce::MessageManager::callAsync([self = self_] {
+      if (self != nullptr) {
+        self->sendAudioElementSpatialLayoutRepository();
+      }
+    });
+    return true;
+  }
+
   void connectionMade() override {}
 
   void connectionLost() override {
-    connected_ = true;  // Avoid possible deadlock if connection lost got called
-                        // while we are trying to connect. I don't think this
-                        // will happen in practice, but better safe
-    connectionThread_.join();
     connected_ = false;
-    if (!terminationRequested_) tryConnect();
+    tryConnect();
   }
 
   void messageReceived(const juce::MemoryBlock& message) override {
-    juce::MemoryInputStream stream(message, false);
-    juce::ValueTree repository = juce::ValueTree::readFromStream(stream);
     juce::ScopedLock lock(rendererAudioElementsLock_);
-    rendererAudioElements_.setStateTree(repository);
+    juce::ValueTree repository = rendererAudioElements_.getValueTree();
+    switch (decoder_.apply(message, repository)) {
+      case RepositorySync::Decoder::Result::kApplied:
+        break;
+      case RepositorySync::Decoder::Result::kResyncRequired:
+        sendMessage(RepositorySync::encodeResyncRequest());
+        return;
+      case RepositorySync::Decoder::Result::kResyncRequested:
+        sendFullAudioElementSpatialLayoutRepository();
+        return;
+      case RepositorySync::Decoder::Result::kInvalid:
+        return;
+    }
+    if (repository != rendererAudioElements_.getValueTree()) {
+      rendererAudioElements_.setStateTree(repository);
+    }
 
     for (auto listener : listeners_) {
       listener->audioElementsUpdated();
@@ -135,12 +175,23 @@ class AudioElementPluginSyncClient : public juce::InterprocessConnection {
     initialized_ = true;
   }
 
+  // Send the changes to the layout since it was last sent, if any
   void sendAudioElementSpatialLayoutRepository() {
     if (connected_) {
+      juce::ScopedLock lock(sendLock_);
       juce::MemoryBlock block;
-      juce::MemoryOutputStream stream(block, false);
-      toRegister_->writeToStream(stream);
-      sendMessage(block);
+      if (encoder_.encodeDelta(toRegister_->getTree(), block)) {
+        sendMessage(block);
+      }
     }
   }
+
+  void sendFullAudioElementSpatialLayoutRepository() {
+    if (connected_) {
+      juce::ScopedLock lock(sendLock_);
+      sendMessage(encoder_.encodeFullState(toRegister_->getTree()));
+    }
+  }
+
+  JUCE_DECLARE_WEAK_REFERENCEABLE(AudioElementPluginSyncClient)
 };
@@ -0,0 +1,38 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "CompactStateCache.h"
+
+CompactStateCache::CompactStateCache(
+    juce::ValueTree state, const CompactTreeCodec::Compression compression)
+    : state_(state), compression_(compression) {
+  state_.addListener(this);
+}
+
+CompactStateCache::~CompactStateCache() { state_.removeListener(this); }
+
+void CompactStateCache::setStateTree(juce::ValueTree state) {
+  // Redirecting the tree marks the encoding stale
+  state_ = state;
+  markStale();
+}
+
+juce::MemoryBlock CompactStateCache::getEncoded() {
+  const juce::ScopedLock lock(encodedLock_);
+  // Cleared before encoding, so a change made meanwhile is encoded next time
+  if (stale_.exchange(false, std::memory_order_acq_rel)) {
+    encoded_ = CompactTreeCodec::encode(state_, compression_);
+  }
+  return encoded_;
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <juce_data_structures/juce_data_structures.h>
+
+#include <atomic>
+
+#include "CompactTreeCodec.h"
+
+// Keeps the compact encoding of a state tree and encodes it again only after
+// the tree has changed. Hosts ask for plugin state on every autosave, far
+// more often than a session changes.
+class CompactStateCache final : private juce::ValueTree::Listener {
+ public:
+  explicit CompactStateCache(juce::ValueTree state,
+                             CompactTreeCodec::Compression compression =
+                                 CompactTreeCodec::Compression::kNone);
+  ~CompactStateCache() override;
+
+  // Follow another tree, such as one restored from the host.
+  void setStateTree(juce::ValueTree state);
+
+  // The encoding of the tree as it is now.
+  juce::MemoryBlock getEncoded();
+
+  // True when the next call to getEncoded() has to encode the tree.
+  bool isStale() const { return stale_.load(std::memory_order_acquire); }
+
+ private:
+  void markStale() { stale_.store(true, std::memory_order_release); }
+
+  void valueTreePropertyChanged(juce::ValueTree&,
+                                const juce::Identifier&) override {
+    markStale();
+  }
+  void valueTreeChildAdded(juce::ValueTree&, juce::ValueTree&) override {
+    markStale();
+  }
+  void valueTreeChildRemoved(juce::ValueTree&, juce::ValueTree&,
+                             int) override {
+    markStale();
+  }
+  void valueTreeChildOrderChanged(juce::ValueTree&, int, int) override {
+    markStale();
+  }
+  void valueTreeRedirected(juce::ValueTree&) override { markStale(); }
+
+  juce::ValueTree state_;
+  const CompactTreeCodec::Compression compression_;
+  juce::CriticalSection encodedLock_;
+  juce::MemoryBlock encoded_;
+  std::atomic<bool> stale_{true};
+};
@@ -0,0 +1,339 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "CompactTreeCodec.h"
+
+#include <unordered_map>
+
+namespace CompactTreeCodec {
+namespace {
+constexpr char kMagic[] = {'E', 'C', 'T', 'B'};
+// Followed by a zlib stream holding data with kMagic
+constexpr char kCompressedMagic[] = {'E', 'C', 'T', 'Z'};
+
+// Nesting deeper than this is treated as corrupt data
+constexpr int kMaxDepth = 64;
+
+enum class Tag : juce::uint8 {
+  kVoid = 0,
+  kUndefined = 1,
+  kFalse = 2,
+  kTrue = 3,
+  kInt = 4,
+  kInt64 = 5,
+  kDouble = 6,
+  kString = 7,
+  kUuid = 8,        // Undashed UUID string, as written by Uuid::toString()
+  kDashedUuid = 9,  // As written by Uuid::toDashedString()
+  kArray = 10,
+  kBinary = 11,
+  kOther = 12,  // Anything else, in var's own stream format
+};
+
+class IdentifierTable {
+ public:
+  void collect(const juce::ValueTree& tree) {
+    add(tree.getType());
+    for (int i = 0; i < tree.getNumProperties(); ++i) {
+      add(tree.getPropertyName(i));
+    }
+    for (const juce::ValueTree& child : tree) {
+      collect(child);
+    }
+  }
+
+  int indexOf(const juce::Identifier& id) const {
+    return indices_.at(id.getCharPointer().getAddress());
+  }
+
+  void write(juce::OutputStream& stream) const {
+    stream.writeCompressedInt(ids_.size());
+    for (const juce::Identifier& id : ids_) {
+      stream.writeString(id.toString());
+    }
+  }
+
+ private:
+  void add(const juce::Identifier& id) {
+    // Identifiers are pooled, so their character pointers are unique
+    if (indices_.emplace(id.getCharPointer().getAddress(), ids_.size())
+            .second) {
+      ids_.add(id);
+    }
+  }
+
+  juce::Array<juce::Identifier> ids_;
+  std::unordered_map<const char*, int> indices_;
+};
+
+void writeTree(const juce::ValueTree& tree, const IdentifierTable& ids,
+               juce::OutputStream& stream) {
+  stream.writeCompressedInt(ids.indexOf(tree.getType()));
+  stream.writeCompressedInt(tree.getNumProperties());
+  for (int i = 0; i < tree.getNumProperties(); ++i) {
+    const juce::Identifier name = tree.getPropertyName(i);
+    stream.writeCompressedInt(ids.indexOf(name));
+    writeValue(tree[name], stream);
+  }
+  stream.writeCompressedInt(tree.getNumChildren());
+  for (const juce::ValueTree& child : tree) {
+    writeTree(child, ids, stream);
+  }
+}
+
+// Read a count of items that each take at least one byte, failing if the
+// stream cannot hold them.
+bool readCount(juce::InputStream& stream, int& count) {
+  if (stream.isExhausted()) {
+    return false;
+  }
+  count = stream.readCompressedInt();
+  return count >= 0 && count <= stream.getNumBytesRemaining();
+}
+
+juce::ValueTree readTree(juce::InputStream& stream,
+                         const juce::Array<juce::Identifier>& ids,
+                         const int depth) {
+  const int type = stream.readCompressedInt();
+  if (depth > kMaxDepth || !juce::isPositiveAndBelow(type, ids.size())) {
+    return {};
+  }
+  juce::ValueTree tree(ids.getReference(type));
+
+  int numProperties = 0;
+  if (!readCount(stream, numProperties)) {
+    return {};
+  }
+  for (int i = 0; i < numProperties; ++i) {
+    const int name = stream.readCompressedInt();
+    if (!juce::isPositiveAndBelow(name, ids.size())) {
+      return {};
+    }
+    tree.setProperty(ids.getReference(name), readValue(stream), nullptr);
+  }
+
+  int numChildren = 0;
+  if (!readCount(stream, numChildren)) {
+    return {};
+  }
+  for (int i = 0; i < numChildren; ++i) {
+    juce::ValueTree child = readTree(stream, ids, depth + 1);
+    if (!child.isValid()) {
+      return {};
+    }
+    tree.appendChild(child, nullptr);
+  }
+  return tree;
+}
+
+juce::ValueTree readUncompressed(juce::InputStream& stream) {
+  const int schemaVersion = stream.readCompressedInt();
+  if (schemaVersion < 1 || schemaVersion > kSchemaVersion) {
+    return {};
+  }
+
+  int numIds = 0;
+  if (!readCount(stream, numIds)) {
+    return {};
+  }
+  juce::Array<juce::Identifier> ids;
+  ids.ensureStorageAllocated(numIds);
+  for (int i = 0; i < numIds; ++i) {
+    const juce::String name = stream.readString();
+    if (name.isEmpty()) {
+      return {};
+    }
+    ids.add(name);
+  }
+  return readTree(stream, ids, 0);
+}
+
+Tag getStringTag(const juce::String& string) {
+  if (string.length() == 32 && juce::Uuid(string).toString() == string) {
+    return Tag::kUuid;
+  }
+  if (string.length() == 36 && juce::Uuid(string).toDashedString() == string) {
+    return Tag::kDashedUuid;
+  }
+  return Tag::kString;
+}
+}  // namespace
+
+void writeValue(const juce::var& value, juce::OutputStream& stream) {
+  if (value.isVoid()) {
+    stream.writeByte(static_cast<char>(Tag::kVoid));
+  } else if (value.isUndefined()) {
+    stream.writeByte(static_cast<char>(Tag::kUndefined));
+  } else if (value.isBool()) {
+    stream.writeByte(static_cast<char>((bool)value ? Tag::kTrue : Tag::kFalse));
+  } else if (value.isInt()) {
+    stream.writeByte(static_cast<char>(Tag::kInt));
+    stream.writeCompressedInt(value);
+  } else if (value.isInt64()) {
+    stream.writeByte(static_cast<char>(Tag::kInt64));
+    stream.writeInt64(value);
+  } else if (value.isDouble()) {
+    stream.writeByte(static_cast<char>(Tag::kDouble));
+    stream.writeDouble(value);
+  } else if (value.isString()) {
+    const juce::String string = value.toString();
+    const Tag tag = getStringTag(string);
+    stream.writeByte(static_cast<char>(tag));
+    if (tag == Tag::kString) {
+      const size_t numBytes = string.getNumBytesAsUTF8();
+      stream.writeCompressedInt(static_cast<int>(numBytes));
+      stream.write(string.toRawUTF8(), numBytes);
+    } else {
+      stream.write(juce::Uuid(string).getRawData(), 16);
+    }
+  } else if (value.isArray()) {
+    stream.writeByte(static_cast<char>(Tag::kArray));
+    stream.writeCompressedInt(value.size());
+    for (const juce::var& element : *value.getArray()) {
+      writeValue(element, stream);
+    }
+  } else if (value.isBinaryData()) {
+    const juce::MemoryBlock* block = value.getBinaryData();
+    stream.writeByte(static_cast<char>(Tag::kBinary));
+    stream.writeCompressedInt(static_cast<int>(block->getSize()));
+    stream << *block;
+  } else {
+    stream.writeByte(static_cast<char>(Tag::kOther));
+    value.writeToStream(stream);
+  }
+}
+
+juce::var readValue(juce::InputStream& stream) {
+  const Tag tag = static_cast<Tag>(stream.readByte());
+  switch (tag) {
+    case Tag::kUndefined:
+      return juce::var::undefined();
+    case Tag::kFalse:
+      return false;
+    case Tag::kTrue:
+      return true;
+    case Tag::kInt:
+      return stream.readCompressedInt();
+    case Tag::kInt64:
+      return stream.readInt64();
+    case Tag::kDouble:
+      return stream.readDouble();
+    case Tag::kString: {
+      int numBytes = 0;
+      if (!readCount(stream, numBytes)) {
+        return {};
+      }
+      juce::MemoryBlock bytes;
+      stream.readIntoMemoryBlock(bytes, numBytes);
+      return bytes.toString();
+    }
+    case Tag::kUuid:
+    case Tag::kDashedUuid: {
+      juce::uint8 raw[16];
+      if (stream.read(raw, sizeof(raw)) != sizeof(raw)) {
+        return {};
+      }
+      const juce::Uuid uuid(raw);
+      return tag == Tag::kDashedUuid ? uuid.toDashedString() : uuid.toString();
+    }
+    case Tag::kArray: {
+      int size = 0;
+      if (!readCount(stream, size)) {
+        return {};
+      }
+      juce::Array<juce::var> array;
+      array.ensureStorageAllocated(size);
+      for (int i = 0; i < size; ++i) {
+        array.add(readValue(stream));
+      }
+      return array;
+    }
+    case Tag::kBinary: {
+      int numBytes = 0;
+      if (!readCount(stream, numBytes)) {
+        return {};
+      }
+      juce::MemoryBlock block;
+      stream.readIntoMemoryBlock(block, numBytes);
+      return block;
+    }
+    case Tag::kOther:
+      return juce::var::readFromStream(stream);
+    case Tag::kVoid:
+    default:
+      return {};
+  }
+}
+
+void write(const juce::ValueTree& tree, juce::OutputStream& stream,
+           const Compression compression) {
+  if (compression == Compression::kZlib) {
+    stream.write(kCompressedMagic, sizeof(kCompressedMagic));
+    juce::GZIPCompressorOutputStream deflated(stream);
+    write(tree, deflated, Compression::kNone);
+    deflated.flush();
+    return;
+  }
+
+  IdentifierTable ids;
+  ids.collect(tree);
+
+  stream.write(kMagic, sizeof(kMagic));
+  stream.writeCompressedInt(kSchemaVersion);
+  ids.write(stream);
+  writeTree(tree, ids, stream);
+}
+
+juce::ValueTree read(juce::InputStream& stream) {
+  char magic[sizeof(kMagic)];
+  if (stream.read(magic, sizeof(magic)) != sizeof(magic)) {
+    return {};
+  }
+  if (std::memcmp(magic, kMagic, sizeof(kMagic)) == 0) {
+    return readUncompressed(stream);
+  }
+  if (std::memcmp(magic, kCompressedMagic, sizeof(kCompressedMagic)) != 0) {
+    return {};
+  }
+
+  // Inflated up front, as reading checks counts against the bytes remaining
+  juce::MemoryBlock inflated;
+  {
+    juce::GZIPDecompressorInputStream inflater(
+        &stream, false, juce::GZIPDecompressorInputStream::zlibFormat);
+    inflater.readIntoMemoryBlock(inflated);
+  }
+  juce::MemoryInputStream inflatedStream(inflated, false);
+  if (inflatedStream.read(magic, sizeof(magic)) != sizeof(magic) ||
+      std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+    return {};
+  }
+  return readUncompressed(inflatedStream);
+}
+
+juce::MemoryBlock encode(const juce::ValueTree& tree,
+                         const Compression compression) {
+  juce::MemoryBlock block;
+  juce::MemoryOutputStream stream(block, false);
+  write(tree, stream, compression);
+  stream.flush();
+  return block;
+}
+
+juce::ValueTree decode(const void* data, const size_t sizeInBytes) {
+  juce::MemoryInputStream stream(data, sizeInBytes, false);
+  return read(stream);
+}
+
+}  // namespace CompactTreeCodec
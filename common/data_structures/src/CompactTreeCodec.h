@@ -0,0 +1,51 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <juce_data_structures/juce_data_structures.h>
+
+// Compact binary encoding for repository trees, used for host state and for
+// syncing repositories between plugins. Identifiers are written once in a
+// table and referenced by index, and UUID strings are stored as their raw 16
+// bytes. The encoding round trips a ValueTree exactly.
+namespace CompactTreeCodec {
+
+// Bump when the encoding changes. Data with a newer schema is rejected, data
+// with an older one must still be readable.
+inline constexpr int kSchemaVersion = 1;
+
+// Compressed data has its own magic, so readers detect it.
+enum class Compression { kNone, kZlib };
+
+// Write the tree, with its own identifier table, to the stream.
+void write(const juce::ValueTree& tree, juce::OutputStream& stream,
+           Compression compression = Compression::kNone);
+
+// Read a tree written by write(), compressed or not. Returns an invalid tree
+// if the data is not in this format, is truncated, or has a newer schema.
+juce::ValueTree read(juce::InputStream& stream);
+
+juce::MemoryBlock encode(const juce::ValueTree& tree,
+                         Compression compression = Compression::kNone);
+
+juce::ValueTree decode(const void* data, size_t sizeInBytes);
+
+// Write or read a single property value.
+void writeValue(const juce::var& value, juce::OutputStream& stream);
+juce::var readValue(juce::InputStream& stream);
+
+}  // namespace CompactTreeCodec
@@ -0,0 +1,48 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ExportJob.h"
+
+ExportJob::ExportJob() : RepositoryItemBase({}) {}
+
+ExportJob::ExportJob(juce::Uuid id) : RepositoryItemBase(id) {}
+
+ExportJob::ExportJob(juce::Uuid id, Speakers::AudioElementSpeakerLayout layout,
+                     juce::String exportFile, int bitDepth, bool enabled)
+    : RepositoryItemBase(id),
+      layout_(layout),
+      exportFile_(exportFile),
+      bitDepth_(bitDepth),
+      enabled_(enabled) {}
+
+bool ExportJob::operator==(const ExportJob& other) const {
+  return other.id_ == id_ && other.layout_ == layout_ &&
+         other.exportFile_ == exportFile_ && other.bitDepth_ == bitDepth_ &&
+         other.enabled_ == enabled_;
+}
+
+ExportJob ExportJob::fromTree(const juce::ValueTree tree) {
+  return ExportJob(juce::Uuid(tree[kId]),
+                   Speakers::AudioElementSpeakerLayout((int)tree[kLayout]),
+                   tree[kExportFile], tree[kBitDepth], tree[kEnabled]);
+}
+
+juce::ValueTree ExportJob::toValueTree() const {
+  return {kTreeType,
+          {{kId, id_.toString()},
+           {kLayout, (int)layout_},
+           {kExportFile, exportFile_},
+           {kBitDepth, bitDepth_},
+           {kEnabled, enabled_}}};
+}
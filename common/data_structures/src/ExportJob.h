@@ -0,0 +1,70 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <juce_data_structures/juce_data_structures.h>
+
+#include "data_structures/src/RepositoryItem.h"
+#include "substream_rdr/substream_rdr_utils/Speakers.h"
+
+// An additional deliverable produced during an export pass. The primary export
+// configured in FileExport (IAMF or room layout WAV) is always produced. Each
+// enabled export job renders the active mix presentation to its own playback
+// layout and writes it to its own WAV file from the same pass over the
+// timeline.
+class ExportJob final : public RepositoryItemBase {
+ public:
+  ExportJob();
+  ExportJob(juce::Uuid id);
+  ExportJob(juce::Uuid id, Speakers::AudioElementSpeakerLayout layout,
+            juce::String exportFile, int bitDepth, bool enabled = true);
+
+  bool operator==(const ExportJob& other) const;
+  bool operator!=(const ExportJob& other) const { return !(other == *this); }
+
+  static ExportJob fromTree(const juce::ValueTree tree);
+  virtual juce::ValueTree toValueTree() const override;
+
+  Speakers::AudioElementSpeakerLayout getLayout() const { return layout_; }
+  void setLayout(const Speakers::AudioElementSpeakerLayout layout) {
+    layout_ = layout;
+  }
+
+  juce::String getExportFile() const { return exportFile_; }
+  void setExportFile(const juce::String& exportFile) {
+    exportFile_ = exportFile;
+  }
+
+  int getBitDepth() const { return bitDepth_; }
+  void setBitDepth(const int bitDepth) { bitDepth_ = bitDepth; }
+
+  bool isEnabled() const { return enabled_; }
+  void setEnabled(const bool enabled) { enabled_ = enabled; }
+
+  inline static const juce::Identifier kTreeType{"export_job"};
+  // Type of the tree holding the list of export jobs.
+  inline static const juce::Identifier kJobListType{"export_jobs"};
+  inline static const juce::Identifier kLayout{"layout"};
+  inline static const juce::Identifier kExportFile{"export_file"};
+  inline static const juce::Identifier kBitDepth{"bit_depth"};
+  inline static const juce::Identifier kEnabled{"enabled"};
+
+ private:
+  Speakers::AudioElementSpeakerLayout layout_ = Speakers::kStereo;
+  juce::String exportFile_;
+  int bitDepth_ = 24;
+  bool enabled_ = true;
+};
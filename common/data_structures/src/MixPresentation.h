@@ -131,7 +131,7 @@ class MixPresentation final : public RepositoryItemBase {
   }
 
   juce::String getName() const { return mixPresentationName_; }
-  std::vector<MixPresentationAudioElement> getAudioElements() const {
+  const std::vector<MixPresentationAudioElement>& getAudioElements() const {
     return audioElements_;
   }
   void setDefaultMixGain(float defaultMixGain) {
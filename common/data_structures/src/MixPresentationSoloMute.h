@@ -105,7 +105,7 @@ class MixPresentationSoloMute final : public RepositoryItemBase {
   void setAudioElementMute(const juce::Uuid& id, const bool isMuted);
 
   AudioElementSoloMute getAudioElement(const juce::Uuid& id) const;
-  std::vector<AudioElementSoloMute> getAudioElements() const {
+  const std::vector<AudioElementSoloMute>& getAudioElements() const {
     return audioElements_;
   }
 
@@ -0,0 +1,334 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "RepositorySync.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "CompactTreeCodec.h"
+#include "RepositoryItem.h"
+
+namespace RepositorySync {
+namespace {
+enum class Op : juce::uint8 {
+  kSetProperty = 1,
+  kRemoveProperty = 2,
+  kAddChild = 3,
+  kRemoveChild = 4,
+  kMoveChild = 5,
+};
+
+// Children are addressed by their index path from the root
+using Path = juce::Array<int>;
+
+// Writes the operations turning the last sent snapshot into the tree, applying
+// each to the snapshot as a receiver would.
+struct DeltaWriter {
+  juce::MemoryOutputStream ops;
+  int numOps = 0;
+
+  void writeHeader(const Op op, const Path& path) {
+    ops.writeByte(static_cast<char>(op));
+    ops.writeCompressedInt(path.size());
+    for (const int index : path) {
+      ops.writeCompressedInt(index);
+    }
+    ++numOps;
+  }
+
+  void diff(juce::ValueTree& before, const juce::ValueTree& after,
+            Path& path) {
+    for (int i = 0; i < after.getNumProperties(); ++i) {
+      const juce::Identifier name = after.getPropertyName(i);
+      const juce::var* previous = before.getPropertyPointer(name);
+      const juce::var& current = after[name];
+      if (previous == nullptr || !previous->equalsWithSameType(current)) {
+        writeHeader(Op::kSetProperty, path);
+        ops.writeString(name.toString());
+        CompactTreeCodec::writeValue(current, ops);
+        before.setProperty(name, current, nullptr);
+      }
+    }
+    for (int i = before.getNumProperties() - 1; i >= 0; --i) {
+      const juce::Identifier name = before.getPropertyName(i);
+      if (!after.hasProperty(name)) {
+        writeHeader(Op::kRemoveProperty, path);
+        ops.writeString(name.toString());
+        before.removeProperty(name, nullptr);
+      }
+    }
+
+    diffChildren(before, after, path);
+  }
+
+  // Children are matched by id, and those without one by their order among
+  // the children without one. Matched children of the same type are moved
+  // into place and diffed, the others are removed or added whole.
+  void diffChildren(juce::ValueTree& before, const juce::ValueTree& after,
+                    Path& path) {
+    const juce::Identifier& kId = RepositoryItemBase::kId;
+    juce::HashMap<juce::String, juce::ValueTree> byId;
+    std::vector<juce::ValueTree> withoutId;
+    for (const juce::ValueTree& child : before) {
+      if (child.hasProperty(kId)) {
+        byId.set(child[kId].toString(), child);
+      } else {
+        withoutId.push_back(child);
+      }
+    }
+
+    // The child of the snapshot matching each child of the tree, if any
+    const int numAfter = after.getNumChildren();
+    std::vector<juce::ValueTree> matches(numAfter);
+    size_t nextWithoutId = 0;
+    for (int i = 0; i < numAfter; ++i) {
+      const juce::ValueTree current = after.getChild(i);
+      juce::ValueTree previous;
+      if (current.hasProperty(kId)) {
+        // Removed, so duplicate ids match once
+        const juce::String id = current[kId].toString();
+        previous = byId[id];
+        byId.remove(id);
+      } else if (nextWithoutId < withoutId.size()) {
+        previous = withoutId[nextWithoutId++];
+      }
+      if (previous.isValid() && previous.getType() == current.getType()) {
+        matches[i] = previous;
+      }
+    }
+
+    for (int i = before.getNumChildren() - 1; i >= 0; --i) {
+      if (std::find(matches.begin(), matches.end(), before.getChild(i)) ==
+          matches.end()) {
+        writeHeader(Op::kRemoveChild, path);
+        ops.writeCompressedInt(i);
+        before.removeChild(i, nullptr);
+      }
+    }
+
+    // The snapshot's children before i match the tree's, so a matched child
+    // is always found at i or after it
+    for (int i = 0; i < numAfter; ++i) {
+      const juce::ValueTree current = after.getChild(i);
+      juce::ValueTree previous = matches[i];
+      if (!previous.isValid()) {
+        writeHeader(Op::kAddChild, path);
+        ops.writeCompressedInt(i);
+        CompactTreeCodec::write(current, ops);
+        before.addChild(current.createCopy(), i, nullptr);
+        continue;
+      }
+
+      const int index = before.indexOf(previous);
+      if (index != i) {
+        writeHeader(Op::kMoveChild, path);
+        ops.writeCompressedInt(index);
+        ops.writeCompressedInt(i);
+        before.moveChild(index, i, nullptr);
+      }
+      path.add(i);
+      diff(previous, current, path);
+      path.removeLast();
+    }
+  }
+};
+
+void writeMessageHeader(juce::MemoryOutputStream& stream,
+                        const MessageType type, const juce::uint32 sequence) {
+  stream.writeByte(static_cast<char>(kMagic));
+  stream.writeByte(static_cast<char>(kProtocolVersion));
+  stream.writeByte(static_cast<char>(type));
+  stream.writeInt(static_cast<int>(sequence));
+}
+
+juce::MemoryBlock makeFullState(const juce::ValueTree& tree,
+                                const juce::uint32 sequence) {
+  juce::MemoryBlock block;
+  juce::MemoryOutputStream stream(block, false);
+  writeMessageHeader(stream, MessageType::kFullState, sequence);
+  CompactTreeCodec::write(tree, stream);
+  stream.flush();
+  return block;
+}
+
+bool readPath(juce::MemoryInputStream& stream, juce::ValueTree root,
+              juce::ValueTree& node) {
+  const int depth = stream.readCompressedInt();
+  if (depth < 0) {
+    return false;
+  }
+  node = root;
+  for (int i = 0; i < depth; ++i) {
+    const int index = stream.readCompressedInt();
+    if (index < 0 || index >= node.getNumChildren()) {
+      return false;
+    }
+    node = node.getChild(index);
+  }
+  return true;
+}
+
+// Apply the operations of a delta, returning false if the delta does not fit
+// the tree. Operations applied before the failure are kept, the caller
+// resynchronizes anyway.
+bool applyDelta(juce::MemoryInputStream& stream, juce::ValueTree& tree) {
+  const int numOps = stream.readCompressedInt();
+  for (int i = 0; i < numOps; ++i) {
+    if (stream.isExhausted()) {
+      return false;
+    }
+    const Op op = static_cast<Op>(stream.readByte());
+    juce::ValueTree node;
+    if (!readPath(stream, tree, node)) {
+      return false;
+    }
+    switch (op) {
+      case Op::kSetProperty: {
+        const juce::Identifier name(stream.readString());
+        node.setProperty(name, CompactTreeCodec::readValue(stream), nullptr);
+        break;
+      }
+      case Op::kRemoveProperty:
+        node.removeProperty(stream.readString(), nullptr);
+        break;
+      case Op::kAddChild: {
+        const int index = stream.readCompressedInt();
+        juce::ValueTree child = CompactTreeCodec::read(stream);
+        if (!child.isValid() || index < 0 || index > node.getNumChildren()) {
+          return false;
+        }
+        node.addChild(child, index, nullptr);
+        break;
+      }
+      case Op::kRemoveChild: {
+        const int index = stream.readCompressedInt();
+        if (index < 0 || index >= node.getNumChildren()) {
+          return false;
+        }
+        node.removeChild(index, nullptr);
+        break;
+      }
+      case Op::kMoveChild: {
+        const int from = stream.readCompressedInt();
+        const int to = stream.readCompressedInt();
+        if (from < 0 || from >= node.getNumChildren() || to < 0 ||
+            to >= node.getNumChildren()) {
+          return false;
+        }
+        node.moveChild(from, to, nullptr);
+        break;
+      }
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+juce::MemoryBlock Encoder::encodeFullState(const juce::ValueTree& tree) {
+  lastSent_ = tree.createCopy();
+  return makeFullState(lastSent_, ++sequence_);
+}
+
+bool Encoder::encodeDelta(const juce::ValueTree& tree,
+                          juce::MemoryBlock& block) {
+  if (!lastSent_.isValid() || lastSent_.getType() != tree.getType()) {
+    block = encodeFullState(tree);
+    return true;
+  }
+
+  DeltaWriter writer;
+  Path path;
+  writer.diff(lastSent_, tree, path);
+  if (writer.numOps == 0) {
+    return false;
+  }
+
+  block.reset();
+  juce::MemoryOutputStream stream(block, false);
+  writeMessageHeader(stream, MessageType::kDelta, ++sequence_);
+  stream.writeCompressedInt(writer.numOps);
+  stream << writer.ops.getMemoryBlock();
+  stream.flush();
+  return true;
+}
+
+juce::MemoryBlock Encoder::encodeLastState() const {
+  return makeFullState(lastSent_, sequence_);
+}
+
+void Encoder::reset() {
+  lastSent_ = juce::ValueTree();
+  sequence_ = 0;
+}
+
+Decoder::Result Decoder::apply(const juce::MemoryBlock& message,
+                               juce::ValueTree& tree) {
+  juce::MemoryInputStream stream(message, false);
+  if (message.getSize() < 7 || stream.readByte() != (char)kMagic ||
+      stream.readByte() != (char)kProtocolVersion) {
+    return Result::kInvalid;
+  }
+  const MessageType type = static_cast<MessageType>(stream.readByte());
+  const juce::uint32 sequence = static_cast<juce::uint32>(stream.readInt());
+
+  switch (type) {
+    case MessageType::kFullState: {
+      const juce::ValueTree state = CompactTreeCodec::read(stream);
+      if (!state.isValid()) {
+        return Result::kInvalid;
+      }
+      if (tree.isValid() && tree.getType() == state.getType()) {
+        tree.copyPropertiesAndChildrenFrom(state, nullptr);
+      } else {
+        tree = state;
+      }
+      sequence_ = sequence;
+      synced_ = true;
+      return Result::kApplied;
+    }
+    case MessageType::kDelta:
+      if (!synced_ || sequence != sequence_ + 1) {
+        synced_ = false;
+        return Result::kResyncRequired;
+      }
+      if (!applyDelta(stream, tree)) {
+        synced_ = false;
+        return Result::kResyncRequired;
+      }
+      sequence_ = sequence;
+      return Result::kApplied;
+    case MessageType::kResyncRequest:
+      return Result::kResyncRequested;
+    default:
+      return Result::kInvalid;
+  }
+}
+
+void Decoder::reset() {
+  sequence_ = 0;
+  synced_ = false;
+}
+
+juce::MemoryBlock encodeResyncRequest() {
+  juce::MemoryBlock block;
+  juce::MemoryOutputStream stream(block, false);
+  writeMessageHeader(stream, MessageType::kResyncRequest, 0);
+  stream.flush();
+  return block;
+}
+
+}  // namespace RepositorySync
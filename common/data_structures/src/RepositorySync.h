@@ -0,0 +1,90 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <juce_data_structures/juce_data_structures.h>
+
+// Versioned delta protocol used to keep repositories in sync between plugin
+// instances. A sender first sends its full tree, and after that only the
+// properties and children that changed, with children matched by their id so
+// reordering a repository moves its items rather than rewriting them. Every
+// message carries a sequence
+// number, and a receiver that misses one asks for the full tree again. Trees
+// and values are written with CompactTreeCodec.
+namespace RepositorySync {
+
+inline constexpr juce::uint8 kMagic = 0xFF;  // Never starts a ValueTree stream
+inline constexpr juce::uint8 kProtocolVersion = 3;
+
+enum class MessageType : juce::uint8 {
+  kFullState = 1,
+  kDelta = 2,
+  kResyncRequest = 3,
+};
+
+// Builds the messages for one outgoing tree. Deltas are computed against a
+// snapshot of the tree as it was last sent, so changes made between sends are
+// coalesced. Each delta is applied to the snapshot as it is written, so only
+// added children are copied.
+class Encoder {
+ public:
+  // Snapshot the tree and encode all of it.
+  juce::MemoryBlock encodeFullState(const juce::ValueTree& tree);
+
+  // Encode the changes since the last message. Returns false, leaving the
+  // block untouched, if nothing has changed.
+  bool encodeDelta(const juce::ValueTree& tree, juce::MemoryBlock& block);
+
+  // Re-encode the last sent snapshot without advancing the sequence, for
+  // receivers joining part way through.
+  juce::MemoryBlock encodeLastState() const;
+
+  bool hasSentState() const { return lastSent_.isValid(); }
+
+  void reset();
+
+ private:
+  juce::ValueTree lastSent_;
+  juce::uint32 sequence_ = 0;
+};
+
+// Applies messages from an Encoder to a local tree.
+class Decoder {
+ public:
+  enum class Result {
+    kApplied,          // The tree was updated
+    kResyncRequired,   // A message was missed, send a resync request
+    kResyncRequested,  // The peer asked for the full state
+    kInvalid,          // Not a message of this protocol version
+  };
+
+  // Apply a message to the tree. A full state is copied into the existing
+  // tree, so listeners registered on it see the changes.
+  Result apply(const juce::MemoryBlock& message, juce::ValueTree& tree);
+
+  bool isSynced() const { return synced_; }
+
+  void reset();
+
+ private:
+  juce::uint32 sequence_ = 0;
+  bool synced_ = false;
+};
+
+juce::MemoryBlock encodeResyncRequest();
+
+}  // namespace RepositorySync
@@ -0,0 +1,173 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SharedAudioBus.h"
+
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <cstring>
+#include <limits>
+
+int SharedAudioBusTable::claim(const uint32_t owner, const uint32_t nowMs) {
+  for (int i = 0; i < kNumSlots; ++i) {
+    SharedAudioBusSlot& slot = slots[i];
+    uint32_t expected = slot.owner.load(std::memory_order_acquire);
+    const uint32_t timestamp = slot.timestampMs.load(std::memory_order_relaxed);
+    if (expected != 0 && nowMs - timestamp <= kExpiryMs) {
+      continue;
+    }
+    if (slot.owner.compare_exchange_strong(expected, owner)) {
+      // Invalidate the ring so readers never match the previous owner's blocks
+      for (SharedAudioBlock& block : slot.blocks) {
+        block.samplePosition.store(-1, std::memory_order_relaxed);
+      }
+      slot.timestampMs.store(nowMs, std::memory_order_release);
+      return i;
+    }
+  }
+  return -1;
+}
+
+void SharedAudioBusTable::release(const int index, const uint32_t owner) {
+  uint32_t expected = owner;
+  slots[index].owner.compare_exchange_strong(expected, 0);
+}
+
+bool SharedAudioBusTable::keepAlive(const int index, const uint32_t owner,
+                                    const uint32_t nowMs) {
+  SharedAudioBusSlot& slot = slots[index];
+  if (slot.owner.load(std::memory_order_acquire) != owner) {
+    return false;
+  }
+  slot.timestampMs.store(nowMs, std::memory_order_relaxed);
+  return true;
+}
+
+bool SharedAudioBusTable::write(const int index,
+                                const juce::Uuid& audioElementId,
+                                const juce::AudioBuffer<float>& buffer,
+                                const int numChannels,
+                                const int64_t samplePosition) {
+  if (numChannels > SharedAudioBlock::kMaxChannels ||
+      numChannels > buffer.getNumChannels() ||
+      buffer.getNumSamples() > SharedAudioBlock::kMaxSamples) {
+    return false;
+  }
+
+  SharedAudioBusSlot& slot = slots[index];
+  const uint32_t next = slot.nextBlock.load(std::memory_order_relaxed);
+  SharedAudioBlock& block = slot.blocks[next % SharedAudioBusSlot::kNumBlocks];
+
+  const uint32_t sequence = block.sequence.load(std::memory_order_relaxed);
+  block.sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  block.samplePosition.store(samplePosition, std::memory_order_relaxed);
+  block.numChannels = (uint32_t)numChannels;
+  block.numSamples = (uint32_t)buffer.getNumSamples();
+  std::memcpy(block.audioElementId.data(), audioElementId.getRawData(), 16);
+  for (int ch = 0; ch < numChannels; ++ch) {
+    std::memcpy(block.samples[ch], buffer.getReadPointer(ch),
+                sizeof(float) * (size_t)buffer.getNumSamples());
+  }
+  block.sequence.store(sequence + 2, std::memory_order_release);
+  slot.nextBlock.store(next + 1, std::memory_order_relaxed);
+  return true;
+}
+
+bool SharedAudioBusTable::read(const juce::Uuid& audioElementId,
+                               const int64_t samplePosition,
+                               juce::AudioBuffer<float>& dest,
+                               const int destChannel,
+                               const int numChannels) const {
+  for (const SharedAudioBusSlot& slot : slots) {
+    if (slot.owner.load(std::memory_order_acquire) == 0) {
+      continue;
+    }
+    for (const SharedAudioBlock& block : slot.blocks) {
+      const uint32_t before = block.sequence.load(std::memory_order_acquire);
+      if ((before & 1) ||
+          block.samplePosition.load(std::memory_order_relaxed) !=
+              samplePosition ||
+          std::memcmp(block.audioElementId.data(),
+                      audioElementId.getRawData(), 16) != 0) {
+        continue;
+      }
+      if (block.numSamples != (uint32_t)dest.getNumSamples() ||
+          block.numChannels < (uint32_t)numChannels ||
+          destChannel + numChannels > dest.getNumChannels()) {
+        return false;
+      }
+      for (int ch = 0; ch < numChannels; ++ch) {
+        dest.copyFrom(destChannel + ch, 0, block.samples[ch],
+                      dest.getNumSamples());
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      return block.sequence.load(std::memory_order_relaxed) == before;
+    }
+  }
+  return false;
+}
+
+SharedAudioBus::SharedAudioBus() {
+  namespace bip = boost::interprocess;
+  try {
+    bip::shared_memory_object shm(bip::open_or_create, kName, bip::read_write);
+    bip::offset_t size = 0;
+    if (!shm.get_size(size) || size < (bip::offset_t)sizeof(*table_)) {
+      shm.truncate(sizeof(*table_));
+    }
+    region_ = bip::mapped_region(shm, bip::read_write, 0, sizeof(*table_));
+  } catch (const bip::interprocess_exception&) {
+    return;
+  }
+
+  SharedAudioBusTable* table =
+      static_cast<SharedAudioBusTable*>(region_.get_address());
+  uint32_t version = 0;
+  if (table->version.compare_exchange_strong(version,
+                                             SharedAudioBusTable::kVersion) ||
+      version == SharedAudioBusTable::kVersion) {
+    table_ = table;
+  }
+}
+
+SharedAudioBusWriter::SharedAudioBusWriter()
+    : owner_((uint32_t)juce::Random::getSystemRandom().nextInt(
+                 std::numeric_limits<int>::max()) +
+             1) {}
+
+SharedAudioBusWriter::~SharedAudioBusWriter() {
+  if (slot_ >= 0) {
+    bus_.getTable()->release(slot_, owner_);
+  }
+}
+
+bool SharedAudioBusWriter::write(const juce::Uuid& audioElementId,
+                                 const juce::AudioBuffer<float>& buffer,
+                                 const int numChannels,
+                                 const int64_t samplePosition) {
+  SharedAudioBusTable* table = bus_.getTable();
+  if (table == nullptr) {
+    return false;
+  }
+
+  const uint32_t nowMs = juce::Time::getMillisecondCounter();
+  if (slot_ < 0 || !table->keepAlive(slot_, owner_, nowMs)) {
+    slot_ = table->claim(owner_, nowMs);
+    if (slot_ < 0) {
+      return false;
+    }
+  }
+  return table->write(slot_, audioElementId, buffer, numChannels,
+                      samplePosition);
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+
+#include <array>
+#include <atomic>
+#include <boost/interprocess/mapped_region.hpp>
+#include <cstdint>
+
+// One block of audio written by an audio element plugin. The writer bumps the
+// sequence number to an odd value while it writes, so readers can detect a
+// block that was overwritten while being copied. The sample position is the
+// host timeline position of the first sample, which aligns the block with the
+// renderer's block.
+struct SharedAudioBlock {
+  inline static constexpr int kMaxChannels = 16;
+  inline static constexpr int kMaxSamples = 2048;
+
+  std::atomic<uint32_t> sequence;
+  std::atomic<int64_t> samplePosition;
+  uint32_t numChannels;
+  uint32_t numSamples;
+  std::array<char, 16> audioElementId;
+  float samples[kMaxChannels][kMaxSamples];
+};
+
+// A plugin's ring of recently written blocks. Hosts that process tracks ahead
+// of the renderer write several blocks before the renderer reads the first.
+struct SharedAudioBusSlot {
+  inline static constexpr int kNumBlocks = 4;
+
+  std::atomic<uint32_t> owner;
+  std::atomic<uint32_t> timestampMs;
+  std::atomic<uint32_t> nextBlock;
+  SharedAudioBlock blocks[kNumBlocks];
+};
+
+// Fixed size table of audio bus slots. As with AudioElementSlotTable an
+// all-zero table is a valid empty table.
+struct SharedAudioBusTable {
+  static_assert(
+      std::atomic<int64_t>::is_always_lock_free,
+      "Block atomics must be lock free to be shared across processes");
+
+  inline static constexpr uint32_t kVersion = 1;
+  inline static constexpr int kNumSlots = 32;
+  // Slots whose owner has not written or kept them alive for this long are
+  // reclaimed, so a crashed plugin does not hold its slot forever.
+  inline static constexpr uint32_t kExpiryMs = 5000;
+
+  std::atomic<uint32_t> version;
+  SharedAudioBusSlot slots[kNumSlots];
+
+  // Claim a free or expired slot for a nonzero owner token, returns -1 if the
+  // table is full.
+  int claim(uint32_t owner, uint32_t nowMs);
+  void release(int index, uint32_t owner);
+
+  // True while the slot still belongs to the owner. Refreshes its timestamp.
+  bool keepAlive(int index, uint32_t owner, uint32_t nowMs);
+
+  // Write the first numChannels channels of a buffer to the slot's next block.
+  // Returns false if the buffer does not fit in a block.
+  bool write(int index, const juce::Uuid& audioElementId,
+             const juce::AudioBuffer<float>& buffer, int numChannels,
+             int64_t samplePosition);
+
+  // Copy the block an audio element wrote for the given position into the
+  // destination buffer, starting at destChannel. Returns false if no complete
+  // block of that position and length is available, in which case the
+  // destination channels may have been partially overwritten.
+  bool read(const juce::Uuid& audioElementId, int64_t samplePosition,
+            juce::AudioBuffer<float>& dest, int destChannel,
+            int numChannels) const;
+};
+
+// Maps the audio bus shared by the plugins on this host. Null table if the
+// region cannot be opened or was created by an incompatible version, in which
+// case audio travels over the host bus only.
+class SharedAudioBus {
+ public:
+  SharedAudioBus();
+
+  SharedAudioBusTable* getTable() const { return table_; }
+
+ private:
+  inline static const char* kName = "EclipsaSharedAudioBus";
+
+  boost::interprocess::mapped_region region_;
+  SharedAudioBusTable* table_ = nullptr;
+};
+
+// Publishes one audio element plugin's audio on the shared bus.
+class SharedAudioBusWriter {
+ public:
+  SharedAudioBusWriter();
+  ~SharedAudioBusWriter();
+
+  bool isAvailable() const { return bus_.getTable() != nullptr; }
+
+  // Write a block, reclaiming a slot if this writer's slot was lost.
+  bool write(const juce::Uuid& audioElementId,
+             const juce::AudioBuffer<float>& buffer, int numChannels,
+             int64_t samplePosition);
+
+ private:
+  SharedAudioBus bus_;
+  const uint32_t owner_;
+  int slot_ = -1;
+
+  JUCE_DECLARE_NON_COPYABLE(SharedAudioBusWriter)
+};
@@ -0,0 +1,144 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SyncConnectionManager.h"
+
+#include <algorithm>
+#include <boost/interprocess/shared_memory_object.hpp>
+
+SyncServerPresence::SyncServerPresence() {
+  namespace bip = boost::interprocess;
+  try {
+    bip::shared_memory_object shm(bip::open_or_create, kName, bip::read_write);
+    bip::offset_t size = 0;
+    if (!shm.get_size(size) || size < (bip::offset_t)sizeof(Shared)) {
+      shm.truncate(sizeof(Shared));
+    }
+    region_ = bip::mapped_region(shm, bip::read_write, 0, sizeof(Shared));
+  } catch (const bip::interprocess_exception&) {
+    return;
+  }
+
+  Shared* shared = static_cast<Shared*>(region_.get_address());
+  uint32_t version = 0;
+  if (shared->version.compare_exchange_strong(version, kVersion) ||
+      version == kVersion) {
+    shared_ = shared;
+  }
+}
+
+uint32_t SyncServerPresence::getGeneration() const {
+  return shared_ ? shared_->generation.load(std::memory_order_acquire) : 0;
+}
+
+void SyncServerPresence::notifyChanged() {
+  if (shared_) {
+    shared_->generation.fetch_add(1, std::memory_order_release);
+  }
+}
+
+SyncConnectionManager::SyncConnectionManager()
+    : thread_([this] { run(); }) {}
+
+SyncConnectionManager::~SyncConnectionManager() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  condition_.notify_all();
+  thread_.join();
+}
+
+void SyncConnectionManager::add(Client* client) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it =
+        std::find_if(pending_.begin(), pending_.end(),
+                     [client](const Pending& p) { return p.client == client; });
+    if (it != pending_.end()) {
+      it->nextAttempt = std::chrono::steady_clock::now();
+    } else {
+      pending_.push_back(
+          {client, std::chrono::steady_clock::now(), kMinBackoffMs});
+    }
+  }
+  condition_.notify_all();
+}
+
+void SyncConnectionManager::remove(Client* client) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  pending_.erase(
+      std::remove_if(pending_.begin(), pending_.end(),
+                     [client](const Pending& p) { return p.client == client; }),
+      pending_.end());
+  attemptDone_.wait(lock, [this, client] { return attempting_ != client; });
+}
+
+void SyncConnectionManager::run() {
+  uint32_t generation = presence_.getGeneration();
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stop_) {
+    // A server came up or went away, so retry everyone now
+    const uint32_t currentGeneration = presence_.getGeneration();
+    const auto now = std::chrono::steady_clock::now();
+    if (currentGeneration != generation) {
+      generation = currentGeneration;
+      for (Pending& p : pending_) {
+        p.nextAttempt = now;
+        p.backoffMs = kMinBackoffMs;
+      }
+    }
+
+    // Connecting blocks for up to the timeout, so the mutex is released for
+    // it and the clients are looked at afresh after each attempt
+    const auto due =
+        std::find_if(pending_.begin(), pending_.end(),
+                     [now](const Pending& p) { return p.nextAttempt <= now; });
+    if (due != pending_.end()) {
+      Client* const client = due->client;
+      const auto scheduled = due->nextAttempt;
+      attempting_ = client;
+      lock.unlock();
+      const bool done = client->attemptConnection(kConnectTimeoutMs);
+      lock.lock();
+      attempting_ = nullptr;
+      attemptDone_.notify_all();
+
+      // The client may have been removed, or added again to retry now
+      const auto it = std::find_if(
+          pending_.begin(), pending_.end(),
+          [client](const Pending& p) { return p.client == client; });
+      if (it != pending_.end() && it->nextAttempt == scheduled) {
+        if (done) {
+          pending_.erase(it);
+        } else {
+          it->nextAttempt = std::chrono::steady_clock::now() +
+                            std::chrono::milliseconds(it->backoffMs);
+          it->backoffMs = std::min(it->backoffMs * 2, kMaxBackoffMs);
+        }
+      }
+      continue;
+    }
+
+    auto wakeAt = now + std::chrono::milliseconds(kPresencePollMs);
+    for (const Pending& p : pending_) {
+      wakeAt = std::min(wakeAt, p.nextAttempt);
+    }
+    if (pending_.empty()) {
+      condition_.wait(lock);
+    } else {
+      condition_.wait_until(lock, wakeAt);
+    }
+  }
+}
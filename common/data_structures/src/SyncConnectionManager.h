@@ -0,0 +1,102 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <atomic>
+#include <chrono>
+#include <boost/interprocess/mapped_region.hpp>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Lets the plugins on this host see when a renderer sync server starts or
+// stops listening, without polling its socket. Unavailable if the shared
+// memory region cannot be opened, in which case getGeneration() stays at 0.
+class SyncServerPresence {
+ public:
+  SyncServerPresence();
+
+  // Incremented each time a sync server starts or stops listening
+  uint32_t getGeneration() const;
+
+  void notifyChanged();
+
+ private:
+  struct Shared {
+    std::atomic<uint32_t> version;
+    std::atomic<uint32_t> generation;
+  };
+  inline static constexpr uint32_t kVersion = 1;
+  inline static const char* kName = "EclipsaSyncServerPresence";
+
+  boost::interprocess::mapped_region region_;
+  Shared* shared_ = nullptr;
+};
+
+// Connects the sync clients of all plugin instances in this process from a
+// single thread. Failed attempts back off exponentially, and all pending
+// clients retry immediately when a sync server comes up. Hold an instance
+// through juce::SharedResourcePointer.
+class SyncConnectionManager {
+ public:
+  class Client {
+   public:
+    virtual ~Client() = default;
+    // Try to connect within the timeout, returning true when done. Called on
+    // the manager's thread without its lock held, so other clients can be
+    // added and removed meanwhile. Must not call remove(), which waits for
+    // the attempt.
+    virtual bool attemptConnection(int timeoutMs) = 0;
+  };
+
+  inline static constexpr int kConnectTimeoutMs = 500;
+  inline static constexpr int kMinBackoffMs = 250;
+  inline static constexpr int kMaxBackoffMs = 10000;
+  inline static constexpr int kPresencePollMs = 100;
+
+  SyncConnectionManager();
+  ~SyncConnectionManager();
+
+  // Connect the client as soon as possible
+  void add(Client* client);
+
+  // Stop connecting the client, waiting for an attempt in progress
+  void remove(Client* client);
+
+ private:
+  struct Pending {
+    Client* client;
+    std::chrono::steady_clock::time_point nextAttempt;
+    int backoffMs;
+  };
+
+  void run();
+
+  SyncServerPresence presence_;
+  std::vector<Pending> pending_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  // The client being connected, with mutex_ released
+  Client* attempting_ = nullptr;
+  std::condition_variable attemptDone_;
+  bool stop_ = false;
+  std::thread thread_;
+};
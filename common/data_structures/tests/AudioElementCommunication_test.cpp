@@ -0,0 +1,124 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../src/AudioElementCommunication.h"
+
+#include <gtest/gtest.h>
+
+namespace {
+AudioElementUpdateData makeUpdate(const juce::Uuid& id, const float x) {
+  AudioElementUpdateData data;
+  memcpy(data.uuid.data(), id.getRawData(), data.uuid.size());
+  data.x = x;
+  strcpy(data.name, "Element");
+  return data;
+}
+}  // namespace
+
+TEST(test_audio_element_communication, slot_table_write_read) {
+  auto table = std::make_unique<AudioElementSlotTable>();
+  AudioElementUpdateData data;
+  EXPECT_FALSE(table->read(0, data));
+
+  const int slot = table->claim(1);
+  ASSERT_GE(slot, 0);
+  EXPECT_NE(table->claim(2), slot);
+
+  const juce::Uuid id;
+  table->write(slot, makeUpdate(id, 0.5f));
+  ASSERT_TRUE(table->read(slot, data));
+  EXPECT_EQ(juce::Uuid((const juce::uint8*)data.uuid.data()), id);
+  EXPECT_EQ(data.x, 0.5f);
+  EXPECT_STREQ(data.name, "Element");
+
+  // Only the owner can release the slot
+  table->release(slot, 2);
+  EXPECT_TRUE(table->read(slot, data));
+  table->release(slot, 1);
+  EXPECT_FALSE(table->read(slot, data));
+}
+
+TEST(test_audio_element_communication, publish_through_shared_memory) {
+  AudioElementSharedMemory sharedMemory;
+  if (sharedMemory.getTable() == nullptr) {
+    GTEST_SKIP() << "Shared memory is unavailable, ZMQ is used instead";
+  }
+
+  AudioElementSubscriber subscriber;
+  const juce::Uuid id;
+  {
+    AudioElementPublisher publisher;
+    publisher.publishData(makeUpdate(id, 0.25f));
+
+    int matches = 0;
+    subscriber.getData([&](AudioElementUpdateData data) {
+      if (juce::Uuid((const juce::uint8*)data.uuid.data()) == id) {
+        EXPECT_EQ(data.x, 0.25f);
+        ++matches;
+      }
+    });
+    EXPECT_EQ(matches, 1);
+  }
+
+  // The slot is released with the publisher
+  subscriber.getData([&](AudioElementUpdateData data) {
+    EXPECT_NE(juce::Uuid((const juce::uint8*)data.uuid.data()), id);
+  });
+}
+
+TEST(test_audio_element_communication, slot_table_expiry) {
+  auto table = std::make_unique<AudioElementSlotTable>();
+  const int slot = table->claim(1);
+  AudioElementUpdateData data;
+  // Claimed but never written
+  EXPECT_FALSE(table->read(slot, data));
+
+  table->write(slot, makeUpdate(juce::Uuid(), 0.5f));
+  const uint32_t written = table->slots[slot].timestampMs.load();
+  EXPECT_TRUE(table->read(slot, data, written));
+  const uint32_t expiry = written + AudioElementSlotTable::kExpiryMs;
+  EXPECT_FALSE(table->isStale(slot, expiry));
+  EXPECT_TRUE(table->isStale(slot, expiry + 1));
+  EXPECT_FALSE(table->read(slot, data, expiry + 1));
+}
+
+TEST(test_audio_element_communication, expired_slots_are_reclaimed) {
+  auto table = std::make_unique<AudioElementSlotTable>();
+  const uint32_t now = juce::Time::getMillisecondCounter();
+  for (int i = 0; i < AudioElementSlotTable::kNumSlots; ++i) {
+    ASSERT_EQ(table->claim(1, now), i);
+  }
+  // Live slots are not taken over
+  EXPECT_EQ(table->claim(2, now), -1);
+
+  // A crashed publisher's slot is reclaimed once it expires
+  const uint32_t expired = now + AudioElementSlotTable::kExpiryMs + 1;
+  table->write(0, makeUpdate(juce::Uuid(), 0.5f));
+  const int slot = table->claim(2, expired);
+  ASSERT_GE(slot, 0);
+  EXPECT_TRUE(table->owns(slot, 2));
+  EXPECT_FALSE(table->owns(slot, 1));
+
+  // The previous owner's data stays hidden until the new owner writes
+  AudioElementUpdateData data;
+  EXPECT_FALSE(table->read(slot, data, expired));
+  const juce::Uuid id;
+  table->write(slot, makeUpdate(id, 0.75f));
+  ASSERT_TRUE(table->read(slot, data));
+  EXPECT_EQ(juce::Uuid((const juce::uint8*)data.uuid.data()), id);
+
+  // The previous owner can no longer release it
+  table->release(slot, 1);
+  EXPECT_TRUE(table->read(slot, data));
+}
@@ -0,0 +1,101 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../src/CompactStateCache.h"
+
+#include <gtest/gtest.h>
+#include <juce_data_structures/juce_data_structures.h>
+
+#include "../src/AudioElement.h"
+#include "substream_rdr/substream_rdr_utils/Speakers.h"
+
+namespace {
+juce::ValueTree makeState(const int numElements) {
+  juce::ValueTree state{"renderer_state"};
+  juce::ValueTree elements{"audio_elements"};
+  for (int i = 0; i < numElements; ++i) {
+    const AudioElement element(juce::Uuid(), "Element " + juce::String(i),
+                               Speakers::kStereo, 2 * i);
+    elements.addChild(element.toValueTree(), -1, nullptr);
+  }
+  state.addChild(elements, -1, nullptr);
+  return state;
+}
+
+juce::ValueTree decode(const juce::MemoryBlock& block) {
+  return CompactTreeCodec::decode(block.getData(), block.getSize());
+}
+}  // namespace
+
+TEST(test_compact_state_cache, encodes_only_after_changes) {
+  juce::ValueTree state = makeState(100);
+  CompactStateCache cache(state, CompactTreeCodec::Compression::kZlib);
+  ASSERT_TRUE(cache.isStale());
+
+  const juce::MemoryBlock first = cache.getEncoded();
+  EXPECT_TRUE(decode(first).isEquivalentTo(state));
+  EXPECT_FALSE(cache.isStale());
+
+  // Setting a property to the value it has is not a change
+  state.setProperty("version", "1.0.0", nullptr);
+  ASSERT_TRUE(cache.isStale());
+  cache.getEncoded();
+  state.setProperty("version", "1.0.0", nullptr);
+  EXPECT_FALSE(cache.isStale());
+
+  // Changes deep in the tree are seen
+  state.getChild(0).getChild(42).setProperty(AudioElement::kName, "Renamed",
+                                              nullptr);
+  ASSERT_TRUE(cache.isStale());
+  const juce::MemoryBlock renamed = cache.getEncoded();
+  EXPECT_NE(renamed, first);
+  EXPECT_TRUE(decode(renamed).isEquivalentTo(state));
+
+  state.getChild(0).removeChild(0, nullptr);
+  ASSERT_TRUE(cache.isStale());
+  EXPECT_TRUE(decode(cache.getEncoded()).isEquivalentTo(state));
+}
+
+TEST(test_compact_state_cache, follows_restored_tree) {
+  juce::ValueTree state = makeState(2);
+  CompactStateCache cache(state);
+  cache.getEncoded();
+
+  const juce::ValueTree restored = makeState(3);
+  state = restored;
+  cache.setStateTree(state);
+  ASSERT_TRUE(cache.isStale());
+  EXPECT_TRUE(decode(cache.getEncoded()).isEquivalentTo(restored));
+
+  // And listens to the restored tree from then on
+  state.getChild(0).removeChild(0, nullptr);
+  EXPECT_TRUE(cache.isStale());
+}
+
+// Autosave of an unchanged 100 element session, recorded in the test output
+TEST(test_compact_state_cache, unchanged_autosave_benchmark) {
+  const juce::ValueTree state = makeState(100);
+  CompactStateCache cache(state, CompactTreeCodec::Compression::kZlib);
+
+  const auto timeUs = [&cache] {
+    const juce::int64 start = juce::Time::getHighResolutionTicks();
+    cache.getEncoded();
+    return (int)(juce::Time::highResolutionTicksToSeconds(
+                     juce::Time::getHighResolutionTicks() - start) *
+                 1e6);
+  };
+  RecordProperty("first_save_us", timeUs());
+  RecordProperty("unchanged_save_us", timeUs());
+  EXPECT_FALSE(cache.isStale());
+}
@@ -0,0 +1,192 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../src/CompactTreeCodec.h"
+
+#include <gtest/gtest.h>
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_data_structures/juce_data_structures.h>
+
+#include "../src/AudioElement.h"
+#include "../src/MixPresentation.h"
+#include "../src/RoomSetup.h"
+#include "substream_rdr/substream_rdr_utils/Speakers.h"
+
+namespace {
+// A renderer-like state with dozens of elements and mix presentations
+juce::ValueTree makeSessionState(const int numElements = 32) {
+  juce::ValueTree state{"renderer_state"};
+  state.setProperty("version", "1.1.1", nullptr);
+
+  juce::ValueTree elements{"audio_elements"};
+  juce::Array<juce::Uuid> ids;
+  for (int i = 0; i < numElements; ++i) {
+    const AudioElement element(juce::Uuid(), "Element " + juce::String(i),
+                               Speakers::kStereo, 2 * i);
+    ids.add(element.getId());
+    elements.addChild(element.toValueTree(), -1, nullptr);
+  }
+  state.addChild(elements, -1, nullptr);
+
+  juce::ValueTree mixes{"mix_presentations"};
+  for (int i = 0; i < 8; ++i) {
+    MixPresentation mix(juce::Uuid(), "Mix " + juce::String(i), 1.f);
+    for (const juce::Uuid& id : ids) {
+      mix.addAudioElement(id, 0.5f, "Element");
+    }
+    mixes.addChild(mix.toValueTree(), -1, nullptr);
+  }
+  state.addChild(mixes, -1, nullptr);
+  state.addChild(RoomSetup().toValueTree(), -1, nullptr);
+  return state;
+}
+
+juce::ValueTree roundTrip(const juce::ValueTree& tree,
+                          const CompactTreeCodec::Compression compression =
+                              CompactTreeCodec::Compression::kNone) {
+  const juce::MemoryBlock block = CompactTreeCodec::encode(tree, compression);
+  return CompactTreeCodec::decode(block.getData(), block.getSize());
+}
+
+// Mean milliseconds per call over a number of runs
+template <typename Function>
+double timeMs(Function&& function, const int runs = 20) {
+  const juce::int64 start = juce::Time::getHighResolutionTicks();
+  for (int i = 0; i < runs; ++i) {
+    function();
+  }
+  return juce::Time::highResolutionTicksToSeconds(
+             juce::Time::getHighResolutionTicks() - start) *
+         1000.0 / runs;
+}
+}  // namespace
+
+TEST(test_compact_tree_codec, session_round_trip) {
+  const juce::ValueTree state = makeSessionState();
+  const juce::ValueTree decoded = roundTrip(state);
+  ASSERT_TRUE(decoded.isValid());
+  EXPECT_TRUE(decoded.isEquivalentTo(state));
+
+  // Smaller than both the XML state and ValueTree's own stream format
+  juce::MemoryBlock xml;
+  juce::AudioProcessor::copyXmlToBinary(*state.createXml(), xml);
+  juce::MemoryOutputStream stream;
+  state.writeToStream(stream);
+  const size_t compactSize = CompactTreeCodec::encode(state).getSize();
+  EXPECT_LT(compactSize, xml.getSize());
+  EXPECT_LT(compactSize, stream.getDataSize());
+}
+
+TEST(test_compact_tree_codec, compressed_round_trip) {
+  const juce::ValueTree state = makeSessionState();
+  const juce::ValueTree decoded =
+      roundTrip(state, CompactTreeCodec::Compression::kZlib);
+  ASSERT_TRUE(decoded.isValid());
+  EXPECT_TRUE(decoded.isEquivalentTo(state));
+  EXPECT_LT(
+      CompactTreeCodec::encode(state, CompactTreeCodec::Compression::kZlib)
+          .getSize(),
+      CompactTreeCodec::encode(state).getSize());
+
+  // Truncated compressed data
+  const juce::MemoryBlock block =
+      CompactTreeCodec::encode(state, CompactTreeCodec::Compression::kZlib);
+  for (size_t size : {(size_t)4, (size_t)8, block.getSize() / 2}) {
+    EXPECT_FALSE(CompactTreeCodec::decode(block.getData(), size).isValid());
+  }
+}
+
+// Save and load times for a 100 element session, recorded in the test output
+TEST(test_compact_tree_codec, session_save_load_benchmark) {
+  const juce::ValueTree state = makeSessionState(100);
+
+  juce::MemoryBlock xml;
+  const double xmlSaveMs = timeMs([&] {
+    xml.reset();
+    juce::AudioProcessor::copyXmlToBinary(*state.createXml(), xml);
+  });
+  const double xmlLoadMs = timeMs([&] {
+    std::unique_ptr<juce::XmlElement> element(
+        juce::AudioProcessor::getXmlFromBinary(xml.getData(),
+                                               (int)xml.getSize()));
+    juce::ValueTree::fromXml(*element);
+  });
+  RecordProperty("xml_bytes", (int)xml.getSize());
+  RecordProperty("xml_save_us", (int)(xmlSaveMs * 1000));
+  RecordProperty("xml_load_us", (int)(xmlLoadMs * 1000));
+
+  for (const auto& [compression, name] :
+       {std::pair{CompactTreeCodec::Compression::kNone, "compact"},
+        std::pair{CompactTreeCodec::Compression::kZlib, "compressed"}}) {
+    juce::MemoryBlock block;
+    const double saveMs = timeMs(
+        [&] { block = CompactTreeCodec::encode(state, compression); });
+    const double loadMs = timeMs([&] {
+      EXPECT_TRUE(CompactTreeCodec::decode(block.getData(), block.getSize())
+                      .isValid());
+    });
+    RecordProperty(std::string(name) + "_bytes", (int)block.getSize());
+    RecordProperty(std::string(name) + "_save_us", (int)(saveMs * 1000));
+    RecordProperty(std::string(name) + "_load_us", (int)(loadMs * 1000));
+  }
+}
+
+TEST(test_compact_tree_codec, value_round_trip) {
+  const juce::Uuid id;
+  juce::MemoryBlock binary;
+  binary.append("\x01\x02\x03", 3);
+
+  juce::ValueTree tree{"values"};
+  tree.setProperty("uuid", id.toString(), nullptr);
+  tree.setProperty("dashed", id.toDashedString(), nullptr);
+  tree.setProperty("upper", id.toString().toUpperCase(), nullptr);
+  tree.setProperty("text", juce::String::fromUTF8("h\xc3\xa9llo"), nullptr);
+  tree.setProperty("empty", "", nullptr);
+  tree.setProperty("int", -123456, nullptr);
+  tree.setProperty("int64", (juce::int64)1 << 40, nullptr);
+  tree.setProperty("double", 0.125, nullptr);
+  tree.setProperty("true", true, nullptr);
+  tree.setProperty("false", false, nullptr);
+  tree.setProperty("array", juce::Array<juce::var>{1, "two", 3.0}, nullptr);
+  tree.setProperty("binary", binary, nullptr);
+
+  const juce::ValueTree decoded = roundTrip(tree);
+  ASSERT_TRUE(decoded.isValid());
+  EXPECT_TRUE(decoded.isEquivalentTo(tree));
+  for (int i = 0; i < tree.getNumProperties(); ++i) {
+    const juce::Identifier name = tree.getPropertyName(i);
+    EXPECT_TRUE(decoded[name].equalsWithSameType(tree[name]))
+        << name.toString();
+  }
+}
+
+TEST(test_compact_tree_codec, rejects_other_data) {
+  // XML state from older sessions
+  juce::MemoryBlock xml;
+  juce::AudioProcessor::copyXmlToBinary(*makeSessionState().createXml(), xml);
+  EXPECT_FALSE(
+      CompactTreeCodec::decode(xml.getData(), xml.getSize()).isValid());
+
+  // Truncated data
+  const juce::MemoryBlock block = CompactTreeCodec::encode(makeSessionState());
+  for (size_t size : {(size_t)0, (size_t)3, block.getSize() / 2}) {
+    EXPECT_FALSE(CompactTreeCodec::decode(block.getData(), size).isValid());
+  }
+
+  // A newer schema, the version follows the magic and its compressed length
+  juce::MemoryBlock newer = block;
+  newer[5] = (char)(CompactTreeCodec::kSchemaVersion + 1);
+  EXPECT_FALSE(
+      CompactTreeCodec::decode(newer.getData(), newer.getSize()).isValid());
+}
@@ -0,0 +1,34 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../src/ExportJob.h"
+
+#include <gtest/gtest.h>
+#include <juce_data_structures/juce_data_structures.h>
+
+#include "substream_rdr/substream_rdr_utils/Speakers.h"
+
+TEST(test_export_job, to_from_value_tree) {
+  const ExportJob job(juce::Uuid(), Speakers::kBinaural, "/test/binaural.wav",
+                      16, false);
+  const juce::ValueTree tree = job.toValueTree();
+  ASSERT_EQ(tree.getType(), ExportJob::kTreeType);
+
+  const ExportJob restored = ExportJob::fromTree(tree);
+  ASSERT_EQ(job, restored);
+  ASSERT_EQ(restored.getLayout(), Speakers::kBinaural);
+  ASSERT_EQ(restored.getExportFile(), "/test/binaural.wav");
+  ASSERT_EQ(restored.getBitDepth(), 16);
+  ASSERT_FALSE(restored.isEnabled());
+}
@@ -0,0 +1,155 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../src/RepositorySync.h"
+
+#include <gtest/gtest.h>
+#include <juce_data_structures/juce_data_structures.h>
+
+#include "../src/AudioElement.h"
+#include "substream_rdr/substream_rdr_utils/Speakers.h"
+
+using Result = RepositorySync::Decoder::Result;
+
+namespace {
+juce::ValueTree makeRepository(const int numElements) {
+  juce::ValueTree repository{"repository"};
+  for (int i = 0; i < numElements; ++i) {
+    const AudioElement element(juce::Uuid(), "Element " + juce::String(i),
+                               Speakers::kStereo, 2 * i);
+    repository.addChild(element.toValueTree(), -1, nullptr);
+  }
+  return repository;
+}
+}  // namespace
+
+TEST(test_repository_sync, full_state_then_deltas) {
+  juce::ValueTree source = makeRepository(50);
+  RepositorySync::Encoder encoder;
+  RepositorySync::Decoder decoder;
+
+  juce::ValueTree replica;
+  const juce::MemoryBlock fullState = encoder.encodeFullState(source);
+  ASSERT_EQ(decoder.apply(fullState, replica), Result::kApplied);
+  EXPECT_TRUE(replica.isEquivalentTo(source));
+
+  // Nothing changed, nothing to send
+  juce::MemoryBlock delta;
+  EXPECT_FALSE(encoder.encodeDelta(source, delta));
+
+  // Renaming one element only sends that property
+  source.getChild(25).setProperty(AudioElement::kName, "Renamed", nullptr);
+  ASSERT_TRUE(encoder.encodeDelta(source, delta));
+  EXPECT_LT(delta.getSize() * 20, fullState.getSize());
+  ASSERT_EQ(decoder.apply(delta, replica), Result::kApplied);
+  EXPECT_TRUE(replica.isEquivalentTo(source));
+
+  // Children added and removed
+  source.removeChild(10, nullptr);
+  source.removeChild(source.getNumChildren() - 1, nullptr);
+  source.addChild(makeRepository(1).getChild(0).createCopy(), 3, nullptr);
+  source.getChild(0).removeProperty(AudioElement::kName, nullptr);
+  ASSERT_TRUE(encoder.encodeDelta(source, delta));
+  ASSERT_EQ(decoder.apply(delta, replica), Result::kApplied);
+  EXPECT_TRUE(replica.isEquivalentTo(source));
+}
+
+TEST(test_repository_sync, children_matched_by_id) {
+  juce::ValueTree source = makeRepository(50);
+  RepositorySync::Encoder encoder;
+  RepositorySync::Decoder decoder;
+  juce::ValueTree replica;
+  const juce::MemoryBlock fullState = encoder.encodeFullState(source);
+  ASSERT_EQ(decoder.apply(fullState, replica), Result::kApplied);
+  const juce::ValueTree moved = replica.getChild(40);
+
+  // Removing an element near the front and moving another only sends the
+  // removal and the move, not every element after them
+  juce::MemoryBlock delta;
+  source.removeChild(1, nullptr);
+  source.moveChild(39, 0, nullptr);
+  ASSERT_TRUE(encoder.encodeDelta(source, delta));
+  EXPECT_LT(delta.getSize() * 20, fullState.getSize());
+  ASSERT_EQ(decoder.apply(delta, replica), Result::kApplied);
+  EXPECT_TRUE(replica.isEquivalentTo(source));
+  EXPECT_TRUE(replica.getChild(0) == moved);
+
+  // The encoder's snapshot follows the deltas, independently of the tree
+  source.getChild(0).setProperty(AudioElement::kName, "Moved", nullptr);
+  source.addChild(makeRepository(1).getChild(0), 0, nullptr);
+  ASSERT_TRUE(encoder.encodeDelta(source, delta));
+  ASSERT_EQ(decoder.apply(delta, replica), Result::kApplied);
+  EXPECT_TRUE(replica.isEquivalentTo(source));
+  source.getChild(0).setProperty(AudioElement::kName, "Added", nullptr);
+  ASSERT_TRUE(encoder.encodeDelta(source, delta));
+  ASSERT_EQ(decoder.apply(delta, replica), Result::kApplied);
+  EXPECT_TRUE(replica.isEquivalentTo(source));
+  EXPECT_FALSE(encoder.encodeDelta(source, delta));
+}
+
+TEST(test_repository_sync, full_state_notifies_existing_tree) {
+  RepositorySync::Encoder encoder;
+  RepositorySync::Decoder decoder;
+  juce::ValueTree replica = makeRepository(1);
+  const juce::ValueTree original = replica;
+
+  const juce::ValueTree source = makeRepository(3);
+  ASSERT_EQ(decoder.apply(encoder.encodeFullState(source), replica),
+            Result::kApplied);
+  EXPECT_TRUE(replica == original);
+  EXPECT_TRUE(replica.isEquivalentTo(source));
+}
+
+TEST(test_repository_sync, gap_requires_resync) {
+  juce::ValueTree source = makeRepository(2);
+  RepositorySync::Encoder encoder;
+  RepositorySync::Decoder decoder;
+  juce::ValueTree replica;
+
+  // A delta before any full state cannot be applied
+  juce::MemoryBlock delta;
+  encoder.encodeFullState(source);
+  source.setProperty("a", 1, nullptr);
+  ASSERT_TRUE(encoder.encodeDelta(source, delta));
+  EXPECT_EQ(decoder.apply(delta, replica), Result::kResyncRequired);
+  EXPECT_FALSE(decoder.isSynced());
+
+  ASSERT_EQ(decoder.apply(encoder.encodeLastState(), replica),
+            Result::kApplied);
+
+  // Skipping a delta is detected
+  source.setProperty("a", 2, nullptr);
+  ASSERT_TRUE(encoder.encodeDelta(source, delta));
+  source.setProperty("a", 3, nullptr);
+  ASSERT_TRUE(encoder.encodeDelta(source, delta));
+  EXPECT_EQ(decoder.apply(delta, replica), Result::kResyncRequired);
+
+  ASSERT_EQ(decoder.apply(encoder.encodeLastState(), replica),
+            Result::kApplied);
+  EXPECT_TRUE(replica.isEquivalentTo(source));
+}
+
+TEST(test_repository_sync, resync_request_and_invalid_messages) {
+  RepositorySync::Decoder decoder;
+  juce::ValueTree replica;
+  EXPECT_EQ(decoder.apply(RepositorySync::encodeResyncRequest(), replica),
+            Result::kResyncRequested);
+
+  // A bare ValueTree is not a protocol message
+  juce::MemoryBlock block;
+  juce::MemoryOutputStream stream(block, false);
+  makeRepository(1).writeToStream(stream);
+  stream.flush();
+  EXPECT_EQ(decoder.apply(block, replica), Result::kInvalid);
+}
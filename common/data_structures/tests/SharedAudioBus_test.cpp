@@ -0,0 +1,115 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../src/SharedAudioBus.h"
+
+#include <gtest/gtest.h>
+
+namespace {
+constexpr int kSamples = 128;
+
+juce::AudioBuffer<float> makeBlock(const int numChannels, const float value) {
+  juce::AudioBuffer<float> buffer(numChannels, kSamples);
+  for (int ch = 0; ch < numChannels; ++ch) {
+    juce::FloatVectorOperations::fill(buffer.getWritePointer(ch),
+                                      value + (float)ch, kSamples);
+  }
+  return buffer;
+}
+}  // namespace
+
+TEST(test_shared_audio_bus, aligned_read) {
+  auto table = std::make_unique<SharedAudioBusTable>();
+  const int slot = table->claim(1, 1000);
+  ASSERT_GE(slot, 0);
+  const juce::Uuid id;
+  ASSERT_TRUE(table->write(slot, id, makeBlock(4, 1.f), 4, 4800));
+
+  // Placed at the destination channel
+  juce::AudioBuffer<float> dest(8, kSamples);
+  dest.clear();
+  EXPECT_TRUE(table->read(id, 4800, dest, 2, 4));
+  EXPECT_EQ(dest.getSample(1, 0), 0.f);
+  EXPECT_EQ(dest.getSample(2, 0), 1.f);
+  EXPECT_EQ(dest.getSample(5, kSamples - 1), 4.f);
+
+  // Other positions, elements and block sizes are not matched
+  EXPECT_FALSE(table->read(id, 4800 + kSamples, dest, 0, 4));
+  EXPECT_FALSE(table->read(juce::Uuid(), 4800, dest, 0, 4));
+  juce::AudioBuffer<float> shorter(4, kSamples / 2);
+  EXPECT_FALSE(table->read(id, 4800, shorter, 0, 4));
+  EXPECT_FALSE(table->read(id, 4800, dest, 0, 5));
+}
+
+TEST(test_shared_audio_bus, ring_keeps_recent_blocks) {
+  auto table = std::make_unique<SharedAudioBusTable>();
+  const int slot = table->claim(1, 1000);
+  const juce::Uuid id;
+  const int numBlocks = SharedAudioBusSlot::kNumBlocks + 1;
+  for (int i = 0; i < numBlocks; ++i) {
+    ASSERT_TRUE(
+        table->write(slot, id, makeBlock(1, (float)i), 1, i * kSamples));
+  }
+
+  // The oldest block has been overwritten, the rest can still be read
+  juce::AudioBuffer<float> dest(1, kSamples);
+  EXPECT_FALSE(table->read(id, 0, dest, 0, 1));
+  for (int i = 1; i < numBlocks; ++i) {
+    ASSERT_TRUE(table->read(id, i * kSamples, dest, 0, 1));
+    EXPECT_EQ(dest.getSample(0, 0), (float)i);
+  }
+}
+
+TEST(test_shared_audio_bus, oversized_block) {
+  auto table = std::make_unique<SharedAudioBusTable>();
+  const int slot = table->claim(1, 1000);
+  juce::AudioBuffer<float> wide(SharedAudioBlock::kMaxChannels + 1, kSamples);
+  EXPECT_FALSE(table->write(slot, juce::Uuid(), wide,
+                            SharedAudioBlock::kMaxChannels + 1, 0));
+  juce::AudioBuffer<float> longBlock(1, SharedAudioBlock::kMaxSamples + 1);
+  EXPECT_FALSE(table->write(slot, juce::Uuid(), longBlock, 1, 0));
+}
+
+TEST(test_shared_audio_bus, expired_slots_are_reclaimed) {
+  auto table = std::make_unique<SharedAudioBusTable>();
+  const juce::Uuid id;
+  const int slot = table->claim(1, 1000);
+  ASSERT_TRUE(table->write(slot, id, makeBlock(1, 1.f), 1, 0));
+
+  // A live slot is not handed out again
+  EXPECT_NE(table->claim(2, 1000), slot);
+  table->release(1, 2);
+
+  // Once expired it is, and the previous owner's blocks are invalidated
+  const uint32_t expired = 1000 + SharedAudioBusTable::kExpiryMs + 1;
+  EXPECT_EQ(table->claim(3, expired), slot);
+  EXPECT_FALSE(table->keepAlive(slot, 1, expired));
+  EXPECT_TRUE(table->keepAlive(slot, 3, expired));
+  juce::AudioBuffer<float> dest(1, kSamples);
+  EXPECT_FALSE(table->read(id, 0, dest, 0, 1));
+}
+
+TEST(test_shared_audio_bus, writer) {
+  SharedAudioBusWriter writer;
+  SharedAudioBus bus;
+  if (!writer.isAvailable() || bus.getTable() == nullptr) {
+    GTEST_SKIP() << "Shared memory is unavailable";
+  }
+
+  const juce::Uuid id;
+  ASSERT_TRUE(writer.write(id, makeBlock(2, 3.f), 2, 9600));
+  juce::AudioBuffer<float> dest(2, kSamples);
+  ASSERT_TRUE(bus.getTable()->read(id, 9600, dest, 0, 2));
+  EXPECT_EQ(dest.getSample(1, 0), 4.f);
+}
@@ -0,0 +1,127 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../src/SyncConnectionManager.h"
+
+#include <gtest/gtest.h>
+
+namespace {
+// Fails a given number of attempts before connecting, each taking the given
+// time
+class TestClient : public SyncConnectionManager::Client {
+ public:
+  explicit TestClient(const int failures, const int attemptMs = 0)
+      : failures_(failures), attemptMs_(attemptMs) {}
+
+  bool attemptConnection(int timeoutMs) override {
+    EXPECT_EQ(timeoutMs, SyncConnectionManager::kConnectTimeoutMs);
+    bool connected;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++attempts_;
+      connected = attempts_ > failures_;
+      condition_.notify_all();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(attemptMs_));
+    attemptFinished_ = true;
+    return connected;
+  }
+
+  bool waitForAttempts(const int attempts, const int timeoutMs) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return condition_.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+                               [&] { return attempts_ >= attempts; });
+  }
+
+  int getAttempts() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return attempts_;
+  }
+
+  std::atomic_bool attemptFinished_{false};
+
+ private:
+  const int failures_;
+  const int attemptMs_;
+  int attempts_ = 0;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+};
+}  // namespace
+
+TEST(test_sync_connection_manager, connects_with_backoff) {
+  SyncConnectionManager manager;
+  TestClient client(2);
+  manager.add(&client);
+
+  // 0 ms, then 250 ms and 500 ms backoff
+  EXPECT_TRUE(client.waitForAttempts(1, 100));
+  EXPECT_TRUE(client.waitForAttempts(3, 2000));
+
+  // Connected, so no further attempts
+  std::this_thread::sleep_for(std::chrono::milliseconds(600));
+  EXPECT_EQ(client.getAttempts(), 3);
+}
+
+TEST(test_sync_connection_manager, remove_stops_attempts) {
+  SyncConnectionManager manager;
+  TestClient client(1000);
+  manager.add(&client);
+  ASSERT_TRUE(client.waitForAttempts(1, 100));
+  manager.remove(&client);
+
+  const int attempts = client.getAttempts();
+  std::this_thread::sleep_for(std::chrono::milliseconds(600));
+  EXPECT_EQ(client.getAttempts(), attempts);
+}
+
+TEST(test_sync_connection_manager, attempts_do_not_block_others) {
+  SyncConnectionManager manager;
+  TestClient slow(1000, 400);
+  manager.add(&slow);
+  ASSERT_TRUE(slow.waitForAttempts(1, 100));
+
+  // Other clients come and go while the slow attempt is in progress
+  TestClient other(1000);
+  const auto start = std::chrono::steady_clock::now();
+  manager.add(&other);
+  manager.remove(&other);
+  EXPECT_LT(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(200));
+  EXPECT_FALSE(slow.attemptFinished_);
+
+  // Removing the client being connected waits for its attempt
+  manager.remove(&slow);
+  EXPECT_TRUE(slow.attemptFinished_);
+}
+
+TEST(test_sync_connection_manager, server_presence_wakes_clients) {
+  SyncServerPresence server;
+  const uint32_t generation = server.getGeneration();
+  server.notifyChanged();
+  if (server.getGeneration() == generation) {
+    GTEST_SKIP() << "Shared memory is unavailable";
+  }
+
+  SyncConnectionManager manager;
+  TestClient client(5);
+  manager.add(&client);
+  // Back off well past the first retries
+  ASSERT_TRUE(client.waitForAttempts(4, 3000));
+
+  // The next attempt would be over a second away
+  const int attempts = client.getAttempts();
+  server.notifyChanged();
+  EXPECT_TRUE(client.waitForAttempts(attempts + 1, 500));
+}
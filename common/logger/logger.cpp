@@ -16,15 +16,111 @@
 
 #include <juce_core/juce_core.h>
 
+#include <boost/date_time/c_local_time_adjustor.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/log/core.hpp>
+#include <boost/log/detail/thread_id.hpp>
 #include <boost/log/expressions.hpp>
 #include <boost/log/sinks.hpp>
 #include <boost/log/utility/setup/common_attributes.hpp>
 #include <boost/log/utility/setup/file.hpp>
+#include <chrono>
 #include <iostream>
 #include <regex>
 
+namespace {
+// How long queued records may wait before the writer thread writes them.
+constexpr std::chrono::milliseconds kDrainInterval{50};
+
+boost::log::attributes::current_thread_id::value_type currentThreadId() {
+  return boost::log::aux::this_thread::get_id();
+}
+
+boost::posix_time::ptime toLocalTime(std::chrono::system_clock::time_point t) {
+  const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(
+                          t.time_since_epoch())
+                          .count();
+  const boost::posix_time::ptime utc =
+      boost::posix_time::from_time_t(0) +
+      boost::posix_time::microseconds(micros);
+  return boost::date_time::c_local_adjustor<
+      boost::posix_time::ptime>::utc_to_local(utc);
+}
+
+std::string_view fileName(const char* path) {
+  const std::string_view fullPath(path);
+  const std::size_t separator = fullPath.find_last_of("/\\");
+  return separator == std::string_view::npos ? fullPath
+                                             : fullPath.substr(separator + 1);
+}
+
+// Returns a thread's queue to the pool when the thread exits. Records it left
+// behind are still written by the next drain.
+struct QueueClaim {
+  ~QueueClaim() {
+    if (claimed != nullptr) {
+      claimed->store(false, std::memory_order_release);
+    }
+  }
+
+  std::atomic<bool>* claimed = nullptr;
+};
+}  // namespace
+
+struct Logger::Record {
+  std::uint64_t sequence = 0;
+  std::chrono::system_clock::time_point time;
+  boost::log::attributes::current_thread_id::value_type threadId;
+  boost::log::trivial::severity_level level = boost::log::trivial::info;
+  int instanceId = 0;
+  const char* file = "";
+  const char* function = "";
+  const char* tag = nullptr;
+  int line = 0;
+  std::string message;
+};
+
+// Single-producer ring owned by one logging thread at a time. head is only
+// advanced by the owner and tail only by the drain.
+struct Logger::ThreadQueue {
+  ThreadQueue() {
+    for (Record& record : records) {
+      record.message.reserve(kInlineMessageLength);
+    }
+  }
+
+  std::atomic<bool> claimed{false};
+  std::atomic<std::size_t> head{0};
+  std::atomic<std::size_t> tail{0};
+  Record records[kQueueCapacity];
+};
+
+Logger::Logger()
+    : timeStamp_(boost::posix_time::ptime()),
+      threadId_(currentThreadId()),
+      queues_(std::make_unique<ThreadQueue[]>(kMaxThreads)),
+      drainEnds_(kMaxThreads, 0) {
+  lg.add_attribute("TimeStamp", timeStamp_);
+  lg.add_attribute("ThreadID", threadId_);
+  formatted_.reserve(2 * kInlineMessageLength);
+  writer_ = std::thread([this] { runWriter(); });
+}
+
+Logger::~Logger() {
+  {
+    std::lock_guard<std::mutex> lock(writerMutex_);
+    stopping_ = true;
+  }
+  writerWake_.notify_one();
+  if (writer_.joinable()) {
+    writer_.join();
+  }
+
+  std::lock_guard<std::mutex> lock(drainMutex_);
+  drain();
+}
+
 void Logger::init(const std::string& pluginName, size_t maxFileSizeMB,
                   boost::log::trivial::severity_level minSeverity) {
   std::lock_guard<std::mutex> lock(
@@ -65,7 +161,8 @@ void Logger::init(const std::string& pluginName, size_t maxFileSizeMB,
             boost::log::sinks::file::rotation_at_time_point(0, 0, 0),
         boost::log::keywords::format =
             "[%TimeStamp%] [%Severity%] [%ThreadID%]: %Message%",
-        boost::log::keywords::auto_flush = true);
+        // The drain flushes once per batch of records.
+        boost::log::keywords::auto_flush = false);
 
     // Add a custom file collector with a retention policy
     fileSink->locked_backend()->set_file_collector(
@@ -93,6 +190,7 @@ void Logger::init(const std::string& pluginName, size_t maxFileSizeMB,
     // Set the severity filter using the provided parameter
     boost::log::core::get()->set_filter(boost::log::trivial::severity >=
                                         minSeverity);
+    minSeverity_.store(minSeverity, std::memory_order_relaxed);
   } catch (const std::exception& e) {
     std::cerr << "Error initializing logger: " << e.what() << std::endl;
   }
@@ -126,6 +224,142 @@ std::vector<std::string> Logger::getLogFilePaths() const {
 }
 
 void Logger::flush() {
-  // Implementation to flush the logs
-  boost::log::core::get()->flush();
+  std::lock_guard<std::mutex> lock(drainMutex_);
+  drain();
+}
+
+void Logger::log(int instanceId, boost::log::trivial::severity_level level,
+                 const char* file, const char* function, int line,
+                 std::string_view message, const char* tag) {
+  if (level < minSeverity_.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  ThreadQueue* queue = getThreadQueue();
+  if (queue == nullptr) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  const std::size_t head = queue->head.load(std::memory_order_relaxed);
+  if (head - queue->tail.load(std::memory_order_acquire) == kQueueCapacity) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  Record& record = queue->records[head % kQueueCapacity];
+  record.time = std::chrono::system_clock::now();
+  record.threadId = currentThreadId();
+  record.level = level;
+  record.instanceId = instanceId;
+  record.file = file;
+  record.function = function;
+  record.tag = tag;
+  record.line = line;
+  record.message.assign(message.data(), message.size());
+  record.sequence = nextSequence_.fetch_add(1, std::memory_order_relaxed);
+  queue->head.store(head + 1, std::memory_order_release);
+}
+
+Logger::ThreadQueue* Logger::getThreadQueue() {
+  thread_local ThreadQueue* queue = nullptr;
+  thread_local QueueClaim claim;
+  if (queue != nullptr) {
+    return queue;
+  }
+
+  for (std::size_t i = 0; i < kMaxThreads; ++i) {
+    bool expected = false;
+    if (queues_[i].claimed.compare_exchange_strong(
+            expected, true, std::memory_order_acquire)) {
+      queue = &queues_[i];
+      claim.claimed = &queue->claimed;
+      break;
+    }
+  }
+  return queue;
+}
+
+void Logger::runWriter() {
+  std::unique_lock<std::mutex> lock(writerMutex_);
+  while (!stopping_) {
+    writerWake_.wait_for(lock, kDrainInterval);
+    lock.unlock();
+    {
+      std::lock_guard<std::mutex> drainLock(drainMutex_);
+      drain();
+    }
+    lock.lock();
+  }
+}
+
+void Logger::drain() {
+  // Records queued after this point wait for the next drain, so a busy
+  // producer cannot keep the drain running.
+  for (std::size_t i = 0; i < kMaxThreads; ++i) {
+    drainEnds_[i] = queues_[i].head.load(std::memory_order_acquire);
+  }
+
+  // Merge the queues by sequence number so the log keeps call order.
+  bool wrote = false;
+  while (true) {
+    ThreadQueue* next = nullptr;
+    std::size_t nextTail = 0;
+    for (std::size_t i = 0; i < kMaxThreads; ++i) {
+      ThreadQueue& queue = queues_[i];
+      const std::size_t tail = queue.tail.load(std::memory_order_relaxed);
+      if (tail == drainEnds_[i]) {
+        continue;
+      }
+      if (next == nullptr ||
+          queue.records[tail % kQueueCapacity].sequence <
+              next->records[nextTail % kQueueCapacity].sequence) {
+        next = &queue;
+        nextTail = tail;
+      }
+    }
+    if (next == nullptr) {
+      break;
+    }
+
+    write(next->records[nextTail % kQueueCapacity]);
+    next->tail.store(nextTail + 1, std::memory_order_release);
+    wrote = true;
+  }
+
+  const std::uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+  if (dropped != reportedDrops_) {
+    timeStamp_.set(boost::posix_time::microsec_clock::local_time());
+    threadId_.set(currentThreadId());
+    BOOST_LOG_SEV(lg, boost::log::trivial::warning)
+        << "[ Logger ] Dropped " << dropped - reportedDrops_
+        << " log messages";
+    reportedDrops_ = dropped;
+    wrote = true;
+  }
+
+  if (wrote) {
+    boost::log::core::get()->flush();
+  }
+}
+
+void Logger::write(const Record& record) {
+  const std::string_view file = fileName(record.file);
+  formatted_.assign("[ Instance ");
+  formatted_.append(std::to_string(record.instanceId));
+  formatted_.append("] [ ");
+  formatted_.append(file.data(), file.size());
+  formatted_.append(" ");
+  formatted_.append(record.function);
+  formatted_.append(" ");
+  formatted_.append(std::to_string(record.line));
+  formatted_.append(" ] ");
+  if (record.tag != nullptr) {
+    formatted_.append(record.tag);
+  }
+  formatted_.append(record.message);
+
+  timeStamp_.set(toLocalTime(record.time));
+  threadId_.set(record.threadId);
+  BOOST_LOG_SEV(lg, record.level) << formatted_;
 }
\ No newline at end of file
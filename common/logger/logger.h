@@ -16,18 +16,40 @@
 
 #pragma once
 
+#include <atomic>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/log/attributes/current_thread_id.hpp>
+#include <boost/log/attributes/mutable_constant.hpp>
 #include <boost/log/sources/severity_logger.hpp>
 #include <boost/log/trivial.hpp>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 #define FILEINFO()                                                            \
   (std::string(boost::filesystem::path(__FILE__).filename().string()) + " " + \
    std::string(__FUNCTION__) + " " + std::to_string(__LINE__))
 
+// Log calls only copy the message into a record preallocated in the calling
+// thread's queue; a background thread merges the queues in call order,
+// formats the records and writes them to the rotating log files in batches.
+// This keeps logging wait-free on the audio and render threads.
 class Logger {
  public:
+  // Queue slots per logging thread, and threads that can log concurrently.
+  // Messages logged while the thread's queue is full or every queue is
+  // claimed are dropped and counted.
+  static constexpr std::size_t kQueueCapacity = 256;
+  static constexpr std::size_t kMaxThreads = 32;
+  // Messages up to this length are copied without allocating.
+  static constexpr std::size_t kInlineMessageLength = 256;
+
   static Logger& getInstance() {
     static Logger instance;
     return instance;
@@ -36,45 +58,81 @@ class Logger {
   void init(const std::string& pluginName, size_t maxFileSizeMB = 5,
             boost::log::trivial::severity_level minSeverity =
                 boost::log::trivial::info);
+  // Writes every message queued so far to the log files.
   void flush();
   std::vector<std::string> getLogFilePaths() const;
 
-  template <typename T>
+  // file and function must outlive the logger, as __FILE__ and __FUNCTION__
+  // do. tag, if given, is written in front of the message.
   void log(int instanceId, boost::log::trivial::severity_level level,
-           const T& message) {
-    BOOST_LOG_SEV(lg, level) << "[ Instance " << instanceId << "] " << message;
-  }
+           const char* file, const char* function, int line,
+           std::string_view message, const char* tag = nullptr);
 
   bool isInitialized() const { return initialized; }
+  std::uint64_t getDroppedCount() const {
+    return dropped_.load(std::memory_order_relaxed);
+  }
 
  private:
-  Logger() = default;
-  ~Logger() = default;
+  struct Record;
+  struct ThreadQueue;
+
+  Logger();
+  ~Logger();
   Logger(const Logger&) = delete;
   Logger& operator=(const Logger&) = delete;
 
+  ThreadQueue* getThreadQueue();
+  void runWriter();
+  // Writes out every queued record. Callers hold drainMutex_.
+  void drain();
+  void write(const Record& record);
+
   std::mutex initMutex;
   bool initialized = false;
   std::string logFilePattern;
   boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>
       lg;
+  // Stamped per record so the log shows when and where it was logged rather
+  // than when it was written.
+  boost::log::attributes::mutable_constant<boost::posix_time::ptime>
+      timeStamp_;
+  boost::log::attributes::mutable_constant<
+      boost::log::attributes::current_thread_id::value_type>
+      threadId_;
+
+  std::unique_ptr<ThreadQueue[]> queues_;
+  std::atomic<std::uint64_t> nextSequence_{0};
+  std::atomic<std::uint64_t> dropped_{0};
+  std::atomic<int> minSeverity_{boost::log::trivial::trace};
+
+  std::mutex drainMutex_;
+  std::vector<std::size_t> drainEnds_;
+  std::string formatted_;
+  std::uint64_t reportedDrops_ = 0;
+
+  std::mutex writerMutex_;
+  std::condition_variable writerWake_;
+  bool stopping_ = false;
+  std::thread writer_;
 };
 #define LOG_DEBUG(instanceId, message)                              \
   Logger::getInstance().log(instanceId, boost::log::trivial::debug, \
-                            "[ " + FILEINFO() + " ] " + (message))
+                            __FILE__, __FUNCTION__, __LINE__, (message))
 
 #define LOG_INFO(instanceId, message)                              \
   Logger::getInstance().log(instanceId, boost::log::trivial::info, \
-                            "[ " + FILEINFO() + " ] " + (message))
+                            __FILE__, __FUNCTION__, __LINE__, (message))
 
 #define LOG_WARNING(instanceId, message)                              \
   Logger::getInstance().log(instanceId, boost::log::trivial::warning, \
-                            "[ " + FILEINFO() + " ] " + (message))
+                            __FILE__, __FUNCTION__, __LINE__, (message))
 
 #define LOG_ERROR(instanceId, message)                              \
   Logger::getInstance().log(instanceId, boost::log::trivial::error, \
-                            "[ " + FILEINFO() + " ] " + (message))
+                            __FILE__, __FUNCTION__, __LINE__, (message))
 
 #define LOG_ANALYTICS(instanceId, message)                         \
   Logger::getInstance().log(instanceId, boost::log::trivial::info, \
-                            "[ " + FILEINFO() + " ] [Analytics] " + (message))
+                            __FILE__, __FUNCTION__, __LINE__, (message), \
+                            "[Analytics] ")
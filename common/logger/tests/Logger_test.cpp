@@ -193,6 +193,46 @@ TEST(LoggerTest, LogFromMultipleThreads) {
   }
 }
 
+// Test that messages queued by different threads are written in call order,
+// including those from threads that exited before the flush
+TEST(LoggerTest, MessagesKeepCallOrderAcrossThreads) {
+  Logger::getInstance().init("testlog");
+  std::vector<std::string> existingLogFiles =
+      Logger::getInstance().getLogFilePaths();
+  for (const auto& file : existingLogFiles) {
+    std::remove(file.c_str());
+  }
+
+  std::thread first([] { LOG_INFO(1, "Ordered message A"); });
+  first.join();
+  LOG_INFO(1, "Ordered message B");
+  std::thread second([] { LOG_INFO(2, "Ordered message C"); });
+  second.join();
+
+  Logger::getInstance().flush();
+
+  std::vector<std::string> logFiles = Logger::getInstance().getLogFilePaths();
+  std::string logContent;
+  for (const auto& file : logFiles) {
+    logContent += readLogFile(file);
+  }
+
+  const size_t posA = logContent.find("Ordered message A");
+  const size_t posB = logContent.find("Ordered message B");
+  const size_t posC = logContent.find("Ordered message C");
+  ASSERT_NE(posA, std::string::npos) << "Message from exited thread not found";
+  ASSERT_NE(posB, std::string::npos) << "Message from main thread not found";
+  ASSERT_NE(posC, std::string::npos) << "Message from exited thread not found";
+  EXPECT_LT(posA, posB) << "Messages were not written in call order";
+  EXPECT_LT(posB, posC) << "Messages were not written in call order";
+  EXPECT_EQ(Logger::getInstance().getDroppedCount(), 0u);
+
+  // Clean up
+  for (const auto& file : logFiles) {
+    std::remove(file.c_str());
+  }
+}
+
 // Test if init is called multiple times (ensure it doesn't reinitialize)
 TEST(LoggerTest, LoggerInitMultipleCalls) {
   // Initialize logger - the path is now determined automatically by JUCE
@@ -14,28 +14,50 @@
 
 #include "AudioElementPluginDataPublisher.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <memory>
+#include <utility>
 
 #include "data_structures/src/AudioElementCommunication.h"
 
 AudioElementPluginDataPublisher::AudioElementPluginDataPublisher(
     AudioElementSpatialLayoutRepository* audioElementSpatialLayoutRepository,
-    AudioElementParameterTree* automationParameterTree)
+    AudioElementParameterTree* automationParameterTree, float publishRateHz)
+    : AudioElementPluginDataPublisher(audioElementSpatialLayoutRepository,
+                                      automationParameterTree, publishRateHz,
+                                      nullptr) {}
+
+AudioElementPluginDataPublisher::AudioElementPluginDataPublisher(
+    AudioElementSpatialLayoutRepository* audioElementSpatialLayoutRepository,
+    AudioElementParameterTree* automationParameterTree, float publishRateHz,
+    PublishFunction publish)
     : audioElementSpatialLayoutData_(audioElementSpatialLayoutRepository),
-      automationParameterTree_(automationParameterTree) {
+      automationParameterTree_(automationParameterTree),
+      publish_(std::move(publish)),
+      channels_(0),
+      loudness_(0.f),
+      forcePublish_(true),
+      publishRateHz_(publishRateHz),
+      stopSender_(false) {
   // Set up the initial data
-  localData_.x = automationParameterTree_->getXPosition();
-  localData_.y = automationParameterTree_->getYPosition();
-  localData_.z = automationParameterTree_->getZPosition();
-  dataChanged_ = true;
+  x_.store(automationParameterTree_->getXPosition());
+  y_.store(automationParameterTree_->getYPosition());
+  z_.store(automationParameterTree_->getZPosition());
 
   // Update any information from the repository
   updateData();
 
-  // Now connect the publisher
-  publisher_ =
-      std::unique_ptr<AudioElementPublisher>(new AudioElementPublisher());
+  // Now connect the publisher and start sending
+  if (!publish_) {
+    publisher_ =
+        std::unique_ptr<AudioElementPublisher>(new AudioElementPublisher());
+    publish_ = [this](const AudioElementUpdateData& data) {
+      publisher_->publishData(data);
+    };
+  }
+  senderThread_ = std::thread([this] { runSender(); });
 
   automationParameterTree_->addXPositionListener(this);
   automationParameterTree_->addYPositionListener(this);
@@ -44,45 +66,89 @@ AudioElementPluginDataPublisher::AudioElementPluginDataPublisher(
   audioElementSpatialLayoutRepository->registerListener(this);
 }
 
-AudioElementPluginDataPublisher::~AudioElementPluginDataPublisher() {}
+AudioElementPluginDataPublisher::~AudioElementPluginDataPublisher() {
+  {
+    std::lock_guard<std::mutex> lock(senderMutex_);
+    stopSender_ = true;
+  }
+  senderCondition_.notify_all();
+  senderThread_.join();
+}
 
 void AudioElementPluginDataPublisher::prepareToPlay(double sampleRate,
                                                     int samplesPerBlock) {
-  dataChanged_ = true;
+  forcePublish_.store(true);
 }
 
 void AudioElementPluginDataPublisher::updateData() {
+  const auto layout = audioElementSpatialLayoutData_->get();
+  channels_.store(layout.getChannelLayout().getNumChannels());
+
+  const juce::SpinLock::ScopedLockType lock(identityLock_);
   // Fetch the audio element plugin name from the repository
-  strncpy(localData_.name,
-          audioElementSpatialLayoutData_->get().getName().toRawUTF8(),
-          sizeof(localData_.name));
-  localData_.name[sizeof(localData_.name) - 1] =
-      '\0';  // Ensure null-terminated
-  channels_ =
-      audioElementSpatialLayoutData_->get().getChannelLayout().getNumChannels();
-  std::memcpy(localData_.uuid.data(),
-              audioElementSpatialLayoutData_->get().getId().getRawData(),
-              localData_.uuid.size());
+  strncpy(identity_.name, layout.getName().toRawUTF8(),
+          sizeof(identity_.name));
+  identity_.name[sizeof(identity_.name) - 1] = '\0';  // Ensure null-terminated
+  std::memcpy(identity_.uuid.data(), layout.getId().getRawData(),
+              identity_.uuid.size());
+  forcePublish_.store(true);
+}
+
+void AudioElementPluginDataPublisher::runSender() {
+  const auto period = std::chrono::microseconds(
+      static_cast<long long>(1e6 / std::max(publishRateHz_, 1.f)));
+  auto lastPublishTime = std::chrono::steady_clock::now();
+
+  std::unique_lock<std::mutex> lock(senderMutex_);
+  while (!senderCondition_.wait_for(lock, period,
+                                    [this] { return stopSender_; })) {
+    AudioElementUpdateData data;
+    {
+      const juce::SpinLock::ScopedLockType identityLock(identityLock_);
+      data.uuid = identity_.uuid;
+      std::memcpy(data.name, identity_.name, sizeof(data.name));
+    }
+    data.x = x_.load(std::memory_order_relaxed);
+    data.y = y_.load(std::memory_order_relaxed);
+    data.z = z_.load(std::memory_order_relaxed);
+    data.loudness = loudness_.load(std::memory_order_relaxed);
+
+    const auto now = std::chrono::steady_clock::now();
+    const bool heartbeatDue =
+        now - lastPublishTime >=
+        std::chrono::milliseconds(kHeartbeatIntervalMs);
+    if (forcePublish_.exchange(false) || heartbeatDue ||
+        shouldPublish(data)) {
+      publish_(data);
+      lastPublished_ = data;
+      lastPublishTime = now;
+    }
+  }
+}
+
+bool AudioElementPluginDataPublisher::shouldPublish(
+    const AudioElementUpdateData& data) const {
+  return data.x != lastPublished_.x || data.y != lastPublished_.y ||
+         data.z != lastPublished_.z ||
+         std::abs(data.loudness - lastPublished_.loudness) >=
+             kLoudnessThresholdDb;
 }
 
 void AudioElementPluginDataPublisher::processBlock(
     juce::AudioBuffer<float>& buffer, juce::MidiBuffer&) {
+  const int channels = channels_.load(std::memory_order_relaxed);
+  if (channels == 0) {
+    return;
+  }
   float loudness = 0;
-  for (int i = 0; i < channels_; ++i) {
+  for (int i = 0; i < channels; ++i) {
     float chLoud =
         20.0f * std::log10(buffer.getRMSLevel(i, 0, buffer.getNumSamples()));
     // Clamp the loudness to -70 dB since some tracks will be -Inf
     loudness += std::max(chLoud, -70.0f);
   }
-  loudness = loudness / channels_;
-  if (loudness != localData_.loudness) {
-    localData_.loudness = loudness;
-    dataChanged_ = true;
-  }
+  loudness = loudness / channels;
 
-  // Publish this information if it has changed since last time
-  if (dataChanged_) {
-    publisher_.get()->publishData(localData_);
-    dataChanged_ = false;
-  }
+  // The sender thread publishes the latest value
+  loudness_.store(loudness, std::memory_order_relaxed);
 }
@@ -16,7 +16,12 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 #include "../processor_base/ProcessorBase.h"
 #include "data_repository/implementation/AudioElementRepository.h"
@@ -26,6 +31,9 @@
 #include "data_structures/src/ParameterMetaData.h"
 
 //==============================================================================
+// Publishes the position and loudness of an audio element plugin to the
+// renderer. The audio thread only stores the latest state. A sender thread
+// publishes it at a fixed rate, when it has changed by more than a threshold.
 class AudioElementPluginDataPublisher final
     : public ProcessorBase,
       juce::ValueTree::Listener,
@@ -34,7 +42,16 @@ class AudioElementPluginDataPublisher final
   //==============================================================================
   AudioElementPluginDataPublisher(
       AudioElementSpatialLayoutRepository* audioElementSpatialLayoutRepository,
-      AudioElementParameterTree* automationParameterTree);
+      AudioElementParameterTree* automationParameterTree,
+      float publishRateHz = kDefaultPublishRateHz);
+
+  // Publishes through the given function rather than to the renderer, for
+  // unit tests. Called on the sender thread.
+  using PublishFunction = std::function<void(const AudioElementUpdateData&)>;
+  AudioElementPluginDataPublisher(
+      AudioElementSpatialLayoutRepository* audioElementSpatialLayoutRepository,
+      AudioElementParameterTree* automationParameterTree, float publishRateHz,
+      PublishFunction publish);
   ~AudioElementPluginDataPublisher() override;
 
   //==============================================================================
@@ -73,28 +90,52 @@ class AudioElementPluginDataPublisher final
   //==============================================================================
   void parameterChanged(const juce::String& parameterID,
                         float newValue) override {
-    // Guaranteed to be called before processBlock so we don't need to lock
+    // May be called from the audio thread, so only store the new value
     if (parameterID == AutoParamMetaData::xPosition) {
-      localData_.x = newValue;
+      x_.store(newValue, std::memory_order_relaxed);
     } else if (parameterID == AutoParamMetaData::yPosition) {
-      localData_.y = newValue;
+      y_.store(newValue, std::memory_order_relaxed);
     } else if (parameterID == AutoParamMetaData::zPosition) {
-      localData_.z = newValue;
+      z_.store(newValue, std::memory_order_relaxed);
     }
-    dataChanged_ = true;
   }
 
   //==============================================================================
+  inline static constexpr float kDefaultPublishRateHz = 30.f;
+  // Loudness changes smaller than this are not published
+  inline static constexpr float kLoudnessThresholdDb = 0.5f;
+  // Unchanged state is republished at this interval, for late subscribers
+  inline static constexpr int kHeartbeatIntervalMs = 1000;
 
  private:
   void updateData();
 
+  void runSender();
+
+  bool shouldPublish(const AudioElementUpdateData& data) const;
+
   AudioElementSpatialLayoutRepository* audioElementSpatialLayoutData_;
   AudioElementParameterTree* automationParameterTree_;
-  bool dataChanged_;
-  AudioElementUpdateData localData_;
   std::unique_ptr<AudioElementPublisher> publisher_;
-  int channels_;
+  PublishFunction publish_;
+  std::atomic<int> channels_;
+
+  // Latest state, written by the audio and message threads
+  std::atomic<float> x_;
+  std::atomic<float> y_;
+  std::atomic<float> z_;
+  std::atomic<float> loudness_;
+  std::atomic<bool> forcePublish_;
+  juce::SpinLock identityLock_;
+  AudioElementUpdateData identity_;  // Name and uuid of the element
+
+  // Sender thread state
+  const float publishRateHz_;
+  AudioElementUpdateData lastPublished_;
+  std::thread senderThread_;
+  std::mutex senderMutex_;
+  std::condition_variable senderCondition_;
+  bool stopSender_;
 
   //==============================================================================
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioElementPluginDataPublisher)
@@ -28,11 +28,11 @@ ChannelMonitorProcessor::ChannelMonitorProcessor(
       loudness_(std::vector<float>(numChannels_, -300.f)),
       mixPresentationRepository_(mixPresentationRepository),
       mixPresentationSoloMuteRepository_(mixPresentationSoloMuteRepository) {
-  mixPresentationRepository_->registerListener(this);
+  mixPresentationRepository_->registerTransactionListener(this);
 }
 
 ChannelMonitorProcessor::~ChannelMonitorProcessor() {
-  mixPresentationRepository_->deregisterListener(this);
+  mixPresentationRepository_->deregisterTransactionListener(this);
 }
 
 const juce::String ChannelMonitorProcessor::getName() const {
@@ -128,4 +128,48 @@ void ChannelMonitorProcessor::valueTreeChildRemoved(
 
     mixPresentationSoloMuteRepository_->update(mixPresSoloMute);
   }
+}
+
+void ChannelMonitorProcessor::repositoryTransactionCommitted(
+    juce::ValueTree& state) {
+  juce::ignoreUnused(state);
+
+  // Remove the solo/mute state of mix presentations that no longer exist
+  juce::OwnedArray<MixPresentationSoloMute> soloMutes;
+  mixPresentationSoloMuteRepository_->getAll(soloMutes);
+  for (const MixPresentationSoloMute* soloMute : soloMutes) {
+    if (!mixPresentationRepository_->get(soloMute->getId()).has_value()) {
+      mixPresentationSoloMuteRepository_->remove(*soloMute);
+    }
+  }
+
+  const auto mixPresentations = mixPresentationRepository_->getSnapshot();
+  for (const MixPresentation& mixPresentation : mixPresentations->items) {
+    const juce::Uuid mixPresID = mixPresentation.getId();
+    const std::optional<MixPresentationSoloMute> existing =
+        mixPresentationSoloMuteRepository_->get(mixPresID);
+
+    // Keep the solo/mute state of audio elements still in the mix
+    MixPresentationSoloMute mixPresSoloMute(mixPresID);
+    for (const MixPresentationAudioElement& audioElement :
+         mixPresentation.getAudioElements()) {
+      const juce::Uuid audioElementId = audioElement.getId();
+      mixPresSoloMute.addAudioElement(audioElementId,
+                                      audioElement.getReferenceId(),
+                                      audioElement.getName());
+      if (existing.has_value()) {
+        mixPresSoloMute.setAudioElementSolo(
+            audioElementId, existing->isAudioElementSoloed(audioElementId));
+        mixPresSoloMute.setAudioElementMute(
+            audioElementId, existing->isAudioElementMuted(audioElementId));
+      }
+    }
+
+    if (!existing.has_value() ||
+        existing->getAudioElements().size() !=
+            mixPresSoloMute.getAudioElements().size() ||
+        *existing != mixPresSoloMute) {
+      mixPresentationSoloMuteRepository_->updateOrAdd(mixPresSoloMute);
+    }
+  }
 }
\ No newline at end of file
@@ -34,7 +34,7 @@
 
 //==============================================================================
 class ChannelMonitorProcessor final : public ProcessorBase,
-                                      juce::ValueTree::Listener {
+                                      RepositoryTransactionListener {
  public:
   ChannelMonitorProcessor(
       ChannelMonitorData& channelMonitorData,
@@ -46,6 +46,10 @@ class ChannelMonitorProcessor final : public ProcessorBase,
   void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
   using AudioProcessor::processBlock;
 
+  BufferAccess getBufferAccess() const override {
+    return BufferAccess::kReadOnly;
+  }
+
   bool hasEditor() const override;
 
   const juce::String getName() const override;
@@ -58,6 +62,10 @@ class ChannelMonitorProcessor final : public ProcessorBase,
                              juce::ValueTree& childWhichHasBeenRemoved,
                              int indexFromWhichChildWasRemoved) override;
 
+  // Bring the solo/mute state of every mix presentation in line with the
+  // mix presentation repository after a transaction
+  void repositoryTransactionCommitted(juce::ValueTree& state) override;
+
   ChannelMonitorData& channelMonitorData_;
   MixPresentationRepository* mixPresentationRepository_;
   MixPresentationSoloMuteRepository* mixPresentationSoloMuteRepository_;
@@ -18,7 +18,7 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
 
-#include "FileWriter.h"
+#include "MappedWavWriter.h"
 #include "data_structures/src/AudioElement.h"
 
 class AudioElementFileWriter {
@@ -29,8 +29,9 @@ class AudioElementFileWriter {
       : element_(element)  // Use a local copy of the audio element to avoid
                            // updates elsewhere causing issues
   {
-    fileWriter = new FileWriter(filename, sampleRate, element.getChannelCount(),
-                                element.getFirstChannel(), bitDepth, codec);
+    fileWriter =
+        new MappedWavWriter(filename, sampleRate, element.getChannelCount(),
+                            element.getFirstChannel(), bitDepth);
   }
 
   ~AudioElementFileWriter() {
@@ -49,7 +50,15 @@ class AudioElementFileWriter {
   AudioElementFileWriter& operator=(AudioElementFileWriter&&) noexcept =
       default;
 
-  void write(juce::AudioBuffer<float>& buffer) { fileWriter->write(buffer); }
+  void write(juce::AudioBuffer<float>& buffer) {
+    write(buffer, 0, buffer.getNumSamples());
+  }
+
+  // Write only numSamples samples of the buffer, starting at startSample.
+  void write(const juce::AudioBuffer<float>& buffer, int startSample,
+             int numSamples) {
+    fileWriter->write(buffer, startSample, numSamples);
+  }
 
   void close() { fileWriter->close(); }
 
@@ -62,5 +71,5 @@ class AudioElementFileWriter {
  private:
   AudioElement element_;  // Use a local copy to avoid updates elsewhere causing
                           // issues
-  FileWriter* fileWriter;
+  MappedWavWriter* fileWriter;
 };
\ No newline at end of file
@@ -0,0 +1,286 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ExportJobProcessor.h"
+
+#include <logger/logger.h>
+
+#include "data_structures/src/AudioElement.h"
+#include "data_structures/src/FileExport.h"
+#include "data_structures/src/MixPresentation.h"
+#include "substream_rdr/bin_rdr/BinauralRdr.h"
+#include "substream_rdr/rdr_factory/RendererFactory.h"
+#include "substream_rdr/substream_rdr_utils/Speakers.h"
+
+ExportJobProcessor::ExportJobProcessor(
+    FileExportRepository& fileExportRepository,
+    AudioElementRepository& audioElementRepository,
+    MixPresentationRepository& mixPresentationRepository,
+    ActiveMixRepository& activeMixRepository)
+    : fileExportRepository_(fileExportRepository),
+      exportJobRepository_(getExportJobRepository(fileExportRepository)),
+      audioElementRepository_(audioElementRepository),
+      mixPresentationRepository_(mixPresentationRepository),
+      activeMixRepository_(activeMixRepository),
+      performingRender_(false),
+      numSamples_(0),
+      sampleRate_(48000) {
+  setActive(performingRender_);
+}
+
+ExportJobProcessor::~ExportJobProcessor() { closeJobWriters(); }
+
+//==============================================================================
+void ExportJobProcessor::prepareToPlay(double sampleRate,
+                                       int samplesPerBlock) {
+  numSamples_ = samplesPerBlock;
+  sampleRate_ = sampleRate;
+  exportRange_.rewind();
+}
+
+void ExportJobProcessor::processBlock(juce::AudioBuffer<float>& buffer,
+                                      juce::MidiBuffer& midiMessages) {
+  juce::ignoreUnused(midiMessages);
+  if (!lock_.tryEnter()) {
+    return;  // Writers are being created or closed, avoid blocking
+  }
+
+  if (performingRender_ && buffer.getNumSamples() > 0) {
+    // Track the export range the same way the IAMF export does, so every
+    // deliverable of the pass covers the same samples.
+    const int numSamples = buffer.getNumSamples();
+    if (exportRange_.advance(numSamples).isEmpty()) {
+      for (auto& jobWriter : jobWriters_) {
+        jobWriter->writeRange.advance(numSamples);
+      }
+    } else {
+      // Hosts may pass blocks larger than prepared when rendering offline.
+      // These are rendered a prepared block at a time.
+      for (int start = 0; start < numSamples; start += numSamples_) {
+        const juce::Range<int> chunk(start,
+                                     std::min(start + numSamples_, numSamples));
+        for (auto& jobWriter : jobWriters_) {
+          renderJob(*jobWriter, buffer, chunk);
+        }
+      }
+    }
+  }
+  lock_.exit();
+}
+
+void ExportJobProcessor::skipBlock(int numSamples) {
+  if (!lock_.tryEnter()) {
+    return;
+  }
+  if (performingRender_) {
+    exportRange_.advance(numSamples);
+    for (auto& jobWriter : jobWriters_) {
+      jobWriter->writeRange.advance(numSamples);
+    }
+  }
+  lock_.exit();
+}
+
+void ExportJobProcessor::setNonRealtime(bool isNonRealtime) noexcept {
+  const juce::SpinLock::ScopedLockType lock(lock_);
+  if (isNonRealtime == performingRender_) {
+    return;
+  }
+
+  if (isNonRealtime) {
+    FileExport config = fileExportRepository_.get();
+    if (config.getExportAudio()) {
+      initializeJobWriters(config);
+    }
+  } else {
+    closeJobWriters();
+  }
+}
+
+//==============================================================================
+void ExportJobProcessor::initializeJobWriters(const FileExport& config) {
+  jobWriters_.clear();
+  sampleRate_ = config.getSampleRate();
+  latency_ = 0;
+  exportRange_.reset(config.getSampleRate(), config.getStartTime(),
+                     config.getEndTime());
+
+  const std::shared_ptr<const ExportJobRepository::Snapshot> jobs =
+      exportJobRepository_.getSnapshot();
+  if (jobs->items.empty()) {
+    return;
+  }
+
+  // All jobs render the active mix presentation.
+  std::optional<MixPresentation> activeMix = mixPresentationRepository_.get(
+      activeMixRepository_.get().getActiveMixId());
+  if (!activeMix) {
+    LOG_ERROR(0, "Export jobs skipped, no active mix presentation.");
+    return;
+  }
+  mixPresentationGain_ = activeMix->getDefaultMixGain();
+  const std::vector<MixPresentationAudioElement> mixPresAEs =
+      activeMix->getAudioElements();
+
+  for (const ExportJob& job : jobs->items) {
+    if (!job.isEnabled() || job.getExportFile().isEmpty()) {
+      continue;
+    }
+
+    auto jobWriter = std::make_unique<ExportJobWriter>();
+    jobWriter->job = job;
+    const Speakers::AudioElementSpeakerLayout jobLayout = job.getLayout();
+
+    for (const MixPresentationAudioElement& mixPresAE : mixPresAEs) {
+      std::optional<AudioElement> ae =
+          audioElementRepository_.get(mixPresAE.getId());
+      if (!ae) {
+        continue;
+      }
+
+      // Binaural jobs follow the per-element binaural setting used by the
+      // monitoring render. Elements not rendered binaurally are downmixed to
+      // stereo.
+      ExportJobWriter::ElementRenderer elementRenderer;
+      const Speakers::AudioElementSpeakerLayout inputLayout =
+          ae->getChannelConfig();
+      // Offline hosts vary their block size, so binaural rendering is always
+      // buffered.
+      if (jobLayout == Speakers::kBinaural && !mixPresAE.isBinaural()) {
+        elementRenderer.renderer =
+            createRenderer(inputLayout, Speakers::kStereo);
+      } else {
+        elementRenderer.renderer = createRenderer(
+            inputLayout, jobLayout, numSamples_, (int)sampleRate_, true);
+      }
+      if (elementRenderer.renderer == nullptr) {
+        LOG_ERROR(0, "Export job could not create a renderer for audio "
+                     "element: " +
+                         ae->getId().toString().toStdString());
+        continue;
+      }
+      elementRenderer.firstChannel = ae->getFirstChannel();
+      elementRenderer.inputData.setSize(
+          inputLayout.getExplBaseLayout().getNumChannels(), numSamples_);
+      elementRenderer.outputData.setSize(jobLayout.getNumChannels(),
+                                         numSamples_);
+      jobWriter->elementRenderers.push_back(std::move(elementRenderer));
+    }
+
+    // As in the monitoring render, delay the renderers without the latency of
+    // the binaural renderers to keep the mix aligned, and trim the latency
+    // from the start of the file.
+    int jobLatency = 0;
+    for (const auto& elementRenderer : jobWriter->elementRenderers) {
+      jobLatency =
+          std::max(jobLatency, elementRenderer.renderer->getLatencySamples());
+    }
+    for (auto& elementRenderer : jobWriter->elementRenderers) {
+      if (elementRenderer.renderer->getLatencySamples() < jobLatency) {
+        elementRenderer.renderer = std::make_unique<BinauralCopyRdr>(
+            numSamples_, std::move(elementRenderer.renderer));
+      }
+    }
+    jobWriter->writeRange.reset(config.getSampleRate(), config.getStartTime(),
+                                config.getEndTime());
+    jobWriter->writeRange.delay(jobLatency);
+    latency_ = std::max(latency_, jobLatency);
+
+    jobWriter->mixBuffer.setSize(jobLayout.getNumChannels(), numSamples_);
+    jobWriter->fileWriter = std::make_unique<FileWriter>(
+        job.getExportFile(), config.getSampleRate(),
+        jobLayout.getNumChannels(), 0, job.getBitDepth(), AudioCodec::LPCM);
+    jobWriters_.push_back(std::move(jobWriter));
+  }
+  // Keep rendering past the end of the range until the jobs have written it
+  exportRange_.extend(latency_);
+
+  LOG_ANALYTICS(0, "Beginning export of " + std::to_string(jobWriters_.size()) +
+                       " export jobs");
+  setPerformingRender(true);
+}
+
+void ExportJobProcessor::closeJobWriters() {
+  // Render silence through the renderers to write out the samples they still
+  // hold. The buffer has no channels, so the renderers' input stays cleared.
+  const juce::AudioBuffer<float> silence(0, latency_);
+  for (int start = 0; start < latency_; start += numSamples_) {
+    const juce::Range<int> chunk(start,
+                                 std::min(start + numSamples_, latency_));
+    for (auto& jobWriter : jobWriters_) {
+      renderJob(*jobWriter, silence, chunk);
+    }
+  }
+  latency_ = 0;
+
+  for (auto& jobWriter : jobWriters_) {
+    jobWriter->fileWriter->close();
+  }
+  jobWriters_.clear();
+  setPerformingRender(false);
+}
+
+void ExportJobProcessor::renderJob(ExportJobWriter& jobWriter,
+                                   const juce::AudioBuffer<float>& buffer,
+                                   const juce::Range<int> chunk) {
+  // Renderers buffering blocks take every sample they are given, so the
+  // buffers are sized to the chunk within their allocations.
+  const int numSamples = chunk.getLength();
+  jobWriter.mixBuffer.setSize(jobWriter.mixBuffer.getNumChannels(), numSamples,
+                              false, false, true);
+  jobWriter.mixBuffer.clear();
+  for (auto& elementRenderer : jobWriter.elementRenderers) {
+    elementRenderer.inputData.setSize(
+        elementRenderer.inputData.getNumChannels(), numSamples, false, false,
+        true);
+    elementRenderer.outputData.setSize(
+        elementRenderer.outputData.getNumChannels(), numSamples, false, false,
+        true);
+    elementRenderer.inputData.clear();
+    elementRenderer.outputData.clear();
+
+    const int numInputChannels =
+        std::min(elementRenderer.inputData.getNumChannels(),
+                 buffer.getNumChannels() - elementRenderer.firstChannel);
+    for (int ch = 0; ch < numInputChannels; ++ch) {
+      elementRenderer.inputData.copyFrom(ch, 0, buffer,
+                                         elementRenderer.firstChannel + ch,
+                                         chunk.getStart(), numSamples);
+    }
+
+    elementRenderer.renderer->render(elementRenderer.inputData,
+                                     elementRenderer.outputData);
+
+    const int numOutputChannels =
+        std::min(elementRenderer.outputData.getNumChannels(),
+                 jobWriter.mixBuffer.getNumChannels());
+    for (int ch = 0; ch < numOutputChannels; ++ch) {
+      jobWriter.mixBuffer.addFrom(ch, 0, elementRenderer.outputData, ch, 0,
+                                  numSamples);
+    }
+  }
+  jobWriter.mixBuffer.applyGain(0, numSamples, mixPresentationGain_);
+
+  // Only write the samples of this chunk inside the job's write range.
+  const juce::Range<int> samplesToWrite =
+      jobWriter.writeRange.advance(numSamples);
+  if (samplesToWrite.isEmpty()) {
+    return;
+  }
+  juce::AudioBuffer<float> toWrite(
+      jobWriter.mixBuffer.getArrayOfWritePointers(),
+      jobWriter.mixBuffer.getNumChannels(), samplesToWrite.getStart(),
+      samplesToWrite.getLength());
+  jobWriter.fileWriter->write(toWrite);
+}
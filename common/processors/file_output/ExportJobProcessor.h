@@ -0,0 +1,119 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <data_repository/data_repository.h>
+#include <juce_audio_processors/juce_audio_processors.h>
+
+#include <memory>
+#include <vector>
+
+#include "../processor_base/ProcessorBase.h"
+#include "ExportRange.h"
+#include "FileWriter.h"
+#include "data_repository/implementation/ActiveMixPresentationRepository.h"
+#include "data_repository/implementation/ExportJobRepository.h"
+#include "data_structures/src/ExportJob.h"
+#include "substream_rdr/rdr_factory/Renderer.h"
+
+// Renders the audio elements of the active mix presentation to the playback
+// layout of a single export job and writes the mix to the job's file.
+struct ExportJobWriter {
+  struct ElementRenderer {
+    std::unique_ptr<Renderer> renderer;
+    juce::AudioBuffer<float> inputData;
+    juce::AudioBuffer<float> outputData;
+    int firstChannel;
+  };
+
+  ExportJob job;
+  std::vector<ElementRenderer> elementRenderers;
+  // The samples of the rendered mix to write, which trail the timeline by the
+  // latency of the job's renderers.
+  ExportRange writeRange;
+  juce::AudioBuffer<float> mixBuffer;
+  std::unique_ptr<FileWriter> fileWriter;
+};
+
+//==============================================================================
+// Fans the pre-render audio element stream out to every enabled export job, so
+// a single bounce produces the primary export and each additional layout.
+class ExportJobProcessor final : public ProcessorBase {
+ public:
+  //==============================================================================
+  ExportJobProcessor(FileExportRepository& fileExportRepository,
+                     AudioElementRepository& audioElementRepository,
+                     MixPresentationRepository& mixPresentationRepository,
+                     ActiveMixRepository& activeMixRepository);
+  ~ExportJobProcessor() override;
+
+  //==============================================================================
+  void prepareToPlay(double sampleRate, int samplesPerBlock) override;
+  void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+  using AudioProcessor::processBlock;
+
+  BufferAccess getBufferAccess() const override {
+    return BufferAccess::kReadOnly;
+  }
+
+  void skipBlock(int numSamples) override;
+
+  void setNonRealtime(bool isNonRealtime) noexcept override;
+
+  //==============================================================================
+  const juce::String getName() const override { return "ExportJobOutput"; }
+
+  int getActiveJobCount() const { return (int)jobWriters_.size(); }
+
+ private:
+  void initializeJobWriters(const FileExport& config);
+
+  // Writes what the renderers still hold, then closes the files.
+  void closeJobWriters();
+
+  // Render one chunk of the buffer, no longer than the prepared block, and
+  // write the samples of it in the job's write range.
+  void renderJob(ExportJobWriter& jobWriter,
+                 const juce::AudioBuffer<float>& buffer,
+                 juce::Range<int> chunk);
+
+  FileExportRepository& fileExportRepository_;
+  // Created with the processor, on the message thread, so starting a render
+  // only reads a snapshot of the jobs
+  ExportJobRepository exportJobRepository_;
+  AudioElementRepository& audioElementRepository_;
+  MixPresentationRepository& mixPresentationRepository_;
+  ActiveMixRepository& activeMixRepository_;
+  std::vector<std::unique_ptr<ExportJobWriter>> jobWriters_;
+  float mixPresentationGain_ = 1.f;
+  // Only take part in the chain while rendering
+  void setPerformingRender(bool performingRender) {
+    performingRender_ = performingRender;
+    setActive(performingRender);
+  }
+
+  bool performingRender_;  // True if we are rendering in offline mode
+  int numSamples_;
+  long sampleRate_;
+  // Largest latency of the jobs' renderers
+  int latency_ = 0;
+  // The samples to render, from the start of the export range until the
+  // renderers have output its end
+  ExportRange exportRange_;
+  juce::SpinLock lock_;
+  //==============================================================================
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ExportJobProcessor)
+};
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <juce_core/juce_core.h>
+
+#include <algorithm>
+#include <limits>
+
+// Tracks the position of an offline export and the samples of each block that
+// fall inside the configured start and end times. Blocks straddling either
+// bound are trimmed to the exact sample, rather than kept or dropped whole.
+class ExportRange {
+ public:
+  // Start and end times are in seconds. An end time of 0 leaves the end of
+  // the range open.
+  void reset(const double sampleRate, const int startTime, const int endTime) {
+    start_ = static_cast<juce::int64>(startTime * sampleRate);
+    end_ = endTime > 0 ? static_cast<juce::int64>(endTime * sampleRate)
+                       : std::numeric_limits<juce::int64>::max();
+    position_ = 0;
+  }
+
+  // Moves the range later by numSamples, to select the same samples from an
+  // output trailing the timeline by that many samples.
+  void delay(const int numSamples) {
+    start_ += numSamples;
+    extend(numSamples);
+  }
+
+  // Moves the end of the range later by numSamples, if it has one.
+  void extend(const int numSamples) {
+    if (end_ != std::numeric_limits<juce::int64>::max()) {
+      end_ += numSamples;
+    }
+  }
+
+  // Restart counting from the beginning of the timeline.
+  void rewind() { position_ = 0; }
+
+  // True if the next block of numSamples ends before the range starts, in
+  // which case it needs no processing for the export.
+  bool isBeforeStart(const int numSamples) const {
+    return position_ + numSamples <= start_;
+  }
+
+  // Returns the samples of the next block of numSamples that lie inside the
+  // range, relative to the start of the block, and moves past the block.
+  juce::Range<int> advance(const int numSamples) {
+    const juce::int64 blockStart = position_;
+    position_ += numSamples;
+    const juce::int64 first =
+        std::clamp<juce::int64>(start_ - blockStart, 0, numSamples);
+    const juce::int64 last =
+        std::clamp<juce::int64>(end_ - blockStart, first, numSamples);
+    return {static_cast<int>(first), static_cast<int>(last)};
+  }
+
+  juce::int64 getPosition() const { return position_; }
+
+ private:
+  juce::int64 start_ = 0;
+  juce::int64 end_ = std::numeric_limits<juce::int64>::max();
+  juce::int64 position_ = 0;
+};
@@ -18,6 +18,7 @@
 
 #include <string>
 #include <unordered_map>  // Include the necessary header for HashTable
+#include <utility>
 
 #include "data_structures/src/AudioElement.h"
 #include "data_structures/src/FileExport.h"
@@ -37,9 +38,19 @@ FileOutputProcessor::FileOutputProcessor(
       fileExportRepository_(fileExportRepository),
       audioElementRepository_(audioElementRepository),
       mixPresentationRepository_(mixPresentationRepository),
-      mixPresentationLoudnessRepository_(mixPresentationLoudnessRepository) {}
+      mixPresentationLoudnessRepository_(mixPresentationLoudnessRepository),
+      substreamCacheDirectory_(
+          juce::File::getSpecialLocation(juce::File::tempDirectory)
+              .getChildFile("EclipsaSubstreamCache")
+              .getChildFile(juce::Uuid().toString())),
+      bounceStartMs_(0.0) {
+  setActive(performingRender_);
+}
 
-FileOutputProcessor::~FileOutputProcessor() {}
+FileOutputProcessor::~FileOutputProcessor() {
+  clearSubstreamCache();
+  substreamCacheDirectory_.deleteRecursively();
+}
 
 //==============================================================================
 const juce::String FileOutputProcessor::getName() const {
@@ -115,17 +126,33 @@ void FileOutputProcessor::updateIamfMDFromRepository(
   // audio_frame_metadata.
   int minAudioSubstreamForElement = 0;
   int firstAudioElementId = 500;
-  for (int i = 0; i < iamfWavFileWriters_.size(); ++i) {
+  auto addAudioElement = [&](const AudioElement& element,
+                             const std::string& filePath,
+                             const int framesWritten) {
     auto aeMDToPopulate = iamfMD.add_audio_element_metadata();
-    juce::Uuid elementID = iamfWavFileWriters_[i].get()->getElement().getId();
-    audioElementIDMap[elementID] = ++firstAudioElementId;
-    int aeID = audioElementIDMap[elementID];
-    iamfWavFileWriters_[i].get()->getElement().populateIamfAudioElementMetadata(
-        aeMDToPopulate, aeID, minAudioSubstreamForElement);
+    audioElementIDMap[element.getId()] = ++firstAudioElementId;
+    int aeID = audioElementIDMap[element.getId()];
+    element.populateIamfAudioElementMetadata(aeMDToPopulate, aeID,
+                                             minAudioSubstreamForElement);
     auto afMDToPopulate = iamfMD.add_audio_frame_metadata();
-    iamfWavFileWriters_[i].get()->getElement().populateIamfAudioFrameMetadata(
-        afMDToPopulate, aeID, iamfWavFileWriters_[i].get()->getFilePath(),
-        iamfWavFileWriters_[i].get()->getFramesWritten());
+    element.populateIamfAudioFrameMetadata(afMDToPopulate, aeID, filePath,
+                                           framesWritten);
+  };
+
+  // A re-export sources the audio frames from the substreams of the last
+  // bounce.
+  if (reexporting_) {
+    for (const CachedSubstream& substream : substreamCache_->substreams) {
+      addAudioElement(substream.element,
+                      substream.file.getFullPathName().toStdString(),
+                      substream.framesWritten);
+    }
+    return;
+  }
+
+  for (auto& writer : iamfWavFileWriters_) {
+    addAudioElement(writer->getElement(), writer->getFilePath(),
+                    writer->getFramesWritten());
   }
 }
 
@@ -165,6 +192,13 @@ void FileOutputProcessor::prepareToPlay(double sampleRate,
   numSamples_ = samplesPerBlock;
   sampleTally_ = 0;
   sampleRate_ = sampleRate;
+  exportRange_.rewind();
+}
+
+void FileOutputProcessor::skipBlock(int numSamples) {
+  if (performingRender_) {
+    exportRange_.advance(numSamples);
+  }
 }
 
 void FileOutputProcessor::setNonRealtime(bool isNonRealtime) noexcept {
@@ -185,7 +219,7 @@ void FileOutputProcessor::setNonRealtime(bool isNonRealtime) noexcept {
   // Stop rendering if we are switching back to online mode
   if (performingRender_) {
     closeFileExport(config);
-    performingRender_ = false;
+    setPerformingRender(false);
   }
 }
 
@@ -239,26 +273,142 @@ bool FileOutputProcessor::exportIamfFile(const juce::String input_wav_path,
   LOG_INFO(0, "Exporting IAMF File with Metadata");
   LOG_INFO(0, iamfMetadata.DebugString());
 
-  auto res = iamf_tools::TestMain(iamfMetadata, input_wav_path.toStdString(),
-                                  output_iamf_path.toStdString());
+  absl::Status res;
+  {
+    ExportProfile::ScopedTimer timer(exportProfile_.encodeWallSeconds,
+                                     &exportProfile_.encodeCpuSeconds);
+    res = iamf_tools::TestMain(iamfMetadata, input_wav_path.toStdString(),
+                               output_iamf_path.toStdString());
+  }
 
   dumpExportLogs(res);
 
   return res.ok();
 }
 
+bool FileOutputProcessor::reexportMetadata() {
+  const juce::ScopedLock lock(substreamCacheLock_);
+  FileExport config = fileExportRepository_.get();
+  if (performingRender_ || !isSubstreamCacheValid(config)) {
+    return false;
+  }
+
+  LOG_ANALYTICS(0, "Re-exporting .iamf file metadata from the last bounce");
+  // Describe the cached bounce rather than what is currently prepared
+  const int numSamples =
+      std::exchange(numSamples_, substreamCache_->samplesPerBlock);
+  const long sampleRate =
+      std::exchange(sampleRate_, substreamCache_->sampleRate);
+  const long sampleTally =
+      std::exchange(sampleTally_, substreamCache_->samplesWritten);
+  reexporting_ = true;
+
+  juce::File(config.getExportFile()).deleteFile();
+  const bool exportIAMFSuccess =
+      exportIamfFile(config.getExportFolder(), config.getExportFolder());
+
+  reexporting_ = false;
+  numSamples_ = numSamples;
+  sampleRate_ = sampleRate;
+  sampleTally_ = sampleTally;
+
+  if (exportIAMFSuccess && config.getExportVideo()) {
+    if (!IAMFExportHelper::muxIAMF(audioElementRepository_,
+                                   mixPresentationRepository_, config)) {
+      LOG_INFO(0, "IAMF Muxing: Failed to mux IAMF file with provided video.");
+    }
+  }
+  return exportIAMFSuccess;
+}
+
+bool FileOutputProcessor::canReexportMetadata() const {
+  const juce::ScopedLock lock(substreamCacheLock_);
+  return !performingRender_ &&
+         isSubstreamCacheValid(fileExportRepository_.get());
+}
+
+bool FileOutputProcessor::isSubstreamCacheValid(
+    const FileExport& config) const {
+  if (!substreamCache_ || substreamCache_->audioElementVersion !=
+                              audioElementRepository_.getVersion()) {
+    return false;
+  }
+
+  // Only the descriptors may differ, not what the substreams were bounced or
+  // encoded with
+  const FileExport& cached = substreamCache_->config;
+  if (config.getAudioFileFormat() != cached.getAudioFileFormat() ||
+      config.getAudioCodec() != cached.getAudioCodec() ||
+      config.getBitDepth() != cached.getBitDepth() ||
+      config.getSampleRate() != cached.getSampleRate() ||
+      config.getStartTime() != cached.getStartTime() ||
+      config.getEndTime() != cached.getEndTime() ||
+      config.getFlacCompressionLevel() != cached.getFlacCompressionLevel() ||
+      config.getOpusTotalBitrate() != cached.getOpusTotalBitrate() ||
+      config.getLPCMSampleSize() != cached.getLPCMSampleSize()) {
+    return false;
+  }
+
+  for (const CachedSubstream& substream : substreamCache_->substreams) {
+    if (!substream.file.existsAsFile()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void FileOutputProcessor::cacheSubstreams() {
+  if (!substreamCacheDirectory_.createDirectory()) {
+    LOG_INFO(0, "Substream cache: Failed to create " +
+                    substreamCacheDirectory_.getFullPathName().toStdString());
+    return;
+  }
+
+  SubstreamCache cache{{},
+                       bounceConfig_,
+                       bounceAudioElementVersion_,
+                       numSamples_,
+                       sampleRate_,
+                       sampleTally_};
+  for (auto& writer : iamfWavFileWriters_) {
+    const juce::File source(writer->getFilePath());
+    const juce::File cached =
+        substreamCacheDirectory_.getChildFile(source.getFileName());
+    if (!source.copyFileTo(cached)) {
+      LOG_INFO(0, "Substream cache: Failed to cache " + writer->getFilePath());
+      return;
+    }
+    cache.substreams.push_back(
+        {writer->getElement(), cached, writer->getFramesWritten()});
+  }
+  substreamCache_ = std::move(cache);
+}
+
+void FileOutputProcessor::clearSubstreamCache() {
+  if (substreamCache_) {
+    for (const CachedSubstream& substream : substreamCache_->substreams) {
+      substream.file.deleteFile();
+    }
+    substreamCache_.reset();
+  }
+}
+
 void FileOutputProcessor::processBlock(juce::AudioBuffer<float>& buffer,
                                        juce::MidiBuffer& midiMessages) {
   juce::ignoreUnused(midiMessages);
 
-  if (!(shouldBufferBeWritten(buffer))) {
-    // If we are not performing a render or the buffer is empty, do not write
+  const juce::Range<int> samples = getSamplesToWrite(buffer);
+  if (samples.isEmpty()) {
+    // If we are not performing a render or the buffer is outside the export
+    // range, do not write
     return;
   }
 
+  ExportProfile::ScopedTimer timer(exportProfile_.bounceProcessSeconds);
   for (auto& writer : iamfWavFileWriters_) {
-    writer->write(buffer);
+    writer->write(buffer, samples.getStart(), samples.getLength());
   }
+  exportProfile_.samplesWritten += samples.getLength();
 }
 
 //==============================================================================
@@ -270,9 +420,14 @@ juce::AudioProcessorEditor* FileOutputProcessor::createEditor() {
 
 void FileOutputProcessor::initializeFileExport(FileExport& config) {
   LOG_ANALYTICS(0, "Beginning .iamf file export");
-  performingRender_ = true;
-  startTime_ = config.getStartTime();
-  endTime_ = config.getEndTime();
+  // The audio may have changed since the last bounce
+  const juce::ScopedLock lock(substreamCacheLock_);
+  clearSubstreamCache();
+  bounceConfig_ = config;
+  bounceAudioElementVersion_ = audioElementRepository_.getVersion();
+  setPerformingRender(true);
+  exportRange_.reset(config.getSampleRate(), config.getStartTime(),
+                     config.getEndTime());
 
   // To create the IAMF file, create a list of all the audio element wav
   // files to be created
@@ -290,13 +445,21 @@ void FileOutputProcessor::initializeFileExport(FileExport& config) {
         config.getAudioCodec(), *audioElements[i]));
   }
   sampleTally_ = 0;
+
+  exportProfile_ = ExportProfile();
+  exportProfile_.sampleRate = config.getSampleRate();
+  bounceStartMs_ = juce::Time::getMillisecondCounterHiRes();
 }
 
 void FileOutputProcessor::closeFileExport(FileExport& config) {
   LOG_ANALYTICS(0, "closing writers and exporting IAMF file");
   // close the output file, since rendering is completed
+  exportProfile_.bounceWallSeconds =
+      (juce::Time::getMillisecondCounterHiRes() - bounceStartMs_) / 1000.0;
   for (auto& writer : iamfWavFileWriters_) {
     writer->close();
+    exportProfile_.elements.push_back(
+        {writer->getFilePath(), juce::File(writer->getFilePath()).getSize()});
   }
   juce::File outputFile = juce::File(config.getExportFile());
   outputFile.deleteFile();
@@ -307,6 +470,7 @@ void FileOutputProcessor::closeFileExport(FileExport& config) {
   // If muxing is enabled and audio export was successful, mux the audio and
   // video files.
   if (exportIAMFSuccess && fileExportRepository_.get().getExportVideo()) {
+    ExportProfile::ScopedTimer timer(exportProfile_.muxWallSeconds);
     bool muxIAMFSuccess = IAMFExportHelper::muxIAMF(
         audioElementRepository_, mixPresentationRepository_,
         fileExportRepository_.get());
@@ -316,6 +480,14 @@ void FileOutputProcessor::closeFileExport(FileExport& config) {
     }
   }
 
+  if (exportIAMFSuccess) {
+    writeExportProfile(config);
+    // Keep the substreams so metadata changes can be re-exported without
+    // bouncing the audio again
+    const juce::ScopedLock lock(substreamCacheLock_);
+    cacheSubstreams();
+  }
+
   if (!config.getExportAudioElements()) {
     // Delete the extraneuos audio element files
     for (auto& writer : iamfWavFileWriters_) {
@@ -326,28 +498,26 @@ void FileOutputProcessor::closeFileExport(FileExport& config) {
   iamfWavFileWriters_.clear();
 }
 
-bool FileOutputProcessor::shouldBufferBeWritten(
+void FileOutputProcessor::writeExportProfile(const FileExport& config) {
+  exportProfile_.outputBytes = juce::File(config.getExportFile()).getSize();
+  const juce::File profileFile =
+      ExportProfile::getProfileFile(config.getExportFile());
+  if (!exportProfile_.writeToFile(profileFile)) {
+    LOG_INFO(0, "Export profile: Failed to write " +
+                    profileFile.getFullPathName().toStdString());
+    return;
+  }
+  LOG_ANALYTICS(0, "IAMF export profile: " +
+                       exportProfile_.getSummary().toStdString());
+}
+
+juce::Range<int> FileOutputProcessor::getSamplesToWrite(
     const juce::AudioBuffer<float>& buffer) {
   if (!performingRender_ || buffer.getNumSamples() < 1) {
-    return false;
+    return {};
   }
 
-  // Calculate the current time with the existing number of samples that have
-  // been processed
-  long currentTime = sampleTally_ / sampleRate_;
-  // update the sample tally
-  sampleTally_ += buffer.getNumSamples();
-  // with the updated sample tally, calculate the next time
-  long nextTime = sampleTally_ / sampleRate_;
-
-  if (startTime_ != 0 || endTime_ != 0) {
-    // Handle the case where startTime and endTime are set, implying we
-    // are only bouncing a subset of the mix
-
-    // do not render
-    if (currentTime < startTime_ || nextTime > endTime_) {
-      return false;
-    }
-  }
-  return true;
-}
\ No newline at end of file
+  const juce::Range<int> samples = exportRange_.advance(buffer.getNumSamples());
+  sampleTally_ += samples.getLength();
+  return samples;
+}
\ No newline at end of file
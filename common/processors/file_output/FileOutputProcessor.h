@@ -28,10 +28,14 @@
 #include <juce_dsp/juce_dsp.h>
 
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include "../processor_base/ProcessorBase.h"
 #include "AudioElementFileWriter.h"
+#include "ExportRange.h"
 #include "data_repository/implementation/MixPresentationLoudnessRepository.h"
+#include "iamf_export_utils/ExportProfile.h"
 #include "iamftools/encoder_main_lib.h"
 #include "user_metadata.pb.h"
 
@@ -50,10 +54,16 @@ class FileOutputProcessor : public ProcessorBase {
   void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
   using AudioProcessor::processBlock;
 
+  BufferAccess getBufferAccess() const override {
+    return BufferAccess::kReadOnly;
+  }
+
   void setNonRealtime(bool isNonRealtime) noexcept override;
 
   void prepareToPlay(double sampleRate, int samplesPerBlock) override;
 
+  void skipBlock(int numSamples) override;
+
   //==============================================================================
   juce::AudioProcessorEditor* createEditor() override;
   bool hasEditor() const override;
@@ -91,6 +101,18 @@ class FileOutputProcessor : public ProcessorBase {
   void initIamfMetadata(iamf_tools_cli_proto::UserMetadata& iamfMD,
                         juce::String outputFilename) const;
 
+  // Timings and throughput of the last export.
+  const ExportProfile& getExportProfile() const { return exportProfile_; }
+
+  // Re-export the IAMF file from the substreams bounced by the last export,
+  // picking up changes to mix presentations, loudness and tags without
+  // bouncing the audio again. Fails if the audio elements or the encoding
+  // configuration have changed since that bounce, which then needs a new one.
+  bool reexportMetadata();
+
+  // True if reexportMetadata() can reuse the last bounce.
+  bool canReexportMetadata() const;
+
  protected:
   void dumpExportLogs(const absl::Status& status) const;
 
@@ -113,7 +135,44 @@ class FileOutputProcessor : public ProcessorBase {
 
   void closeFileExport(FileExport& config);
 
-  bool shouldBufferBeWritten(const juce::AudioBuffer<float>& buffer);
+  // Write the profile of the finished export next to the exported file.
+  void writeExportProfile(const FileExport& config);
+
+  // An audio element's bounced substream, as passed to the encoder.
+  struct CachedSubstream {
+    AudioElement element;
+    juce::File file;
+    int framesWritten;
+  };
+
+  // The substreams of the last successful export and what they were bounced
+  // with.
+  struct SubstreamCache {
+    std::vector<CachedSubstream> substreams;
+    FileExport config;
+    uint64_t audioElementVersion;
+    int samplesPerBlock;
+    long sampleRate;
+    long samplesWritten;
+  };
+
+  // Copy the substreams of a successful export into the cache.
+  void cacheSubstreams();
+
+  // Delete the cached substreams.
+  void clearSubstreamCache();
+
+  // True if the cache holds the audio the given configuration would bounce.
+  bool isSubstreamCacheValid(const FileExport& config) const;
+
+  // The samples of the buffer inside the export range, empty if none are.
+  juce::Range<int> getSamplesToWrite(const juce::AudioBuffer<float>& buffer);
+
+  // Only take part in the chain while rendering
+  void setPerformingRender(bool performingRender) {
+    performingRender_ = performingRender;
+    setActive(performingRender);
+  }
 
   bool performingRender_;  // True if we are rendering in offline mode
   FileExportRepository& fileExportRepository_;
@@ -121,11 +180,22 @@ class FileOutputProcessor : public ProcessorBase {
   MixPresentationRepository& mixPresentationRepository_;
   MixPresentationLoudnessRepository& mixPresentationLoudnessRepository_;
   std::vector<std::unique_ptr<AudioElementFileWriter>> iamfWavFileWriters_;
+  // Guards the substream cache, which is written when a render closes and
+  // read by re-exports from the message thread.
+  mutable juce::CriticalSection substreamCacheLock_;
+  std::optional<SubstreamCache> substreamCache_;
+  const juce::File substreamCacheDirectory_;
+  // What the current bounce was started with
+  FileExport bounceConfig_;
+  uint64_t bounceAudioElementVersion_ = 0;
+  // True while re-exporting, when the audio frames come from the cache
+  bool reexporting_ = false;
+  ExportProfile exportProfile_;
+  double bounceStartMs_;
   int numSamples_;
   long sampleRate_;
-  int startTime_;
-  int endTime_;
-  long sampleTally_;
+  ExportRange exportRange_;
+  long sampleTally_;  // Samples written inside the export range
   //==============================================================================
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FileOutputProcessor)
 };
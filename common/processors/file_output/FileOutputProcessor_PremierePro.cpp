@@ -63,7 +63,7 @@ void PremiereProFileOutputProcessor::setNonRealtime(
   FileExport config = fileExportRepository_.get();
 
   if (!config.getManualExport()) {
-    performingRender_ = false;
+    setPerformingRender(false);
     return;
   }
 
@@ -81,12 +81,15 @@ void PremiereProFileOutputProcessor::processBlock(
     juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) {
   juce::ignoreUnused(midiMessages);
 
-  if (!shouldBufferBeWritten(buffer)) {
+  const juce::Range<int> samples = getSamplesToWrite(buffer);
+  if (samples.isEmpty()) {
     return;
   }
 
   //  Write the audio data to the wav file writers
+  ExportProfile::ScopedTimer timer(exportProfile_.bounceProcessSeconds);
   for (auto& writer : iamfWavFileWriters_) {
-    writer->write(buffer);
+    writer->write(buffer, samples.getStart(), samples.getLength());
   }
+  exportProfile_.samplesWritten += samples.getLength();
 }
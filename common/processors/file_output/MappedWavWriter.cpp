@@ -0,0 +1,233 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "MappedWavWriter.h"
+
+#include <logger/logger.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+
+namespace {
+// Chunk sizes of the header, see EBU Tech 3306 for the RF64 layout. The ds64
+// chunk is reserved as a JUNK chunk and only filled in when the file
+// outgrows RIFF.
+constexpr juce::int64 kRiffHeaderBytes = 12;
+constexpr juce::int64 kChunkHeaderBytes = 8;
+constexpr juce::int64 kDs64Bytes = 28;
+constexpr juce::int64 kFmtBytes = 16;
+constexpr juce::int64 kFmtExtensibleBytes = 40;
+constexpr juce::int64 kMaxRiffBytes = 0xffffffffLL;
+constexpr int kWaveFormatPcm = 1;
+constexpr int kWaveFormatExtensible = 0xfffe;
+
+int chunkId(const char* id) {
+  return (int)juce::ByteOrder::littleEndianInt(id);
+}
+
+// Write one channel of scaled, clipped samples into interleaved PCM.
+template <int BytesPerSample>
+void writeInterleaved(const float* src, char* dest, const int numSamples,
+                      const int blockAlign) {
+  for (int i = 0; i < numSamples; ++i, dest += blockAlign) {
+    const auto value = static_cast<juce::int32>(std::lrint(src[i]));
+    for (int b = 0; b < BytesPerSample; ++b) {
+      dest[b] = static_cast<char>(value >> (8 * b));
+    }
+  }
+}
+}  // namespace
+
+MappedWavWriter::MappedWavWriter(const juce::String& filename,
+                                 double sampleRate, int numChannels,
+                                 int firstChannel, int bitDepth,
+                                 juce::int64 regionBytes)
+    : outputFile_(filename),
+      sampleRate_(sampleRate),
+      numChannels_(numChannels),
+      firstChannel_(firstChannel),
+      bitDepth_(bitDepth),
+      bytesPerSample_(bitDepth / 8),
+      blockAlign_(numChannels * (bitDepth / 8)),
+      extensible_(numChannels > 2 || bitDepth > 16),
+      regionBytes_(regionBytes),
+      framesWritten_(0),
+      closed_(false) {
+  jassert(bitDepth == 16 || bitDepth == 24 || bitDepth == 32);
+  headerBytes_ = kRiffHeaderBytes + kChunkHeaderBytes + kDs64Bytes +
+                 kChunkHeaderBytes +
+                 (extensible_ ? kFmtExtensibleBytes : kFmtBytes) +
+                 kChunkHeaderBytes;
+  writeOffset_ = headerBytes_;
+  outputFile_.deleteFile();
+  outputFile_.create();
+}
+
+MappedWavWriter::~MappedWavWriter() { close(); }
+
+void MappedWavWriter::write(const juce::AudioBuffer<float>& buffer,
+                            const int startSample, const int numSamples) {
+  if (closed_ || numSamples < 1) {
+    return;
+  }
+
+  const juce::int64 numBytes = (juce::int64)numSamples * blockAlign_;
+  if (region_ == nullptr ||
+      writeOffset_ + numBytes > region_->getRange().getEnd()) {
+    if (!mapRegion(numBytes)) {
+      return;
+    }
+  }
+  char* dest = static_cast<char*>(region_->getData()) +
+               (writeOffset_ - region_->getRange().getStart());
+
+  // Scale and clip with the vectorised helpers, then interleave.
+  const float maxValue = bitDepth_ == 32
+                             ? 2147483520.0f  // Largest float below 2^31
+                             : (float)((1 << (bitDepth_ - 1)) - 1);
+  const float minValue = -std::ldexp(1.0f, bitDepth_ - 1);
+  scratch_.resize(std::max<size_t>(scratch_.size(), numSamples));
+  const int numChannels =
+      std::min(numChannels_, buffer.getNumChannels() - firstChannel_);
+  for (int ch = 0; ch < numChannels; ++ch) {
+    juce::FloatVectorOperations::multiply(
+        scratch_.data(),
+        buffer.getReadPointer(firstChannel_ + ch, startSample), maxValue,
+        numSamples);
+    juce::FloatVectorOperations::clip(scratch_.data(), scratch_.data(),
+                                      minValue, maxValue, numSamples);
+    char* channelDest = dest + ch * bytesPerSample_;
+    switch (bytesPerSample_) {
+      case 2:
+        writeInterleaved<2>(scratch_.data(), channelDest, numSamples,
+                            blockAlign_);
+        break;
+      case 3:
+        writeInterleaved<3>(scratch_.data(), channelDest, numSamples,
+                            blockAlign_);
+        break;
+      default:
+        writeInterleaved<4>(scratch_.data(), channelDest, numSamples,
+                            blockAlign_);
+        break;
+    }
+  }
+  // Channels missing from the buffer are written as silence.
+  for (int ch = std::max(numChannels, 0); ch < numChannels_; ++ch) {
+    char* channelDest = dest + ch * bytesPerSample_;
+    for (int i = 0; i < numSamples; ++i, channelDest += blockAlign_) {
+      std::memset(channelDest, 0, bytesPerSample_);
+    }
+  }
+
+  writeOffset_ += numBytes;
+  framesWritten_ += numSamples;
+}
+
+void MappedWavWriter::close() {
+  if (closed_) {
+    return;
+  }
+  closed_ = true;
+  region_.reset();
+
+  // Trim the preallocated tail, keeping the pad byte of an odd sized chunk.
+  const juce::int64 dataBytes = writeOffset_ - headerBytes_;
+  if (!resizeFile(writeOffset_ + (dataBytes & 1)) || !writeHeader(dataBytes)) {
+    LOG_ERROR(0, "MappedWavWriter: Failed to finalize " + getFilePath());
+  }
+}
+
+bool MappedWavWriter::mapRegion(const juce::int64 minBytes) {
+  region_.reset();
+  const juce::int64 regionEnd =
+      writeOffset_ + std::max(regionBytes_, minBytes);
+  if (resizeFile(regionEnd)) {
+    region_ = std::make_unique<juce::MemoryMappedFile>(
+        outputFile_, juce::Range<juce::int64>(writeOffset_, regionEnd),
+        juce::MemoryMappedFile::readWrite);
+    if (region_->getData() != nullptr) {
+      return true;
+    }
+    region_.reset();
+  }
+
+  LOG_ERROR(0, "MappedWavWriter: Failed to map " + getFilePath() +
+                   ", discarding the remaining audio");
+  closed_ = true;
+  resizeFile(writeOffset_);
+  writeHeader(writeOffset_ - headerBytes_);
+  return false;
+}
+
+bool MappedWavWriter::resizeFile(const juce::int64 numBytes) const {
+  std::error_code error;
+  std::filesystem::resize_file(
+      std::filesystem::path(outputFile_.getFullPathName().toStdString()),
+      static_cast<std::uintmax_t>(numBytes), error);
+  return !error;
+}
+
+bool MappedWavWriter::writeHeader(const juce::int64 dataBytes) const {
+  const juce::int64 riffBytes =
+      headerBytes_ - kChunkHeaderBytes + dataBytes + (dataBytes & 1);
+  const bool isRf64 = riffBytes > kMaxRiffBytes;
+
+  juce::MemoryOutputStream header((size_t)headerBytes_);
+  header.writeInt(chunkId(isRf64 ? "RF64" : "RIFF"));
+  header.writeInt(isRf64 ? -1 : (int)(juce::uint32)riffBytes);
+  header.writeInt(chunkId("WAVE"));
+
+  // The ds64 chunk, or a JUNK chunk of the same size.
+  header.writeInt(chunkId(isRf64 ? "ds64" : "JUNK"));
+  header.writeInt((int)kDs64Bytes);
+  header.writeInt64(isRf64 ? riffBytes : 0);
+  header.writeInt64(isRf64 ? dataBytes : 0);
+  header.writeInt64(isRf64 ? framesWritten_ : 0);
+  header.writeInt(0);  // No table entries
+
+  header.writeInt(chunkId("fmt "));
+  header.writeInt((int)(extensible_ ? kFmtExtensibleBytes : kFmtBytes));
+  header.writeShort(
+      (short)(extensible_ ? kWaveFormatExtensible : kWaveFormatPcm));
+  header.writeShort((short)numChannels_);
+  header.writeInt((int)sampleRate_);
+  header.writeInt((int)sampleRate_ * blockAlign_);
+  header.writeShort((short)blockAlign_);
+  header.writeShort((short)bitDepth_);
+  if (extensible_) {
+    header.writeShort(22);  // Size of the extension
+    header.writeShort((short)bitDepth_);
+    header.writeInt(0);  // Channels are not assigned to speaker positions
+    // KSDATAFORMAT_SUBTYPE_PCM
+    const juce::uint8 subFormat[] = {0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
+                                     0x10, 0x00, 0x80, 0x00, 0x00, 0xaa,
+                                     0x00, 0x38, 0x9b, 0x71};
+    header.write(subFormat, sizeof(subFormat));
+  }
+
+  header.writeInt(chunkId("data"));
+  header.writeInt(isRf64 ? -1 : (int)(juce::uint32)dataBytes);
+  jassert((juce::int64)header.getDataSize() == headerBytes_);
+
+  juce::FileOutputStream stream(outputFile_);
+  if (stream.failedToOpen() || !stream.setPosition(0)) {
+    return false;
+  }
+  stream.write(header.getData(), header.getDataSize());
+  stream.flush();
+  return stream.getStatus().wasOk();
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <juce_audio_processors/juce_audio_processors.h>
+
+#include <memory>
+#include <vector>
+
+// Writes the intermediate audio element files handed to the IAMF encoder.
+// Samples are converted to PCM straight into a memory-mapped, preallocated
+// region of the file rather than through a stream, and the header is written
+// on close. Files that outgrow the 4 GB RIFF limit are finalized as RF64, so
+// multi-hour, high channel count bounces do not fail.
+class MappedWavWriter {
+ public:
+  MappedWavWriter(const juce::String& filename, double sampleRate,
+                  int numChannels, int firstChannel, int bitDepth,
+                  juce::int64 regionBytes = kDefaultRegionBytes);
+
+  ~MappedWavWriter();
+
+  MappedWavWriter(const MappedWavWriter&) = delete;
+  MappedWavWriter& operator=(const MappedWavWriter&) = delete;
+
+  // Write numChannels channels of the buffer, starting at firstChannel.
+  void write(const juce::AudioBuffer<float>& buffer) {
+    write(buffer, 0, buffer.getNumSamples());
+  }
+
+  // Write numSamples samples of the buffer, starting at startSample.
+  void write(const juce::AudioBuffer<float>& buffer, int startSample,
+             int numSamples);
+
+  // Finalize the header and trim the preallocated tail of the file.
+  void close();
+
+  std::string getFilePath() const {
+    return outputFile_.getFullPathName().toStdString();
+  }
+
+  int getFramesWritten() const { return static_cast<int>(framesWritten_); }
+
+  // Size of each mapped region the file is grown by.
+  inline static const juce::int64 kDefaultRegionBytes = 64LL * 1024 * 1024;
+
+ private:
+  bool mapRegion(juce::int64 minBytes);
+
+  bool resizeFile(juce::int64 numBytes) const;
+
+  bool writeHeader(juce::int64 dataBytes) const;
+
+  juce::File outputFile_;
+  double sampleRate_;
+  int numChannels_;
+  int firstChannel_;
+  int bitDepth_;
+  int bytesPerSample_;
+  int blockAlign_;
+  bool extensible_;
+  juce::int64 headerBytes_;
+  juce::int64 regionBytes_;
+  juce::int64 writeOffset_;
+  juce::int64 framesWritten_;
+  bool closed_;
+  std::unique_ptr<juce::MemoryMappedFile> region_;
+  std::vector<float> scratch_;
+};
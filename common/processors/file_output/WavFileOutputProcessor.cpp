@@ -29,10 +29,13 @@ WavFileOutputProcessor::WavFileOutputProcessor(
       sampleRate_(0),
       performingRender_(false),
       fileWriter_(nullptr) {
-  fileExportRepository_.registerListener(this);
+  setActive(performingRender_);
+  fileExportRepository_.registerTransactionListener(this);
 }
 
-WavFileOutputProcessor::~WavFileOutputProcessor() {}
+WavFileOutputProcessor::~WavFileOutputProcessor() {
+  fileExportRepository_.deregisterTransactionListener(this);
+}
 
 //==============================================================================
 void WavFileOutputProcessor::prepareToPlay(double sampleRate,
@@ -85,7 +88,7 @@ void WavFileOutputProcessor::setNonRealtime(bool isNonRealtime) noexcept {
           configParams.getExportFile(), configParams.getSampleRate(),
           roomSetup.getSpeakerLayout().getRoomSpeakerLayout().getNumChannels(),
           0, configParams.getBitDepth(), configParams.getAudioCodec());
-      performingRender_ = true;
+      setPerformingRender(true);
     }
   } else {
     // Complete Rendering
@@ -94,7 +97,7 @@ void WavFileOutputProcessor::setNonRealtime(bool isNonRealtime) noexcept {
       delete fileWriter_;
       fileWriter_ = nullptr;
     }
-    performingRender_ = false;
+    setPerformingRender(false);
   }
   lock_.exit();
 }
@@ -122,4 +125,8 @@ void WavFileOutputProcessor::valueTreeChildRemoved(
     juce::ValueTree& parentTree, juce::ValueTree& childWhichHasBeenRemoved,
     int indexFromWhichChildWasRemoved) {
   checkManualExportStartStop();
+}
+void WavFileOutputProcessor::repositoryTransactionCommitted(
+    juce::ValueTree& state) {
+  checkManualExportStartStop();
 }
\ No newline at end of file
@@ -31,7 +31,7 @@
 
 //==============================================================================
 class WavFileOutputProcessor final : public ProcessorBase,
-                                     public juce::ValueTree::Listener {
+                                     public RepositoryTransactionListener {
  public:
   //==============================================================================
   WavFileOutputProcessor(FileExportRepository& fileExportRepository,
@@ -43,6 +43,10 @@ class WavFileOutputProcessor final : public ProcessorBase,
   void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
   using AudioProcessor::processBlock;
 
+  BufferAccess getBufferAccess() const override {
+    return BufferAccess::kReadOnly;
+  }
+
   void setNonRealtime(bool isNonRealtime) noexcept override;
 
   //==============================================================================
@@ -55,11 +59,18 @@ class WavFileOutputProcessor final : public ProcessorBase,
   void valueTreeChildRemoved(juce::ValueTree& parentTree,
                              juce::ValueTree& childWhichHasBeenRemoved,
                              int indexFromWhichChildWasRemoved) override;
+  void repositoryTransactionCommitted(juce::ValueTree& state) override;
 
   //==============================================================================
   const juce::String getName() { return "WaveFileOutput"; }
 
  private:
+  // Only take part in the chain while rendering
+  void setPerformingRender(bool performingRender) {
+    performingRender_ = performingRender;
+    setActive(performingRender);
+  }
+
   bool performingRender_;  // True if we are rendering in offline mode
   FileExportRepository& fileExportRepository_;
   RoomSetupRepository& roomSetupRepository_;
@@ -0,0 +1,159 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ExportProfile.h"
+
+#if JUCE_WINDOWS
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+namespace {
+const juce::Identifier kSampleRate("sample_rate");
+const juce::Identifier kSamplesWritten("samples_written");
+const juce::Identifier kAudioSeconds("audio_seconds");
+const juce::Identifier kSamplesPerSecond("samples_per_second");
+const juce::Identifier kRealtimeFactor("realtime_factor");
+const juce::Identifier kBounceWallSeconds("bounce_wall_seconds");
+const juce::Identifier kBounceProcessSeconds("bounce_process_seconds");
+const juce::Identifier kEncodeWallSeconds("encode_wall_seconds");
+const juce::Identifier kEncodeCpuSeconds("encode_cpu_seconds");
+const juce::Identifier kMuxWallSeconds("mux_wall_seconds");
+const juce::Identifier kOutputBytes("output_bytes");
+const juce::Identifier kElements("elements");
+const juce::Identifier kFile("file");
+const juce::Identifier kBytes("bytes");
+}  // namespace
+
+double ExportProfile::ScopedTimer::getThreadCpuSeconds() {
+#if JUCE_WINDOWS
+  FILETIME creation, exit, kernel, user;
+  if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) {
+    return 0.0;
+  }
+  // Kernel and user time, in 100 ns ticks
+  const auto ticks = [](const FILETIME& time) {
+    return static_cast<double>((static_cast<juce::uint64>(time.dwHighDateTime)
+                                << 32) |
+                               time.dwLowDateTime);
+  };
+  return (ticks(kernel) + ticks(user)) * 1e-7;
+#else
+  timespec time{};
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0) {
+    return 0.0;
+  }
+  return static_cast<double>(time.tv_sec) + time.tv_nsec * 1e-9;
+#endif
+}
+
+double ExportProfile::getAudioSeconds() const {
+  return sampleRate > 0.0 ? samplesWritten / sampleRate : 0.0;
+}
+
+double ExportProfile::getSamplesPerSecond() const {
+  return bounceWallSeconds > 0.0 ? samplesWritten / bounceWallSeconds : 0.0;
+}
+
+double ExportProfile::getTotalWallSeconds() const {
+  return bounceWallSeconds + encodeWallSeconds + muxWallSeconds;
+}
+
+double ExportProfile::getRealtimeFactor() const {
+  const double total = getTotalWallSeconds();
+  return total > 0.0 ? getAudioSeconds() / total : 0.0;
+}
+
+juce::String ExportProfile::getSummary() const {
+  juce::String summary =
+      "Last export: " + juce::String(getAudioSeconds(), 1) + " s of audio in " +
+      juce::String(getTotalWallSeconds(), 1) + " s (" +
+      juce::String(getRealtimeFactor(), 1) + "x realtime). Bounce " +
+      juce::String(bounceWallSeconds, 1) + " s, encode " +
+      juce::String(encodeWallSeconds, 1) + " s";
+  if (muxWallSeconds > 0.0) {
+    summary += ", mux " + juce::String(muxWallSeconds, 1) + " s";
+  }
+  return summary + ".";
+}
+
+juce::var ExportProfile::toVar() const {
+  juce::Array<juce::var> elementsVar;
+  for (const ElementBytes& element : elements) {
+    juce::DynamicObject::Ptr elementObj = new juce::DynamicObject();
+    elementObj->setProperty(kFile, element.file);
+    elementObj->setProperty(kBytes, element.bytes);
+    elementsVar.add(elementObj.get());
+  }
+
+  juce::DynamicObject::Ptr obj = new juce::DynamicObject();
+  obj->setProperty(kSampleRate, sampleRate);
+  obj->setProperty(kSamplesWritten, (juce::int64)samplesWritten);
+  obj->setProperty(kAudioSeconds, getAudioSeconds());
+  obj->setProperty(kSamplesPerSecond, getSamplesPerSecond());
+  obj->setProperty(kRealtimeFactor, getRealtimeFactor());
+  obj->setProperty(kBounceWallSeconds, bounceWallSeconds);
+  obj->setProperty(kBounceProcessSeconds, bounceProcessSeconds);
+  obj->setProperty(kEncodeWallSeconds, encodeWallSeconds);
+  obj->setProperty(kEncodeCpuSeconds, encodeCpuSeconds);
+  obj->setProperty(kMuxWallSeconds, muxWallSeconds);
+  obj->setProperty(kOutputBytes, outputBytes);
+  obj->setProperty(kElements, elementsVar);
+  return obj.get();
+}
+
+std::optional<ExportProfile> ExportProfile::fromVar(const juce::var& var) {
+  if (!var.isObject()) {
+    return std::nullopt;
+  }
+  ExportProfile profile;
+  profile.sampleRate = var[kSampleRate];
+  profile.samplesWritten = (juce::int64)var[kSamplesWritten];
+  profile.bounceWallSeconds = var[kBounceWallSeconds];
+  profile.bounceProcessSeconds = var[kBounceProcessSeconds];
+  profile.encodeWallSeconds = var[kEncodeWallSeconds];
+  profile.encodeCpuSeconds = var[kEncodeCpuSeconds];
+  profile.muxWallSeconds = var[kMuxWallSeconds];
+  profile.outputBytes = var[kOutputBytes];
+  if (const juce::Array<juce::var>* elementsVar =
+          var[kElements].getArray()) {
+    for (const juce::var& element : *elementsVar) {
+      profile.elements.push_back(
+          {element[kFile].toString(), (juce::int64)element[kBytes]});
+    }
+  }
+  return profile;
+}
+
+bool ExportProfile::writeToFile(const juce::File& file) const {
+  return file.replaceWithText(juce::JSON::toString(toVar()));
+}
+
+std::optional<ExportProfile> ExportProfile::readFromFile(
+    const juce::File& file) {
+  if (!file.existsAsFile()) {
+    return std::nullopt;
+  }
+  return fromVar(juce::JSON::parse(file));
+}
+
+juce::File ExportProfile::getProfileFile(const juce::String& exportFile) {
+  if (exportFile.isEmpty()) {
+    return {};
+  }
+  const juce::File file(exportFile);
+  return file.getSiblingFile(file.getFileNameWithoutExtension() +
+                             "_export_profile.json");
+}
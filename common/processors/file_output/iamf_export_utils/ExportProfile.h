@@ -0,0 +1,95 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <juce_core/juce_core.h>
+
+#include <optional>
+#include <vector>
+
+// Per-stage timings and throughput of a single IAMF export. Written as JSON
+// next to the exported file so slow exports can be attributed to the bounce,
+// the encoder or the muxer.
+struct ExportProfile {
+  // Size of an intermediate audio element file handed to the encoder.
+  struct ElementBytes {
+    juce::String file;
+    juce::int64 bytes;
+  };
+
+  // Accumulates wall time and, optionally, the CPU time of the calling thread
+  // into the given totals for the lifetime of the timer. Only the calling
+  // thread is counted, as the audio and message threads keep running
+  // alongside it.
+  class ScopedTimer {
+   public:
+    ScopedTimer(double& wallSeconds, double* cpuSeconds = nullptr)
+        : wallSeconds_(wallSeconds),
+          cpuSeconds_(cpuSeconds),
+          wallStartMs_(juce::Time::getMillisecondCounterHiRes()),
+          cpuStart_(cpuSeconds != nullptr ? getThreadCpuSeconds() : 0.0) {}
+
+    ~ScopedTimer() {
+      wallSeconds_ +=
+          (juce::Time::getMillisecondCounterHiRes() - wallStartMs_) / 1000.0;
+      if (cpuSeconds_ != nullptr) {
+        *cpuSeconds_ += getThreadCpuSeconds() - cpuStart_;
+      }
+    }
+
+    // CPU time used by the calling thread so far.
+    static double getThreadCpuSeconds();
+
+   private:
+    double& wallSeconds_;
+    double* cpuSeconds_;
+    double wallStartMs_;
+    double cpuStart_;
+  };
+
+  // Seconds of audio exported.
+  double getAudioSeconds() const;
+  // Samples bounced per second of wall time.
+  double getSamplesPerSecond() const;
+  // Exported audio duration relative to the time taken by the whole export.
+  double getRealtimeFactor() const;
+  double getTotalWallSeconds() const;
+
+  // One line summary for display.
+  juce::String getSummary() const;
+
+  juce::var toVar() const;
+  static std::optional<ExportProfile> fromVar(const juce::var& var);
+
+  bool writeToFile(const juce::File& file) const;
+  static std::optional<ExportProfile> readFromFile(const juce::File& file);
+
+  // The profile written alongside the given export file.
+  static juce::File getProfileFile(const juce::String& exportFile);
+
+  double sampleRate = 0.0;
+  long samplesWritten = 0;
+  // Wall time from the start of the bounce until the last block was written.
+  double bounceWallSeconds = 0.0;
+  // Time spent writing the bounced blocks on the audio thread.
+  double bounceProcessSeconds = 0.0;
+  double encodeWallSeconds = 0.0;
+  // CPU time of the thread running the encoder.
+  double encodeCpuSeconds = 0.0;
+  double muxWallSeconds = 0.0;
+  juce::int64 outputBytes = 0;
+  std::vector<ElementBytes> elements;
+};
@@ -0,0 +1,107 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ChannelGainStage.h"
+
+ChannelGainStage::ChannelGainStage(const int numChannels,
+                                   const double rampDurationSeconds)
+    : rampDurationSeconds_(rampDurationSeconds), channels_(numChannels) {}
+
+void ChannelGainStage::prepare(const double sampleRate,
+                               const int maximumBlockSize) {
+  rampLength_ = juce::roundToInt(sampleRate * rampDurationSeconds_);
+
+  const int chunkSize = std::max(1, std::min(rampLength_, maximumBlockSize));
+  rampSteps_.resize(chunkSize);
+  rampGains_.resize(chunkSize);
+  for (int i = 0; i < chunkSize; ++i) {
+    rampSteps_[i] = static_cast<float>(i + 1);
+  }
+  reset();
+}
+
+void ChannelGainStage::setTargetGain(const int channel, const float gain) {
+  jassert(channel >= 0 && channel < getNumChannels());
+  Channel& state = channels_[channel];
+  if (gain == state.target) {
+    return;
+  }
+
+  state.target = gain;
+  if (rampLength_ == 0) {
+    state.current = gain;
+    state.rampRemaining = 0;
+    return;
+  }
+  // A ramp in progress is restarted from the gain it has reached
+  state.step = (gain - state.current) / static_cast<float>(rampLength_);
+  state.rampRemaining = rampLength_;
+}
+
+void ChannelGainStage::reset() {
+  for (Channel& state : channels_) {
+    state.current = state.target;
+    state.rampRemaining = 0;
+  }
+}
+
+void ChannelGainStage::process(juce::AudioBuffer<float>& buffer) {
+  const int numChannels = std::min(buffer.getNumChannels(), getNumChannels());
+  const int numSamples = buffer.getNumSamples();
+  float* const* channelData = buffer.getArrayOfWritePointers();
+
+  for (int ch = 0; ch < numChannels; ++ch) {
+    Channel& state = channels_[ch];
+    int rampSamples = 0;
+    if (state.rampRemaining > 0) {
+      rampSamples = std::min(state.rampRemaining, numSamples);
+      applyRamp(channelData[ch], state, rampSamples);
+    }
+    applyGain(channelData[ch] + rampSamples, state.current,
+              numSamples - rampSamples);
+  }
+}
+
+void ChannelGainStage::applyRamp(float* data, Channel& state,
+                                 const int numSamples) {
+  const int chunkSize = static_cast<int>(rampSteps_.size());
+  for (int start = 0; start < numSamples; start += chunkSize) {
+    const int num = std::min(chunkSize, numSamples - start);
+    // The gain at sample i of the chunk is current + step * (i + 1)
+    juce::FloatVectorOperations::copyWithMultiply(
+        rampGains_.data(), rampSteps_.data(), state.step, num);
+    juce::FloatVectorOperations::add(rampGains_.data(), state.current, num);
+    juce::FloatVectorOperations::multiply(data + start, rampGains_.data(),
+                                          num);
+    state.current += state.step * static_cast<float>(num);
+  }
+
+  state.rampRemaining -= numSamples;
+  if (state.rampRemaining == 0) {
+    // Land exactly on the target, so the channel can take a fast path
+    state.current = state.target;
+  }
+}
+
+void ChannelGainStage::applyGain(float* data, const float gain,
+                                 const int numSamples) {
+  if (numSamples <= 0 || gain == 1.f) {
+    return;
+  }
+  if (gain == 0.f) {
+    juce::FloatVectorOperations::clear(data, numSamples);
+  } else {
+    juce::FloatVectorOperations::multiply(data, gain, numSamples);
+  }
+}
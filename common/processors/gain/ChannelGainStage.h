@@ -0,0 +1,72 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+
+#include <vector>
+
+//==============================================================================
+// Applies a gain to each channel of a buffer in a single pass over the
+// channel. A change of gain ramps linearly to the new gain. Settled channels
+// take a fast path: at unity they are left untouched, at zero cleared, and
+// otherwise scaled. Ramps are built and applied with vector operations, a
+// chunk of at most one block at a time.
+class ChannelGainStage final {
+ public:
+  static constexpr double kDefaultRampSeconds = 0.01;
+
+  ChannelGainStage(int numChannels,
+                   double rampDurationSeconds = kDefaultRampSeconds);
+
+  // Sizes the ramps for the sample rate and ends any ramp in progress. Until
+  // prepared, gain changes apply immediately.
+  void prepare(double sampleRate, int maximumBlockSize);
+
+  // Ramps the channel to the gain, starting with the next sample processed.
+  void setTargetGain(int channel, float gain);
+  // Jumps every channel to its target gain.
+  void reset();
+
+  void process(juce::AudioBuffer<float>& buffer);
+
+  int getNumChannels() const { return static_cast<int>(channels_.size()); }
+  float getCurrentGain(int channel) const {
+    return channels_[channel].current;
+  }
+  bool isRamping(int channel) const {
+    return channels_[channel].rampRemaining > 0;
+  }
+
+ private:
+  struct Channel {
+    float current = 1.f;
+    float target = 1.f;
+    float step = 0.f;
+    int rampRemaining = 0;
+  };
+
+  void applyRamp(float* data, Channel& channel, int numSamples);
+  static void applyGain(float* data, float gain, int numSamples);
+
+  const double rampDurationSeconds_;
+  int rampLength_ = 0;
+  std::vector<Channel> channels_;
+  // 1, 2, 3, ... scaled by a ramp's step to build a chunk of its gains
+  std::vector<float> rampSteps_;
+  std::vector<float> rampGains_;
+};
@@ -27,7 +27,7 @@ GainProcessor::GainProcessor(MultiChannelRepository* gainRepository)
       // when connecting to UI gain(dynamic_cast<juce::AudioParameterFloat
       // *>(parameters.getParameter("gain"))),
       gains_(InitializeGainParameters()),
-      channelGainsDSP_(InitializeChannelGainsDSPs()) {
+      gainStage_(numChannels) {
   channelGains_->registerListener(this);
 }
 
@@ -39,12 +39,12 @@ const juce::String GainProcessor::getName() const { return {"Gain"}; }
 //==============================================================================
 void GainProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
   updateGains();
-  m_samplesPerBlock_ = samplesPerBlock;
-  for (auto i = 0; i < channelGainsDSP_.size(); ++i) {
-    channelGainsDSP_[i].prepare(
-        {sampleRate, static_cast<uint32_t>(samplesPerBlock),
-         static_cast<uint32_t>(channelGainsDSP_.size())});
+  gainStage_.prepare(sampleRate, samplesPerBlock);
+  // Start from the current gains rather than ramping to them
+  for (int i = 0; i < gains_.size(); ++i) {
+    gainStage_.setTargetGain(i, gains_[i]->get());
   }
+  gainStage_.reset();
 }
 
 void GainProcessor::processBlock(juce::AudioBuffer<float>& buffer,
@@ -53,20 +53,13 @@ void GainProcessor::processBlock(juce::AudioBuffer<float>& buffer,
 
   juce::ScopedNoDenormals noDenormals;
 
-  for (int i = 0; i < channelGainsDSP_.size(); i++) {
-    setGain(i, gains_[i]->get());
+  for (int i = 0; i < gains_.size(); i++) {
+    gainStage_.setTargetGain(i, gains_[i]->get());
   }
 
-  for (int i = 0; i < buffer.getNumChannels(); i++) {
-    juce::dsp::AudioBlock<float> block(&buffer.getArrayOfWritePointers()[i], 1,
-                                       m_samplesPerBlock_);
-    juce::dsp::ProcessContextReplacing<float> processContext(block);
-    channelGainsDSP_[i].process(processContext);
-  }
-}
-
-void GainProcessor::setGain(const int& channel, const float& gainValue) {
-  channelGainsDSP_[channel].setGainLinear(gainValue);
+  // The processing buffer may be wider than the host bus, the stage leaves
+  // channels past the gains untouched
+  gainStage_.process(buffer);
 }
 
 void GainProcessor::ResetGains() {
@@ -80,16 +73,6 @@ bool GainProcessor::hasEditor() const {
   return false;  // (change this to false if you choose to not supply an editor)
 }
 
-std::vector<juce::dsp::Gain<float>>
-GainProcessor::InitializeChannelGainsDSPs() {
-  std::vector<juce::dsp::Gain<float>> channelGainsDSPs(gains_.size());
-
-  for (auto i = 0; i < gains_.size(); ++i) {
-    channelGainsDSPs[i].setGainLinear(gains_[i]->get());
-  }
-  return channelGainsDSPs;
-}
-
 // This should only be called once
 std::vector<std::shared_ptr<juce::AudioParameterFloat>>
 GainProcessor::InitializeGainParameters() {
@@ -29,6 +29,7 @@
 
 #include "../../data_repository/implementation/MultiChannelGainRepository.h"
 #include "../processor_base/ProcessorBase.h"
+#include "ChannelGainStage.h"
 
 //==============================================================================
 class GainProcessor final : public ProcessorBase,
@@ -75,10 +76,8 @@ class GainProcessor final : public ProcessorBase,
 
   void updateAllAudioParameterFloats();
 
-  void updateGains() {
-    updateAllAudioParameterFloats();
-    channelGainsDSP_ = InitializeChannelGainsDSPs();
-  }
+  // The gain stage picks up the new gains on the next block
+  void updateGains() { updateAllAudioParameterFloats(); }
 
   std::unordered_map<int, float> getMutedChannelsfromRepo() {
     return channelGains_->get().getMutedChannels();
@@ -88,13 +87,9 @@ class GainProcessor final : public ProcessorBase,
   const int numChannels;
 
  private:
-  std::vector<juce::dsp::Gain<float>> InitializeChannelGainsDSPs();
-
   //==============================================================================
   MultiChannelRepository* channelGains_;
 
-  void setGain(const int& channel, const float& gainValue);
-
   juce::AudioParameterFloatAttributes initParameterAttributes(
       int decimalPlaces, juce::String&& label) const {
     return juce::AudioParameterFloatAttributes()
@@ -124,11 +119,10 @@ class GainProcessor final : public ProcessorBase,
   juce::AudioParameterFloat* gain_;
   std::vector<std::shared_ptr<juce::AudioParameterFloat>> gains_;
 
-  std::vector<juce::dsp::Gain<float>> channelGainsDSP_;
+  // Applies every channel's gain in one pass over the channel
+  ChannelGainStage gainStage_;
   juce::dsp::Gain<float> gainDSP_;
 
-  int m_samplesPerBlock_;
-
   //==============================================================================
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GainProcessor)
 };
@@ -45,6 +45,10 @@ void MSProcessor::valueTreeRedirected(juce::ValueTree& tree) {
   soloedChs_ = muteSoloState.getSoloedChannels();
 }
 
+void MSProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
+  gainStage_.prepare(sampleRate, samplesPerBlock);
+}
+
 void MSProcessor::processBlock(juce::AudioBuffer<float>& buffer,
                                juce::MidiBuffer& midiMessages) {
   // Determine gains for muted / soloed channels.
@@ -55,12 +59,10 @@ void MSProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     chGains &= soloedChs_;  // Disable all channels except soloed(s).
   }
 
-  // Compute a safe number of channels to iterate through. In practice this
-  // should always be the size of channel gains
-  int channelCount = std::min((int)chGains.size(), buffer.getNumChannels());
-
-  // Perform channel muting.
-  for (int i = 0; i < channelCount; ++i) {
-    buffer.applyGain(i, 0, buffer.getNumSamples(), chGains[i]);
+  // Perform channel muting. The stage covers as many channels as chGains and
+  // skips channels left on.
+  for (int i = 0; i < static_cast<int>(chGains.size()); ++i) {
+    gainStage_.setTargetGain(i, chGains[i] ? 1.f : 0.f);
   }
+  gainStage_.process(buffer);
 }
\ No newline at end of file
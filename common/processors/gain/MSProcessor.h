@@ -19,6 +19,7 @@
 #include <data_structures/src/SpeakerMonitorData.h>
 #include <processors/processor_base/ProcessorBase.h>
 
+#include "ChannelGainStage.h"
 #include "data_repository/implementation/MSPlaybackRepository.h"
 
 class MSProcessor : public ProcessorBase, public juce::ValueTree::Listener {
@@ -33,6 +34,7 @@ class MSProcessor : public ProcessorBase, public juce::ValueTree::Listener {
   // Update local Solo / Mute state on value change.
   void valueTreeRedirected(juce::ValueTree& tree) override;
 
+  void prepareToPlay(double sampleRate, int samplesPerBlock) override;
   void processBlock(juce::AudioBuffer<float>& buffer,
                     juce::MidiBuffer& midiMessages) override;
 
@@ -40,4 +42,6 @@ class MSProcessor : public ProcessorBase, public juce::ValueTree::Listener {
   MSPlaybackRepository& msPlaybackRepository_;
   std::bitset<PlaybackMS::kMaxNumPlaybackCh> soloedChs_;
   std::bitset<PlaybackMS::kMaxNumPlaybackCh> mutedChs_;
+  // Fades channels in and out as they are muted and soloed
+  ChannelGainStage gainStage_{PlaybackMS::kMaxNumPlaybackCh};
 };
\ No newline at end of file
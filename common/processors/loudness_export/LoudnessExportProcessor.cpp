@@ -27,13 +27,14 @@ LoudnessExportProcessor::LoudnessExportProcessor(
       mixPresentationRepository_(mixPresentationRepo),
       loudnessRepo_(loudnessRepo),
       audioElementRepository_(audioElementRepo),
-      currentSamplesPerBlock_(1),
-      sampleTally_(0) {
-  mixPresentationRepository_.registerListener(this);
+      sampleRate_(0),
+      currentSamplesPerBlock_(1) {
+  setActive(performingRender_);
+  mixPresentationRepository_.registerTransactionListener(this);
 }
 
 LoudnessExportProcessor::~LoudnessExportProcessor() {
-  mixPresentationRepository_.deregisterListener(this);
+  mixPresentationRepository_.deregisterTransactionListener(this);
 }
 
 void LoudnessExportProcessor::setNonRealtime(bool isNonRealtime) noexcept {
@@ -57,7 +58,7 @@ void LoudnessExportProcessor::setNonRealtime(bool isNonRealtime) noexcept {
     for (auto& exportContainer : exportContainers_) {
       copyExportContainerDataToRepo(exportContainer);
     }
-    performingRender_ = false;
+    setPerformingRender(false);
     LOG_INFO(0, "Copied loudness metadata to repository \n");
   }
 }
@@ -66,19 +67,18 @@ void LoudnessExportProcessor::prepareToPlay(double sampleRate,
                                             int samplesPerBlock) {
   sampleRate_ = sampleRate;
   currentSamplesPerBlock_ = samplesPerBlock;
-  sampleTally_ = 0;
+  exportRange_.rewind();
   intializeExportContainers();
 }
 
 void LoudnessExportProcessor::processBlock(juce::AudioBuffer<float>& buffer,
                                            juce::MidiBuffer& midiMessages) {
-  // kick out of process block if there is no nothing to render
-  if (!areLoudnessCalcsRequired(buffer)) {
-    return;
-  }
+  measureExportRange(buffer);
+}
 
-  for (auto& exportContainer : exportContainers_) {
-    exportContainer.process(buffer);
+void LoudnessExportProcessor::skipBlock(int numSamples) {
+  if (performingRender_) {
+    exportRange_.advance(numSamples);
   }
 }
 
@@ -155,6 +155,45 @@ void LoudnessExportProcessor::valueTreeChildRemoved(
   }
 }
 
+void LoudnessExportProcessor::repositoryTransactionCommitted(
+    juce::ValueTree& state) {
+  juce::ignoreUnused(state);
+
+  // Remove the loudness of mix presentations that no longer exist
+  juce::OwnedArray<MixPresentationLoudness> loudnesses;
+  loudnessRepo_.getAll(loudnesses);
+  for (const MixPresentationLoudness* loudness : loudnesses) {
+    if (!mixPresentationRepository_.get(loudness->getId()).has_value()) {
+      loudnessRepo_.remove(*loudness);
+    }
+  }
+
+  // Add the mix presentations that are new and update their largest layouts
+  for (auto mixPresentationTree : mixPresentationRepository_.getValueTree()) {
+    const juce::Uuid mixPresID =
+        juce::Uuid(mixPresentationTree[MixPresentation::kId]);
+    juce::ValueTree audioElementsTree =
+        mixPresentationTree.getChildWithName(MixPresentation::kAudioElements);
+    const Speakers::AudioElementSpeakerLayout layout =
+        getLargestLayoutFromTree(audioElementsTree);
+
+    std::optional<MixPresentationLoudness> mixPresLoudness =
+        loudnessRepo_.get(mixPresID);
+    if (!mixPresLoudness.has_value()) {
+      loudnessRepo_.add(MixPresentationLoudness(mixPresID, layout));
+    } else if (mixPresLoudness->getLargestLayout() != layout) {
+      mixPresLoudness->replaceLargestLayout(layout);
+      loudnessRepo_.update(*mixPresLoudness);
+    }
+  }
+
+  // The containers are rebuilt when a render starts, and are left alone
+  // while one is running
+  if (!performingRender_ && sampleRate_ > 0) {
+    intializeExportContainers();
+  }
+}
+
 void LoudnessExportProcessor::handleNewLayoutAdded(
     juce::ValueTree& parentTree, juce::ValueTree& childWhichHasBeenAdded) {
   // this function is only for handling a new Audio Element Layout
@@ -246,41 +285,30 @@ void LoudnessExportProcessor::intializeExportContainers() {
 }
 
 void LoudnessExportProcessor::initializeLoudnessExport(FileExport& config) {
-  performingRender_ = true;
+  setPerformingRender(true);
 
   LOG_INFO(0,
            "Beginning loudness metadata calculations for .iamf file export \n");
 
   sampleRate_ = config.getSampleRate();
-  sampleTally_ = 0;
-  startTime_ = config.getStartTime();
-  endTime_ = config.getEndTime();
+  exportRange_.reset(sampleRate_, config.getStartTime(), config.getEndTime());
 
   intializeExportContainers();
 }
 
-bool LoudnessExportProcessor::areLoudnessCalcsRequired(
-    const juce::AudioBuffer<float>& buffer) {
+void LoudnessExportProcessor::measureExportRange(
+    juce::AudioBuffer<float>& buffer) {
+  // kick out of process block if there is no nothing to render
   if (!performingRender_ || buffer.getNumSamples() < 1) {
-    return false;
+    return;
+  }
+  const juce::Range<int> samples = exportRange_.advance(buffer.getNumSamples());
+  if (samples.isEmpty()) {
+    return;
   }
 
-  // Calculate the current time with the existing number of samples that have
-  // been processed
-  long currentTime = sampleTally_ / sampleRate_;
-  // update the sample tally
-  sampleTally_ += buffer.getNumSamples();
-  // with the updated sample tally, calculate the next time
-  long nextTime = sampleTally_ / sampleRate_;
-
-  if (startTime_ != 0 || endTime_ != 0) {
-    // Handle the case where startTime and endTime are set, implying we
-    // are only bouncing a subset of the mix
-
-    // do not render
-    if (currentTime < startTime_ || nextTime > endTime_) {
-      return false;
-    }
+  // Only measure the part of a block straddling the start or end time
+  for (auto& exportContainer : exportContainers_) {
+    exportContainer.process(buffer, samples.getStart(), samples.getLength());
   }
-  return true;
 }
@@ -16,9 +16,10 @@
 
 #pragma once
 #include "MixPresentationLoudnessExportContainer.h"
+#include "processors/file_output/ExportRange.h"
 
 class LoudnessExportProcessor : public ProcessorBase,
-                                public juce::ValueTree::Listener {
+                                public RepositoryTransactionListener {
  public:
   using EBU128Stats = MeasureEBU128::LoudnessStats;
 
@@ -36,6 +37,12 @@ class LoudnessExportProcessor : public ProcessorBase,
   void processBlock(juce::AudioBuffer<float>& buffer,
                     juce::MidiBuffer& midiMessages) override;
 
+  void skipBlock(int numSamples) override;
+
+  BufferAccess getBufferAccess() const override {
+    return BufferAccess::kReadOnly;
+  }
+
   const std::vector<const MixPresentationLoudnessExportContainer*>
   getExportContainers() const {
     std::vector<const MixPresentationLoudnessExportContainer*> containers(
@@ -57,6 +64,10 @@ class LoudnessExportProcessor : public ProcessorBase,
                              juce::ValueTree& childWhichHasBeenRemoved,
                              int indexFromWhichChildWasRemoved) override;
 
+  // Bring the loudness repository in line with the mix presentations after a
+  // transaction, then rebuild the export containers once
+  void repositoryTransactionCommitted(juce::ValueTree& state) override;
+
   void handleNewLayoutAdded(juce::ValueTree& parentTree,
                             juce::ValueTree& childWhichHasBeenAdded);
 
@@ -67,7 +78,15 @@ class LoudnessExportProcessor : public ProcessorBase,
 
   void intializeExportContainers();
 
-  bool areLoudnessCalcsRequired(const juce::AudioBuffer<float>& buffer);
+  // Measure the loudness of the samples of the buffer inside the export
+  // range.
+  void measureExportRange(juce::AudioBuffer<float>& buffer);
+
+  // Only take part in the chain while rendering
+  void setPerformingRender(bool performingRender) {
+    performingRender_ = performingRender;
+    setActive(performingRender);
+  }
 
   bool performingRender_;
 
@@ -78,9 +97,7 @@ class LoudnessExportProcessor : public ProcessorBase,
 
   long sampleRate_;
   int currentSamplesPerBlock_;
-  int sampleTally_;
-  int startTime_;
-  int endTime_;
+  ExportRange exportRange_;
 
   std::vector<MixPresentationLoudnessExportContainer> exportContainers_;
 };
\ No newline at end of file
@@ -47,7 +47,7 @@ void PremiereProLoudnessExportProcessor::setNonRealtime(
   FileExport config = fileExportRepository_.get();
 
   if (!config.getManualExport()) {
-    performingRender_ = false;
+    setPerformingRender(false);
     return;
   }
 
@@ -66,18 +66,11 @@ void PremiereProLoudnessExportProcessor::prepareToPlay(double sampleRate,
                                                        int samplesPerBlock) {
   sampleRate_ = sampleRate;
   currentSamplesPerBlock_ = samplesPerBlock;
-  sampleTally_ = 0;
+  exportRange_.rewind();
   intializeExportContainers();
 }
 
 void PremiereProLoudnessExportProcessor::processBlock(
     juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) {
-  // If we are not performing a render, return
-  if (!areLoudnessCalcsRequired(buffer)) {
-    return;
-  }
-
-  for (auto& exportContainer : exportContainers_) {
-    exportContainer.process(buffer);
-  }
+  measureExportRange(buffer);
 }
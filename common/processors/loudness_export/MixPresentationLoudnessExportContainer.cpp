@@ -36,27 +36,40 @@ MixPresentationLoudnessExportContainer::
     ~MixPresentationLoudnessExportContainer() {}
 
 void MixPresentationLoudnessExportContainer::process(
-    juce::AudioBuffer<float>& buffer) {
+    const juce::AudioBuffer<float>& buffer, const int startSample,
+    const int numSamples) {
+  // Hosts may pass blocks larger than prepared when rendering offline
+  for (int start = 0; start < numSamples; start += kSamplesPerBlock) {
+    processBlock(buffer, startSample + start,
+                 std::min(kSamplesPerBlock, numSamples - start));
+  }
+}
+
+void MixPresentationLoudnessExportContainer::processBlock(
+    const juce::AudioBuffer<float>& buffer, const int startSample,
+    const int numSamples) {
   // clear buffers before mixing audio
   mixPresBuffers.first.clear();
   mixPresBuffers.second.clear();
   for (auto& rendererPair : audioElementRenderers) {
-    renderAudioElement(*rendererPair.first, buffer, mixPresBuffers.first);
+    renderAudioElement(*rendererPair.first, buffer, startSample, numSamples,
+                       mixPresBuffers.first);
     if (rendererPair.second != nullptr &&
         mixPresBuffers.second.getNumChannels() >
             Speakers::kStereo.getNumChannels()) {
-      renderAudioElement(*rendererPair.second, buffer, mixPresBuffers.second);
+      renderAudioElement(*rendererPair.second, buffer, startSample, numSamples,
+                         mixPresBuffers.second);
     }
   }
 
   measureStereoLoudness(
-      getRenderedBuffer(mixPresBuffers.first, Speakers::kStereo));
+      getRenderedBuffer(mixPresBuffers.first, Speakers::kStereo, numSamples));
 
   if (largestLayout != Speakers::kStereo && loudnessImpls.second != nullptr &&
       mixPresBuffers.second.getNumChannels() >
           Speakers::kStereo.getNumChannels()) {
     measureLayoutLoudness(
-        getRenderedBuffer(mixPresBuffers.second, largestLayout));
+        getRenderedBuffer(mixPresBuffers.second, largestLayout, numSamples));
   }
 }
 
@@ -122,7 +135,8 @@ MixPresentationLoudnessExportContainer::createMixPresBuffers() {
 }
 
 void MixPresentationLoudnessExportContainer::renderAudioElement(
-    AudioElementRenderer& renderer, juce::AudioBuffer<float>& buffer,
+    AudioElementRenderer& renderer, const juce::AudioBuffer<float>& buffer,
+    const int startSample, const int numSamples,
     juce::AudioBuffer<float>& mixPresBuffer) {
   renderer.inputData.clear();
   renderer.outputData.clear();
@@ -130,8 +144,8 @@ void MixPresentationLoudnessExportContainer::renderAudioElement(
   // Copy Audio Element substream data from the process block buffer to the
   // AudioElementRenderer's input buffer.
   for (int ch = 0; ch < renderer.inputData.getNumChannels(); ++ch) {
-    renderer.inputData.copyFrom(ch, 0, buffer, renderer.firstChannel + ch, 0,
-                                buffer.getNumSamples());
+    renderer.inputData.copyFrom(ch, 0, buffer, renderer.firstChannel + ch,
+                                startSample, numSamples);
   }
 
   if (renderer.renderer !=
@@ -175,8 +189,8 @@ void MixPresentationLoudnessExportContainer::measureLayoutLoudness(
 const juce::AudioBuffer<float>
 MixPresentationLoudnessExportContainer::getRenderedBuffer(
     juce::AudioBuffer<float>& busBuff,
-    const Speakers::AudioElementSpeakerLayout& layout) {
+    const Speakers::AudioElementSpeakerLayout& layout, const int numSamples) {
   auto dataPtrs = busBuff.getArrayOfWritePointers();
   int numRdrCh = layout.getChannelSet().size();
-  return juce::AudioBuffer<float>(dataPtrs, numRdrCh, busBuff.getNumSamples());
+  return juce::AudioBuffer<float>(dataPtrs, numRdrCh, numSamples);
 }
\ No newline at end of file
@@ -19,6 +19,7 @@
 #include <processors/processor_base/ProcessorBase.h>
 #include <processors/render/RenderProcessor.h>
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -50,7 +51,10 @@ class MixPresentationLoudnessExportContainer {
   MixPresentationLoudnessExportContainer& operator=(
       MixPresentationLoudnessExportContainer&&) noexcept = default;
 
-  void process(juce::AudioBuffer<float>& buffer);
+  // Measure numSamples samples of the buffer, starting at startSample. Blocks
+  // larger than samplesPerBlock are measured a block at a time.
+  void process(const juce::AudioBuffer<float>& buffer, int startSample,
+               int numSamples);
 
   // internal copy of the mixPres ID
   const juce::Uuid mixPresentationId;
@@ -100,8 +104,12 @@ class MixPresentationLoudnessExportContainer {
   std::pair<juce::AudioBuffer<float>, juce::AudioBuffer<float>>
   createMixPresBuffers();
 
+  void processBlock(const juce::AudioBuffer<float>& buffer, int startSample,
+                    int numSamples);
+
   void renderAudioElement(AudioElementRenderer& renderer,
-                          juce::AudioBuffer<float>& buffer,
+                          const juce::AudioBuffer<float>& buffer,
+                          int startSample, int numSamples,
                           juce::AudioBuffer<float>& mixPresBuffer);
 
   void measureStereoLoudness(const juce::AudioBuffer<float>& buffer);
@@ -110,5 +118,5 @@ class MixPresentationLoudnessExportContainer {
 
   const juce::AudioBuffer<float> getRenderedBuffer(
       juce::AudioBuffer<float>& busBuff,
-      const Speakers::AudioElementSpeakerLayout& layout);
+      const Speakers::AudioElementSpeakerLayout& layout, int numSamples);
 };
\ No newline at end of file
@@ -82,8 +82,8 @@ void Panner3DProcessor::initializePanning() {
     surroundPanner_.reset();
   } else if (outputLayout_ == Speakers::kBinaural) {
     // For binaural layouts, use the Binaural Panner based on the obr library
-    surroundPanner_ =
-        std::make_unique<BinauralPanner>(samplesPerBlock_, sampleRate_);
+    surroundPanner_ = std::make_unique<BinauralPanner>(
+        samplesPerBlock_, sampleRate_, ProcessorBase::hostVariesBlockSize());
   } else if (outputLayout_.isAmbisonics()) {
     // For ambisonics layouts, use the Ambisonic Panner based on the obr
     // library
@@ -96,7 +96,12 @@ void Panner3DProcessor::initializePanning() {
   }
 
   outputBuffer_.setSize(outputLayout_.getNumChannels(), samplesPerBlock_);
+  const int latency =
+      surroundPanner_ != nullptr ? surroundPanner_->getLatencySamples() : 0;
   renderLock.exit();
+  // The panner's latency is fixed when it is created, so it is only reported
+  // here and never while processing
+  hostProcessor_->setLatencySamples(latency);
   hostProcessor_->suspendProcessing(false);
 }
 
@@ -112,14 +117,25 @@ void Panner3DProcessor::processBlock(juce::AudioBuffer<float>& buffer,
   if (surroundPanner_ != NULL) {
     surroundPanner_->setPosition(xPosition_, yPosition_, zPosition_);
 
-    // Perform the panning operation
-    surroundPanner_->process(buffer, outputBuffer_);
-
-    // Manually copy the number of channels of the output layout from the
-    // output buffer to the input buffer to avoid resizing.
-    for (int channel = 0; channel < outputBuffer_.getNumChannels(); ++channel) {
-      buffer.copyFrom(channel, 0, outputBuffer_, channel, 0,
-                      buffer.getNumSamples());
+    // Perform the panning operation, in blocks of at most the size the panner
+    // was created with. Only the first channel is panned, and a single channel
+    // view refers to it without allocating.
+    const int numSamples = buffer.getNumSamples();
+    for (int start = 0; start < numSamples && samplesPerBlock_ > 0;
+         start += samplesPerBlock_) {
+      const int num = std::min(samplesPerBlock_, numSamples - start);
+      float* const input = buffer.getWritePointer(0, start);
+      inputView_.setDataToReferTo(&input, 1, num);
+      outputBuffer_.setSize(outputLayout_.getNumChannels(), num, false, false,
+                            true);
+      surroundPanner_->process(inputView_, outputBuffer_);
+
+      // Manually copy the number of channels of the output layout from the
+      // output buffer to the input buffer to avoid resizing.
+      for (int channel = 0; channel < outputBuffer_.getNumChannels();
+           ++channel) {
+        buffer.copyFrom(channel, start, outputBuffer_, channel, 0, num);
+      }
     }
   }
 
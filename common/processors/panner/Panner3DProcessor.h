@@ -96,10 +96,12 @@ class Panner3DProcessor final
   AudioElementParameterTree* automationParameterTree_;
   juce::SpinLock renderLock;
   std::unique_ptr<AudioPanner> surroundPanner_;
-  int samplesPerBlock_;
+  int samplesPerBlock_ = 0;
   int sampleRate_;
   Speakers::AudioElementSpeakerLayout inputLayout_;
   Speakers::AudioElementSpeakerLayout outputLayout_;
+  // Refers to the part of the panned input channel being panned
+  juce::AudioBuffer<float> inputView_;
   juce::AudioBuffer<float> outputBuffer_;
   int xPosition_;
   int yPosition_;
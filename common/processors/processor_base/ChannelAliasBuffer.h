@@ -0,0 +1,87 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#include <algorithm>
+#include <vector>
+
+//==============================================================================
+// An AudioBuffer whose channels alias channels owned elsewhere, re-pointed
+// every block without allocating.
+//
+// JUCE allocates the channel list of a buffer referring to more than 32
+// channels each time it is pointed at them, and can only grow a buffer by
+// reallocating it. Instead the buffer owns room for the most channels at the
+// largest block, so resizing it within that never allocates, and its channel
+// list is then overwritten in place. Channels left unaliased are the buffer's
+// own, and serve as scratch channels that keep nothing between blocks.
+class ChannelAliasBuffer {
+ public:
+  // Allocates, so not to be called while processing.
+  void prepare(const int maxChannels, const int maxSamples) {
+    // A fresh buffer, since resizing to the same size keeps aliased channels
+    buffer_ = juce::AudioBuffer<float>(maxChannels, maxSamples);
+    maxChannels_ = maxChannels;
+    maxSamples_ = maxSamples;
+    ownChannels_.resize(maxChannels);
+    updateOwnChannels();
+  }
+
+  int getMaxChannels() const { return maxChannels_; }
+  int getMaxSamples() const { return maxSamples_; }
+
+  bool fits(const int numChannels, const int numSamples) const {
+    return numChannels <= maxChannels_ && numSamples <= maxSamples_;
+  }
+
+  // Sizes the buffer to numChannels by numSamples, which must fit, and points
+  // its first numAliased channels at the given ones.
+  juce::AudioBuffer<float>& alias(const int numChannels, const int numSamples,
+                                  float* const* channels,
+                                  const int numAliased) {
+    jassert(fits(numChannels, numSamples) && numAliased <= numChannels);
+    if (numChannels != buffer_.getNumChannels() ||
+        numSamples != buffer_.getNumSamples()) {
+      buffer_.setSize(numChannels, numSamples, false, false, true);
+      updateOwnChannels();
+    }
+
+    // The channel list is part of the buffer's own allocation
+    float** const channelList =
+        const_cast<float**>(buffer_.getArrayOfWritePointers());
+    std::copy_n(channels, numAliased, channelList);
+    std::copy(ownChannels_.begin() + numAliased,
+              ownChannels_.begin() + numChannels, channelList + numAliased);
+    return buffer_;
+  }
+
+  // The buffer as last aliased
+  juce::AudioBuffer<float>& getBuffer() { return buffer_; }
+
+ private:
+  // Resizing points every channel back at the buffer's own memory
+  void updateOwnChannels() {
+    std::copy_n(buffer_.getArrayOfWritePointers(), buffer_.getNumChannels(),
+                ownChannels_.begin());
+  }
+
+  juce::AudioBuffer<float> buffer_;
+  std::vector<float*> ownChannels_;
+  int maxChannels_ = 0;
+  int maxSamples_ = 0;
+};
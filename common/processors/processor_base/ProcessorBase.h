@@ -18,6 +18,8 @@
 
 #include <juce_audio_utils/juce_audio_utils.h>
 
+#include <atomic>
+
 class ProcessorBase : public juce::AudioProcessor {
  public:
   // This constructor is called by our internal processors
@@ -69,6 +71,32 @@ class ProcessorBase : public juce::AudioProcessor {
   }
   virtual void reinitializeAfterStateRestore() {}
 
+  // Called in place of processBlock for blocks an offline export skips
+  // before the start of its range. Processors tracking the export position
+  // advance it here.
+  virtual void skipBlock(int numSamples) { juce::ignoreUnused(numSamples); }
+
+  // How processBlock uses the buffer it is given. Processors that only read
+  // it may run alongside one another, see ProcessorChainScheduler.
+  enum class BufferAccess { kReadWrite, kReadOnly };
+  virtual BufferAccess getBufferAccess() const {
+    return BufferAccess::kReadWrite;
+  }
+
+  // Processors with nothing to do, such as the export processors while no
+  // export is running, deactivate themselves. A ProcessorChainScheduler
+  // leaves inactive processors out of the chain until they activate again.
+  bool isActive() const { return active_.load(std::memory_order_acquire); }
+
+  class ActivityListener {
+   public:
+    virtual ~ActivityListener() = default;
+    virtual void processorActivityChanged(ProcessorBase& processor) = 0;
+  };
+  void setActivityListener(ActivityListener* listener) {
+    activityListener_ = listener;
+  }
+
   juce::AudioProcessorEditor* createEditor() override { return nullptr; }
   bool hasEditor() const override { return false; }
 
@@ -100,4 +128,22 @@ class ProcessorBase : public juce::AudioProcessor {
       return juce::AudioChannelSet::ambisonic(5);
     }
   }
+
+  // FL Studio passes blocks of varying size, smaller than prepared. Renderers
+  // that process fixed blocks buffer them in such hosts, at a block of latency.
+  static bool hostVariesBlockSize() {
+    return juce::PluginHostType().isFruityLoops();
+  }
+
+ protected:
+  void setActive(bool active) {
+    if (active_.exchange(active, std::memory_order_acq_rel) != active &&
+        activityListener_ != nullptr) {
+      activityListener_->processorActivityChanged(*this);
+    }
+  }
+
+ private:
+  std::atomic<bool> active_{true};
+  ActivityListener* activityListener_ = nullptr;
 };
\ No newline at end of file
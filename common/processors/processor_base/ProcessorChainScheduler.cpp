@@ -0,0 +1,212 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ProcessorChainScheduler.h"
+
+#include <algorithm>
+
+ProcessorChainScheduler::~ProcessorChainScheduler() { setProcessors({}, 0); }
+
+int ProcessorChainScheduler::getDefaultMaxWorkers() {
+  return std::max(0, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+}
+
+void ProcessorChainScheduler::setProcessors(
+    const std::vector<ProcessorBase*>& processors, const int maxWorkers) {
+  const std::lock_guard<std::mutex> lock(workersMutex_);
+  stopWorkers();
+  for (ProcessorBase* processor : processors_) {
+    processor->setActivityListener(nullptr);
+  }
+  processors_ = processors;
+
+  stages_.clear();
+  for (size_t i = 0; i < processors_.size(); ++i) {
+    auto stage = std::make_unique<Stage>();
+    stage->processors.reserve(processors_.size());
+    stages_.push_back(std::move(stage));
+  }
+
+  // Workers for the widest stage there can be, with every processor active
+  widestStage_ = 0;
+  int stageWidth = 0;
+  for (ProcessorBase* processor : processors_) {
+    processor->setActivityListener(this);
+    const bool isReader = processor->getBufferAccess() ==
+                          ProcessorBase::BufferAccess::kReadOnly;
+    stageWidth = isReader ? stageWidth + 1 : 0;
+    widestStage_ = std::max({widestStage_, stageWidth, 1});
+  }
+  buildStages();
+  prepareViews();
+
+  maxUsefulWorkers_ = std::max(0, std::min(widestStage_ - 1, maxWorkers));
+  if (parallel_.load(std::memory_order_relaxed)) {
+    startWorkers();
+  }
+}
+
+void ProcessorChainScheduler::prepare(const int maxChannels,
+                                      const int maxSamples) {
+  const std::lock_guard<std::mutex> lock(workersMutex_);
+  maxChannels_ = maxChannels;
+  maxSamples_ = maxSamples;
+  prepareViews();
+}
+
+void ProcessorChainScheduler::prepareViews() {
+  views_.resize(widestStage_);
+  for (ChannelAliasBuffer& view : views_) {
+    view.prepare(maxChannels_, maxSamples_);
+  }
+}
+
+void ProcessorChainScheduler::setParallel(const bool parallel) {
+  if (parallel) {
+    const std::lock_guard<std::mutex> lock(workersMutex_);
+    startWorkers();
+  }
+  parallel_.store(parallel, std::memory_order_relaxed);
+}
+
+void ProcessorChainScheduler::process(juce::AudioBuffer<float>& buffer,
+                                      juce::MidiBuffer& midiMessages) {
+  if (activityChanges_.load(std::memory_order_acquire) !=
+      stagedActivityChanges_) {
+    // Workers woken for an earlier stage may not have let go of it yet
+    while (busyWorkers_.load() > 0) {
+      std::this_thread::yield();
+    }
+    buildStages();
+  }
+
+  // Buffers larger than prepared have no views to run readers on
+  const bool parallel =
+      isParallel() && buffer.getNumChannels() <= maxChannels_ &&
+      buffer.getNumSamples() <= maxSamples_;
+  for (int i = 0; i < numStages_; ++i) {
+    Stage& stage = *stages_[i];
+    if (parallel && stage.processors.size() > 1) {
+      runConcurrently(stage, buffer, midiMessages);
+    } else {
+      for (ProcessorBase* processor : stage.processors) {
+        processor->processBlock(buffer, midiMessages);
+      }
+    }
+  }
+}
+
+void ProcessorChainScheduler::processorActivityChanged(
+    ProcessorBase& processor) {
+  juce::ignoreUnused(processor);
+  activityChanges_.fetch_add(1, std::memory_order_release);
+}
+
+void ProcessorChainScheduler::buildStages() {
+  // Changes from here on are staged next time
+  stagedActivityChanges_ = activityChanges_.load(std::memory_order_acquire);
+
+  numStages_ = 0;
+  bool lastWasReader = false;
+  for (ProcessorBase* processor : processors_) {
+    if (!processor->isActive()) {
+      continue;
+    }
+    const bool isReader = processor->getBufferAccess() ==
+                          ProcessorBase::BufferAccess::kReadOnly;
+    if (!isReader || !lastWasReader) {
+      Stage& stage = *stages_[numStages_++];
+      stage.processors.clear();
+    }
+    stages_[numStages_ - 1]->processors.push_back(processor);
+    lastWasReader = isReader;
+  }
+}
+
+void ProcessorChainScheduler::runConcurrently(
+    Stage& stage, juce::AudioBuffer<float>& buffer,
+    juce::MidiBuffer& midiMessages) {
+  const int numTasks = static_cast<int>(stage.processors.size());
+
+  for (int task = 0; task < numTasks; ++task) {
+    views_[task].alias(buffer.getNumChannels(), buffer.getNumSamples(),
+                       buffer.getArrayOfWritePointers(),
+                       buffer.getNumChannels());
+  }
+
+  // Workers may still hold this stage from an earlier block, but can only
+  // claim a task once it is reset below
+  midiMessages_ = &midiMessages;
+  stage.remainingTasks.store(numTasks, std::memory_order_relaxed);
+  stage.nextTask.store(0, std::memory_order_release);
+  currentStage_.store(&stage, std::memory_order_release);
+  wake_.release(std::min(numTasks - 1, getNumWorkers()));
+
+  runTasks(stage);
+  while (stage.remainingTasks.load(std::memory_order_acquire) > 0) {
+    std::this_thread::yield();
+  }
+  currentStage_.store(nullptr);
+}
+
+void ProcessorChainScheduler::runTasks(Stage& stage) {
+  const int numTasks = static_cast<int>(stage.processors.size());
+  for (int task = stage.nextTask.fetch_add(1, std::memory_order_acq_rel);
+       task < numTasks;
+       task = stage.nextTask.fetch_add(1, std::memory_order_acq_rel)) {
+    stage.processors[task]->processBlock(views_[task].getBuffer(),
+                                         *midiMessages_);
+    stage.remainingTasks.fetch_sub(1, std::memory_order_release);
+  }
+}
+
+void ProcessorChainScheduler::runWorker() {
+  // Processors expect denormals flushed, as they are on the calling thread
+  juce::ScopedNoDenormals noDenormals;
+  for (;;) {
+    wake_.acquire();
+    if (stopping_.load(std::memory_order_acquire)) {
+      return;
+    }
+    // Counted before looking at the stage, so restaging never overlaps a
+    // worker holding one
+    busyWorkers_.fetch_add(1);
+    if (Stage* stage = currentStage_.load()) {
+      runTasks(*stage);
+    }
+    busyWorkers_.fetch_sub(1);
+  }
+}
+
+void ProcessorChainScheduler::startWorkers() {
+  while (static_cast<int>(workers_.size()) < maxUsefulWorkers_) {
+    workers_.emplace_back([this] { runWorker(); });
+  }
+  numWorkers_.store(static_cast<int>(workers_.size()),
+                    std::memory_order_release);
+}
+
+void ProcessorChainScheduler::stopWorkers() {
+  numWorkers_.store(0, std::memory_order_release);
+  stopping_.store(true, std::memory_order_release);
+  wake_.release(static_cast<std::ptrdiff_t>(workers_.size()));
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+  stopping_.store(false, std::memory_order_relaxed);
+  // Wake-ups left over from earlier stages
+  while (wake_.try_acquire()) {
+  }
+}
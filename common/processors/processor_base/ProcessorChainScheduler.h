@@ -0,0 +1,126 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <semaphore>
+#include <thread>
+#include <vector>
+
+#include "ChannelAliasBuffer.h"
+#include "ProcessorBase.h"
+
+//==============================================================================
+// Runs a chain of processors on one buffer, running processors that only read
+// the buffer alongside one another. A processor that writes the buffer
+// depends on every processor before it, and one that reads it on the last
+// writer before it, so the chain falls into stages of either a single writer
+// or a run of consecutive readers. Readers in a stage are shared between the
+// calling thread and a pool of workers, started the first time the chain is
+// made parallel. Running a stage neither locks nor allocates. Readers run on
+// views of the buffer sized in prepare, and a buffer larger than that runs
+// its readers serially.
+//
+// Only active processors are staged. When a processor's activity changes the
+// stages are rebuilt before the next block, in storage reserved up front.
+class ProcessorChainScheduler final : private ProcessorBase::ActivityListener {
+ public:
+  ProcessorChainScheduler() = default;
+  ~ProcessorChainScheduler() override;
+
+  // Groups the active processors into stages and sizes the pool for as many
+  // workers as the widest stage of all processors can use, up to maxWorkers.
+  // Not to be called while processing.
+  void setProcessors(const std::vector<ProcessorBase*>& processors,
+                     int maxWorkers = getDefaultMaxWorkers());
+
+  // Sizes the readers' views for buffers of up to maxChannels by maxSamples.
+  // Not to be called while processing.
+  void prepare(int maxChannels, int maxSamples);
+
+  // When not parallel, or without workers, the chain runs serially on the
+  // calling thread. The workers are started the first time the chain is made
+  // parallel, so a chain that only ever runs serially starts no threads.
+  void setParallel(bool parallel);
+  bool isParallel() const {
+    return parallel_.load(std::memory_order_relaxed) && getNumWorkers() > 0;
+  }
+
+  void process(juce::AudioBuffer<float>& buffer,
+               juce::MidiBuffer& midiMessages);
+
+  int getNumStages() const { return numStages_; }
+  int getNumWorkers() const {
+    return numWorkers_.load(std::memory_order_acquire);
+  }
+
+  // One less than the number of hardware threads, leaving one for the caller
+  static int getDefaultMaxWorkers();
+
+ private:
+  struct Stage {
+    std::vector<ProcessorBase*> processors;
+    std::atomic<int> nextTask{0};
+    std::atomic<int> remainingTasks{0};
+  };
+
+  void processorActivityChanged(ProcessorBase& processor) override;
+
+  // Called with workersMutex_ held
+  void prepareViews();
+
+  // Stages the active processors, without allocating.
+  void buildStages();
+  void runConcurrently(Stage& stage, juce::AudioBuffer<float>& buffer,
+                       juce::MidiBuffer& midiMessages);
+  void runTasks(Stage& stage);
+  void runWorker();
+  // Both called with workersMutex_ held
+  void startWorkers();
+  void stopWorkers();
+
+  std::vector<ProcessorBase*> processors_;
+  // One stage, with room for every processor, per processor
+  std::vector<std::unique_ptr<Stage>> stages_;
+  int numStages_ = 0;
+  // Readers run on their own view of the buffer, so no buffer object is used
+  // by two threads. Stages run one at a time and share the views, one per
+  // reader of the widest stage there can be.
+  std::vector<ChannelAliasBuffer> views_;
+  int widestStage_ = 0;
+  int maxChannels_ = 0;
+  int maxSamples_ = 0;
+  std::atomic<unsigned> activityChanges_{0};
+  unsigned stagedActivityChanges_ = 0;
+
+  std::mutex workersMutex_;
+  std::vector<std::thread> workers_;
+  int maxUsefulWorkers_ = 0;
+  std::atomic<int> numWorkers_{0};
+  std::counting_semaphore<> wake_{0};
+  std::atomic<Stage*> currentStage_{nullptr};
+  // Workers that may be using a stage, waited for before restaging
+  std::atomic<int> busyWorkers_{0};
+  std::atomic<bool> stopping_{false};
+  std::atomic<bool> parallel_{false};
+  // Set before a stage's tasks can be claimed
+  juce::MidiBuffer* midiMessages_ = nullptr;
+
+  JUCE_DECLARE_NON_COPYABLE(ProcessorChainScheduler)
+};
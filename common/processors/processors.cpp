@@ -16,10 +16,14 @@
 
 #include "audioelementplugin_publisher/AudioElementPluginDataPublisher.cpp"
 #include "channel_monitor/ChannelMonitorProcessor.cpp"
+#include "file_output/ExportJobProcessor.cpp"
 #include "file_output/FileOutputProcessor.cpp"
 #include "file_output/FileOutputProcessor_PremierePro.cpp"
+#include "file_output/MappedWavWriter.cpp"
 #include "file_output/WavFileOutputProcessor.cpp"
+#include "file_output/iamf_export_utils/ExportProfile.cpp"
 #include "file_output/iamf_export_utils/IAMFExportUtil.cpp"
+#include "gain/ChannelGainStage.cpp"
 #include "gain/GainEditor.cpp"
 #include "gain/GainProcessor.cpp"
 #include "gain/MSProcessor.cpp"
@@ -30,8 +34,10 @@
 #include "mix_monitoring/TrackMonitorProcessor.cpp"
 #include "mix_monitoring/loudness_standards/MeasureEBU128.cpp"
 #include "panner/Panner3DProcessor.cpp"
+#include "processor_base/ProcessorChainScheduler.cpp"
 #include "remapping/RemappingProcessor.cpp"
 #include "render/RenderProcessor.cpp"
 #include "routing/RoutingProcessor.cpp"
+#include "routing/SharedAudioBusProcessor.cpp"
 #include "soundfield/SoundFieldProcessor.cpp"
 #include "soundfield/SoundFieldReconstructor.cpp"
\ No newline at end of file
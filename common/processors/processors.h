@@ -34,9 +34,11 @@ END_JUCE_MODULE_DECLARATION
 
 #include "audioelementplugin_publisher/AudioElementPluginDataPublisher.h"
 #include "channel_monitor/ChannelMonitorProcessor.h"
+#include "file_output/ExportJobProcessor.h"
 #include "file_output/FileOutputProcessor.h"
 #include "file_output/FileOutputProcessor_PremierePro.h"
 #include "file_output/WavFileOutputProcessor.h"
+#include "gain/ChannelGainStage.h"
 #include "gain/GainEditor.h"
 #include "gain/GainProcessor.h"
 #include "gain/MSProcessor.h"
@@ -46,8 +48,11 @@ END_JUCE_MODULE_DECLARATION
 #include "mix_monitoring/MixMonitorProcessor.h"
 #include "mix_monitoring/TrackMonitorProcessor.h"
 #include "panner/Panner3DProcessor.h"
+#include "processor_base/ChannelAliasBuffer.h"
 #include "processor_base/ProcessorBase.h"
+#include "processor_base/ProcessorChainScheduler.h"
 #include "remapping/RemappingProcessor.h"
 #include "render/RenderProcessor.h"
 #include "routing/RoutingProcessor.h"
+#include "routing/SharedAudioBusProcessor.h"
 #include "soundfield/SoundFieldProcessor.h"
\ No newline at end of file
@@ -14,6 +14,8 @@
 
 #include "RemappingProcessor.h"
 
+#include <algorithm>
+
 #include "../../rendererplugin/src/RendererProcessor.h"
 #include "juce_core/system/juce_PlatformDefs.h"
 #include "logger/logger.h"
@@ -55,36 +57,80 @@ void RemappingProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
   } else {
     remapTable_ = constructRemapTable(busChannels, expectedChannels);
   }
+
+  remapSteps_ = constructRemapSteps(remapTable_);
+  scratchBuffer_.setSize(1, samplesPerBlock);
 }
 
 void RemappingProcessor::processBlock(juce::AudioBuffer<float>& buffer,
                                       juce::MidiBuffer&) {
-  if (!remapTable_.empty()) {
+  if (!remapSteps_.empty()) {
     remapBuffer(buffer);
   }
 }
 
-const juce::AudioBuffer<float> RemappingProcessor::createBufferCopy(
-    const juce::AudioBuffer<float>& buffer) const {
-  // Create a copy of the input buffer
-  juce::AudioBuffer<float> copy(buffer.getNumChannels(),
-                                buffer.getNumSamples());
-  for (int channel = 0; channel < buffer.getNumChannels(); ++channel) {
-    copy.copyFrom(channel, 0, buffer, channel, 0, buffer.getNumSamples());
+// converts from protools to the standard layout
+void RemappingProcessor::remapBuffer(juce::AudioBuffer<float>& buffer) {
+  const int numSamples = buffer.getNumSamples();
+  // Only reallocates if the host exceeds the prepared block size
+  scratchBuffer_.setSize(1, numSamples, false, false, true);
+
+  auto channelData = [&](const int channel) {
+    return channel == kScratchChannel ? scratchBuffer_.getWritePointer(0)
+                                      : buffer.getWritePointer(channel);
+  };
+
+  for (const auto& step : remapSteps_) {
+    if (step.sourceChannel >= buffer.getNumChannels() ||
+        step.targetChannel >= buffer.getNumChannels()) {
+      continue;
+    }
+    juce::FloatVectorOperations::copy(channelData(step.targetChannel),
+                                      channelData(step.sourceChannel),
+                                      numSamples);
   }
-  return copy;
 }
 
-// converts from protools to the standard layout
-void RemappingProcessor::remapBuffer(juce::AudioBuffer<float>& buffer) {
-  // Create a copy of the input buffer
-  juce::AudioBuffer<float> originalBuffer = createBufferCopy(buffer);
+PassthroughRemapTable RemappingProcessor::constructRemapSteps(
+    const PassthroughRemapTable& remapTable) {
+  // Every target channel takes the original content of its source channel.
+  // Order the copies so no channel is overwritten while another copy still
+  // needs its original content. When only cycles remain, break one by saving
+  // a channel to the scratch channel and reading it from there instead.
+  PassthroughRemapTable pending;
+  for (const auto& remap : remapTable) {
+    if (remap.sourceChannel != remap.targetChannel) {
+      pending.push_back(remap);
+    }
+  }
+
+  auto isPendingSource = [&pending](const int channel) {
+    return std::any_of(pending.begin(), pending.end(), [&](const auto& remap) {
+      return remap.sourceChannel == channel;
+    });
+  };
 
-  // iterate through the remap table
-  for (const auto& remap : remapTable_) {
-    buffer.copyFrom(remap.targetChannel, 0, originalBuffer, remap.sourceChannel,
-                    0, originalBuffer.getNumSamples());
+  PassthroughRemapTable steps;
+  while (!pending.empty()) {
+    auto ready = std::find_if(pending.begin(), pending.end(),
+                              [&](const auto& remap) {
+                                return !isPendingSource(remap.targetChannel);
+                              });
+    if (ready != pending.end()) {
+      steps.push_back(*ready);
+      pending.erase(ready);
+      continue;
+    }
+
+    const int saved = pending.front().targetChannel;
+    steps.emplace_back(saved, kScratchChannel);
+    for (auto& remap : pending) {
+      if (remap.sourceChannel == saved) {
+        remap.sourceChannel = kScratchChannel;
+      }
+    }
   }
+  return steps;
 }
 
 PassthroughRemapTable RemappingProcessor::constructRemapTable(
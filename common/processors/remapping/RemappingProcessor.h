@@ -65,13 +65,19 @@ class RemappingProcessor final : public ProcessorBase,
  private:
   void remapBuffer(juce::AudioBuffer<float>& buffer);
 
-  const juce::AudioBuffer<float> createBufferCopy(
-      const juce::AudioBuffer<float>& buffer) const;
+  // Orders the remap table into copies that can be applied in place, using
+  // kScratchChannel to break cycles
+  static PassthroughRemapTable constructRemapSteps(
+      const PassthroughRemapTable& remapTable);
 
   PassthroughRemapTable constructRemapTable(
       const juce::Array<juce::AudioChannelSet::ChannelType>& sourceChannels,
       const juce::Array<juce::AudioChannelSet::ChannelType>& targetChannels);
+  inline static constexpr int kScratchChannel = -1;
+
   PassthroughRemapTable remapTable_;
+  PassthroughRemapTable remapSteps_;
+  juce::AudioBuffer<float> scratchBuffer_;
   ProcessorBase* hostProcessor_;
   const bool kHandleOutputBus_;
 };
\ No newline at end of file
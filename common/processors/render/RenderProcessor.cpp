@@ -14,6 +14,7 @@
 
 #include "RenderProcessor.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <ranges>
 
@@ -30,7 +31,7 @@
 AudioElementRenderer::AudioElementRenderer(
     Speakers::AudioElementSpeakerLayout inputLayout,
     Speakers::AudioElementSpeakerLayout playbackLayout, int firstInputChannel,
-    int samplesPerBlock, int sampleRate, bool isBinaural)
+    int samplesPerBlock, int sampleRate, bool isBinaural, bool bufferBlocks)
     : inputData(inputLayout.getNumChannels(), samplesPerBlock),
       outputData(playbackLayout.getNumChannels(), samplesPerBlock),
       outputDataBinaural(Speakers::kBinaural.getNumChannels(), samplesPerBlock),
@@ -40,7 +41,8 @@ AudioElementRenderer::AudioElementRenderer(
   renderer = createRenderer(inputLayout, playbackLayout);
   if (kIsBinaural) {
     rendererBinaural = createRenderer(inputLayout, Speakers::kBinaural,
-                                      samplesPerBlock, sampleRate);
+                                      samplesPerBlock, sampleRate,
+                                      bufferBlocks);
   } else {
     rendererBinaural = createRenderer(inputLayout, Speakers::kStereo);
   }
@@ -68,10 +70,10 @@ RenderProcessor::RenderProcessor(ProcessorBase* hostProc,
   initializeRenderers();
 
   // Listen for updates from the UI
-  audioElementData_->registerListener(this);
-  roomSetupData->registerListener(this);
-  mixPresData_->registerListener(this);
-  activeMixPresData_->registerListener(this);
+  audioElementData_->registerTransactionListener(this);
+  roomSetupData->registerTransactionListener(this);
+  mixPresData_->registerTransactionListener(this);
+  activeMixPresData_->registerTransactionListener(this);
 }
 
 RenderProcessor::~RenderProcessor() {
@@ -83,10 +85,10 @@ RenderProcessor::~RenderProcessor() {
   }
   audioElementRenderers_.clear();
 
-  audioElementData_->deregisterListener(this);
-  roomSetupData_->deregisterListener(this);
-  mixPresData_->deregisterListener(this);
-  activeMixPresData_->deregisterListener(this);
+  audioElementData_->deregisterTransactionListener(this);
+  roomSetupData_->deregisterTransactionListener(this);
+  mixPresData_->deregisterTransactionListener(this);
+  activeMixPresData_->deregisterTransactionListener(this);
 }
 
 void RenderProcessor::initializeRenderers() {
@@ -106,6 +108,7 @@ void RenderProcessor::initializeRenderers() {
   // If the active mix presentation is invalid, exit.
   std::optional<MixPresentation> activeMixPres = mixPresData_->get(activeMixID);
   if (!activeMixPres) {
+    updateLatency();
     return;
   }
 
@@ -163,9 +166,25 @@ void RenderProcessor::initializeRenderers() {
         audioElementLayout,
         roomSetupData_->get().getSpeakerLayout().getRoomSpeakerLayout(),
         firstChannel, currentSamplesPerBlock_, currentSampleRate_,
-        mixPresAudioElement.isBinaural()));
+        mixPresAudioElement.isBinaural(), bufferBlocks_));
   }
 
+  // Binaural renderers buffering blocks trail their input by a block. Delay the
+  // binaural output of the other renderers by the same block to keep the
+  // binaural mix aligned.
+  int binauralLatency = 0;
+  for (const AudioElementRenderer* aeRdr : audioElementRenderers_) {
+    binauralLatency = std::max(binauralLatency,
+                               aeRdr->rendererBinaural->getLatencySamples());
+  }
+  for (AudioElementRenderer* aeRdr : audioElementRenderers_) {
+    if (aeRdr->rendererBinaural->getLatencySamples() < binauralLatency) {
+      aeRdr->rendererBinaural = std::make_unique<BinauralCopyRdr>(
+          currentSamplesPerBlock_, std::move(aeRdr->rendererBinaural));
+    }
+  }
+  updateLatency();
+
   // Set up the input and output buffers
   for (auto& aeRdr : audioElementRenderers_) {
     aeRdr->inputData.setSize(
@@ -187,6 +206,13 @@ const juce::String RenderProcessor::getName() const { return {"FileOutput"}; }
 //==============================================================================
 void RenderProcessor::setNonRealtime(bool isNonRealtime) noexcept {}
 
+void RenderProcessor::setBufferBlocks(const bool bufferBlocks) {
+  if (bufferBlocks_ != bufferBlocks) {
+    bufferBlocks_ = bufferBlocks;
+    initializeRenderers();
+  }
+}
+
 void RenderProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
   juce::ignoreUnused(sampleRate);
 
@@ -199,14 +225,60 @@ void RenderProcessor::processBlock(juce::AudioBuffer<float>& buffer,
                                    juce::MidiBuffer& midiMessages) {
   juce::ignoreUnused(midiMessages);
 
-  // Clear the internal buffers.
-  mixBuffer_.clear();
-  binauralMixBuffer_.clear();
-
   // Take the renderers lock to prevent the renderers from being modified by the
   // UI thread while processing.
   const juce::SpinLock::ScopedLockType lock(renderersLock_);
 
+  // Hosts may pass blocks larger than prepared, particularly when rendering
+  // offline. These are rendered a prepared block at a time.
+  const int numSamples = buffer.getNumSamples();
+  for (int start = 0; start < numSamples; start += currentSamplesPerBlock_) {
+    renderBlock(buffer, start,
+                std::min(currentSamplesPerBlock_, numSamples - start));
+  }
+}
+
+void RenderProcessor::updateLatency() {
+  // The latency of the binaural renderers is fixed when they are created. The
+  // beds are only delayed in the binaural mix.
+  int latency = 0;
+  if (currentPlaybackLayout_ == Speakers::kBinaural) {
+    for (const AudioElementRenderer* aeRdr : audioElementRenderers_) {
+      latency =
+          std::max(latency, aeRdr->rendererBinaural->getLatencySamples());
+    }
+  }
+  hostProcessor_->setLatencySamples(latency);
+}
+
+void RenderProcessor::setInternalBlockSize(const int numSamples) {
+  if (mixBuffer_.getNumSamples() == numSamples) {
+    return;
+  }
+  mixBuffer_.setSize(mixBuffer_.getNumChannels(), numSamples, false, false,
+                     true);
+  binauralMixBuffer_.setSize(binauralMixBuffer_.getNumChannels(), numSamples,
+                             false, false, true);
+  for (AudioElementRenderer* aeRdr : audioElementRenderers_) {
+    aeRdr->inputData.setSize(aeRdr->inputData.getNumChannels(), numSamples,
+                             false, false, true);
+    aeRdr->outputData.setSize(aeRdr->outputData.getNumChannels(), numSamples,
+                              false, false, true);
+    aeRdr->outputDataBinaural.setSize(
+        aeRdr->outputDataBinaural.getNumChannels(), numSamples, false, false,
+        true);
+  }
+}
+
+void RenderProcessor::renderBlock(juce::AudioBuffer<float>& buffer,
+                                  const int startSample, const int numSamples) {
+  // Shorter blocks than prepared are rendered within the buffers' allocations
+  setInternalBlockSize(numSamples);
+
+  // Clear the internal buffers.
+  mixBuffer_.clear();
+  binauralMixBuffer_.clear();
+
   // Fetch each audio element currently being played back, render it to this
   // room setup
   for (auto& aeRdr : audioElementRenderers_) {
@@ -218,8 +290,8 @@ void RenderProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     // Copy Audio Element substream data from the process block buffer to the
     // AudioElementRenderer's input buffer.
     for (int ch = 0; ch < aeRdr->inputData.getNumChannels(); ++ch) {
-      aeRdr->inputData.copyFrom(ch, 0, buffer, aeRdr->firstChannel + ch, 0,
-                                buffer.getNumSamples());
+      aeRdr->inputData.copyFrom(ch, 0, buffer, aeRdr->firstChannel + ch,
+                                startSample, numSamples);
     }
 
     // Always attempt to render binaural audio.
@@ -254,23 +326,22 @@ void RenderProcessor::processBlock(juce::AudioBuffer<float>& buffer,
   // buffer.
   updateBinauralLoudness(binauralMixBuffer_);
 
-  buffer.clear();
+  buffer.clear(startSample, numSamples);
 
   // If the playback is binaural, copy the mixed binaural audio to the output
   // buffer.
   if (currentPlaybackLayout_ == Speakers::kBinaural) {
     for (int i = 0; i < binauralMixBuffer_.getNumChannels(); ++i) {
-      buffer.copyFrom(i, 0, binauralMixBuffer_, i, 0,
-                      binauralMixBuffer_.getNumSamples());
+      buffer.copyFrom(i, startSample, binauralMixBuffer_, i, 0, numSamples);
     }
   }
   // Otherwise copy the mixed beds audio to the output buffer.
   else {
     for (int i = 0; i < mixBuffer_.getNumChannels(); ++i) {
-      buffer.copyFrom(i, 0, mixBuffer_, i, 0, mixBuffer_.getNumSamples());
+      buffer.copyFrom(i, startSample, mixBuffer_, i, 0, numSamples);
     }
   }
-  buffer.applyGain(mixPresentationGain_);
+  buffer.applyGain(startSample, numSamples, mixPresentationGain_);
 }
 
 void RenderProcessor::updateBinauralLoudness(
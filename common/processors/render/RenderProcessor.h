@@ -62,11 +62,13 @@ struct AudioElementRenderer {
   AudioElementRenderer(Speakers::AudioElementSpeakerLayout inputLayout,
                        Speakers::AudioElementSpeakerLayout playbackLayout,
                        int firstInputChannel, int samplesPerBlock,
-                       int sampleRate, bool isBinaural = true);
+                       int sampleRate, bool isBinaural = true,
+                       bool bufferBlocks = false);
 };
 
 //==============================================================================
-class RenderProcessor final : public ProcessorBase, juce::ValueTree::Listener {
+class RenderProcessor final : public ProcessorBase,
+                              public RepositoryTransactionListener {
  public:
   //==============================================================================
   RenderProcessor(ProcessorBase* hostProc, RoomSetupRepository* roomSetupData,
@@ -131,6 +133,13 @@ class RenderProcessor final : public ProcessorBase, juce::ValueTree::Listener {
     }
   }
 
+  // A transaction may have made any of the changes above, so rebuild once
+  void repositoryTransactionCommitted(juce::ValueTree& state) override {
+    juce::ignoreUnused(state);
+    activeMixID_ = activeMixPresData_->get().getActiveMixId();
+    initializeRenderers();
+  }
+
   //==============================================================================
 
   std::vector<AudioElementRenderer*> getAudioElementRenderers() {
@@ -139,15 +148,28 @@ class RenderProcessor final : public ProcessorBase, juce::ValueTree::Listener {
 
   int getSpeakersOut() { return speakersOut_; }
 
+  // Buffers binaural rendering into prepared blocks, delaying the binaural
+  // output by a block. Defaults to whether the host varies its block size.
+  void setBufferBlocks(bool bufferBlocks);
+
  public:
   void reinitializeAfterStateRestore() { initializeRenderers(); }
 
  private:
   void initializeRenderers();
+  // Reports the latency of the renderers for the current playback layout.
+  // Called when the renderers are created, never while processing.
+  void updateLatency();
 
  private:
   void mixRenderedAudio(const bool mixFromBinaural, const int numSourceChannels,
                         juce::AudioBuffer<float>& outputBuffer);
+  // Renders numSamples of the buffer from startSample, at most
+  // currentSamplesPerBlock_, in place.
+  void renderBlock(juce::AudioBuffer<float>& buffer, int startSample,
+                   int numSamples);
+  // Sizes the internal buffers to numSamples within their allocations.
+  void setInternalBlockSize(int numSamples);
   void updateBinauralLoudness(juce::AudioBuffer<float>& rdrdAudio);
 
   juce::AudioParameterFloatAttributes initParameterAttributes(
@@ -176,6 +198,7 @@ class RenderProcessor final : public ProcessorBase, juce::ValueTree::Listener {
   int currentSampleRate_ = 48000;
   int speakersOut_;
   float mixPresentationGain_ = 1.f;
+  bool bufferBlocks_ = hostVariesBlockSize();
 
   //==============================================================================
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RenderProcessor)
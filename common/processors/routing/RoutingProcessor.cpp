@@ -17,15 +17,22 @@
 #include <unistd.h>
 
 #include "data_structures/src/AudioElementPluginSyncClient.h"
+#include "logger/logger.h"
 
 RoutingProcessor::RoutingProcessor(
     AudioElementSpatialLayoutRepository* audioElementSpatialLayoutRepository,
-    AudioElementPluginSyncClient* syncClient, int totalChannelCount)
+    AudioElementPluginSyncClient* syncClient, int totalChannelCount,
+    ProcessorBase* hostProc)
     : audioElementSpatialLayoutData_(audioElementSpatialLayoutRepository),
       syncClient_(syncClient),
       firstChannel_(0),
       totalChannels_(0),
-      totalChannelCount_(totalChannelCount) {
+      totalChannelCount_(totalChannelCount),
+      hostProcessor_(hostProc) {
+  if (hostProcessor_ != nullptr) {
+    sharedAudioBus_ = std::make_unique<SharedAudioBusWriter>();
+  }
+
   // Register ourselves to listen for updates to the AudioElementSpatialLayout
   // and/or audio element data
   audioElementSpatialLayoutData_->registerListener(this);
@@ -40,8 +47,8 @@ RoutingProcessor::~RoutingProcessor() {
 }
 
 void RoutingProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
-  juce::ignoreUnused(sampleRate);
-  copyBuffer_.setSize(totalChannelCount_, samplesPerBlock);
+  juce::ignoreUnused(sampleRate, samplesPerBlock);
+  oversizedBlockLogged_ = false;
 }
 
 void RoutingProcessor::initializeRouting() {
@@ -55,23 +62,82 @@ void RoutingProcessor::initializeRouting() {
 
   firstChannel_ = audioElement->getFirstChannel();
   totalChannels_ = audioElement->getChannelCount();
+
+  const juce::SpinLock::ScopedLockType lock(audioElementIdLock_);
+  audioElementId_ = audioElementId;
+}
+
+void RoutingProcessor::writeSharedAudioBus(
+    const juce::AudioBuffer<float>& buffer) {
+  if (sharedAudioBus_ == nullptr || !sharedAudioBus_->isAvailable()) {
+    return;
+  }
+
+  // The renderer only reads the channels the host bus can't carry
+  if (firstChannel_ + totalChannels_ <= totalChannelCount_) {
+    return;
+  }
+
+  if (buffer.getNumSamples() > SharedAudioBlock::kMaxSamples) {
+    if (!oversizedBlockLogged_) {
+      oversizedBlockLogged_ = true;
+      LOG_WARNING(0,
+                  "Shared audio bus: host block exceeds the bus block size, "
+                  "channels beyond the host bus are not sent");
+    }
+    return;
+  }
+
+  // Blocks are only aligned with the renderer's while the transport runs
+  juce::AudioPlayHead* playHead = hostProcessor_->getPlayHead();
+  if (playHead == nullptr) {
+    return;
+  }
+  const auto position = playHead->getPosition();
+  if (!position.hasValue() || !position->getIsPlaying() ||
+      !position->getTimeInSamples().hasValue()) {
+    return;
+  }
+
+  const juce::SpinLock::ScopedTryLockType lock(audioElementIdLock_);
+  if (!lock.isLocked() || audioElementId_.isNull()) {
+    return;
+  }
+  sharedAudioBus_->write(audioElementId_, buffer,
+                         std::min<int>(totalChannels_, buffer.getNumChannels()),
+                         *position->getTimeInSamples());
 }
 
 void RoutingProcessor::processBlock(juce::AudioBuffer<float>& buffer,
                                     juce::MidiBuffer& midiMessages) {
-  copyBuffer_.clear();
-
-  // Copy data from the input channels to copy buffer, shifting the
-  // audio forward by the first channel
-  for (int channel = 0; channel < totalChannels_; ++channel) {
-    if (channel + firstChannel_ <= buffer.getNumChannels()) {
-      copyBuffer_.copyFrom(channel + firstChannel_, 0, buffer, channel, 0,
-                           buffer.getNumSamples());
+  // Channels of the element beyond the host bus reach the renderer over the
+  // shared bus, the rest over the host bus copy below
+  writeSharedAudioBus(buffer);
+
+  const int numChannels = std::min(buffer.getNumChannels(), totalChannelCount_);
+  const int numSamples = buffer.getNumSamples();
+  const int firstChannel = std::max(0, firstChannel_.load());
+  const int lastChannel =
+      std::min(numChannels, firstChannel + std::max(0, totalChannels_.load()));
+
+  // Shift the element's channels forward by the first channel in place. The
+  // source and destination ranges overlap when the shift is smaller than the
+  // channel count, so move the highest channel first
+  if (firstChannel > 0) {
+    for (int channel = lastChannel - 1; channel >= firstChannel; --channel) {
+      const float* source = buffer.getReadPointer(channel - firstChannel);
+      juce::FloatVectorOperations::copy(buffer.getWritePointer(channel), source,
+                                        numSamples);
     }
   }
 
-  // Now copy the data back to the original buffer
-  // We can't copy in place because JUCE doesn't let you copy between the same
-  // buffer
-  buffer.makeCopyOf(copyBuffer_);
+  // Clear everything outside the element's channels
+  const int clearedBelow = std::min(firstChannel, buffer.getNumChannels());
+  for (int channel = 0; channel < clearedBelow; ++channel) {
+    buffer.clear(channel, 0, numSamples);
+  }
+  for (int channel = std::max(lastChannel, clearedBelow);
+       channel < buffer.getNumChannels(); ++channel) {
+    buffer.clear(channel, 0, numSamples);
+  }
 }
\ No newline at end of file
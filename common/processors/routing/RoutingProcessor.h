@@ -21,6 +21,7 @@
 #include "data_repository/implementation/AudioElementSpatialLayoutRepository.h"
 #include "data_structures/src/AudioElementPluginSyncClient.h"
 #include "data_structures/src/AudioElementSpatialLayout.h"
+#include "data_structures/src/SharedAudioBus.h"
 
 //==============================================================================
 class RoutingProcessor final : public ProcessorBase,
@@ -28,9 +29,12 @@ class RoutingProcessor final : public ProcessorBase,
                                AudioElementPluginListener {
  public:
   //==============================================================================
+  // When a host processor is given, an element extending beyond the host bus
+  // is also written to the shared audio bus at the host's sample position.
   RoutingProcessor(
       AudioElementSpatialLayoutRepository* AudioElementSpatialLayoutRepository,
-      AudioElementPluginSyncClient* syncClient, int totalChannelCount);
+      AudioElementPluginSyncClient* syncClient, int totalChannelCount,
+      ProcessorBase* hostProc = nullptr);
   ~RoutingProcessor() override;
 
   //==============================================================================
@@ -75,6 +79,7 @@ class RoutingProcessor final : public ProcessorBase,
 
  private:
   void initializeRouting();
+  void writeSharedAudioBus(const juce::AudioBuffer<float>& buffer);
 
  private:
   AudioElementSpatialLayoutRepository* audioElementSpatialLayoutData_;
@@ -84,7 +89,13 @@ class RoutingProcessor final : public ProcessorBase,
   std::atomic_int firstChannel_;
   std::atomic_int totalChannels_;
   const int totalChannelCount_;
-  juce::AudioBuffer<float> copyBuffer_;
+
+  ProcessorBase* hostProcessor_;
+  std::unique_ptr<SharedAudioBusWriter> sharedAudioBus_;
+  juce::SpinLock audioElementIdLock_;
+  juce::Uuid audioElementId_;
+  // Blocks larger than the bus carries are logged once per prepareToPlay
+  bool oversizedBlockLogged_ = false;
 
   //==============================================================================
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RoutingProcessor)
@@ -0,0 +1,146 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SharedAudioBusProcessor.h"
+
+#include "logger/logger.h"
+
+SharedAudioBusProcessor::SharedAudioBusProcessor(
+    ProcessorBase* hostProc, AudioElementRepository* audioElementData)
+    : hostProcessor_(hostProc), audioElementData_(audioElementData) {
+  audioElementData_->registerListener(this);
+  initializeRoutes();
+}
+
+SharedAudioBusProcessor::~SharedAudioBusProcessor() {
+  audioElementData_->deregisterListener(this);
+}
+
+void SharedAudioBusProcessor::prepareToPlay(double sampleRate,
+                                            int samplesPerBlock) {
+  juce::ignoreUnused(sampleRate, samplesPerBlock);
+  // Room for any block the bus carries, as hosts may pass larger blocks than
+  // prepared
+  scratchBuffer_.setSize(SharedAudioBlock::kMaxChannels,
+                         SharedAudioBlock::kMaxSamples);
+  oversizedBlockLogged_ = false;
+  // A state restored before playback is picked up here
+  initializeRoutes();
+}
+
+void SharedAudioBusProcessor::initializeRoutes() {
+  // Most notifications leave the audio elements as they were
+  const auto snapshot = audioElementData_->getSnapshot();
+  if (snapshot->version == routesVersion_) {
+    return;
+  }
+  routesVersion_ = snapshot->version;
+
+  std::vector<Route> routes;
+  routes.reserve(snapshot->items.size());
+  for (const AudioElement& audioElement : snapshot->items) {
+    routes.push_back({audioElement.getId(), audioElement.getFirstChannel(),
+                      audioElement.getChannelCount()});
+  }
+
+  const juce::SpinLock::ScopedLockType lock(routesLock_);
+  routes_.swap(routes);
+}
+
+bool SharedAudioBusProcessor::getSamplePosition(int64_t& samplePosition) {
+  juce::AudioPlayHead* playHead = hostProcessor_->getPlayHead();
+  if (playHead == nullptr) {
+    samplePosition = samplePosition_;
+    return samplePosition >= 0;
+  }
+
+  // A stopped transport repeats the same position every block, so blocks can
+  // only be aligned while playing
+  const auto position = playHead->getPosition();
+  if (!position.hasValue() || !position->getIsPlaying() ||
+      !position->getTimeInSamples().hasValue()) {
+    return false;
+  }
+  samplePosition = *position->getTimeInSamples();
+  return true;
+}
+
+void SharedAudioBusProcessor::readBeyondHostBus(
+    const SharedAudioBusTable& table, const Route& route,
+    const int64_t samplePosition, const int hostChannels,
+    juce::AudioBuffer<float>& buffer) {
+  // The whole element is read, as blocks are matched on their channel count
+  const int numSamples = buffer.getNumSamples();
+  scratchBuffer_.setSize(SharedAudioBlock::kMaxChannels, numSamples, false,
+                         false, true);
+  if (!table.read(route.audioElementId, samplePosition, scratchBuffer_, 0,
+                  route.numChannels)) {
+    return;
+  }
+  for (int ch = std::max(0, hostChannels - route.firstChannel);
+       ch < route.numChannels; ++ch) {
+    buffer.copyFrom(route.firstChannel + ch, 0, scratchBuffer_, ch, 0,
+                    numSamples);
+  }
+}
+
+void SharedAudioBusProcessor::processBlock(juce::AudioBuffer<float>& buffer,
+                                           juce::MidiBuffer& midiMessages) {
+  juce::ignoreUnused(midiMessages);
+
+  // Channels beyond the host bus only carry audio read from the shared bus
+  const int hostChannels =
+      std::min(hostProcessor_->getTotalNumInputChannels(),
+               buffer.getNumChannels());
+  for (int ch = hostChannels; ch < buffer.getNumChannels(); ++ch) {
+    buffer.clear(ch, 0, buffer.getNumSamples());
+  }
+  if (hostChannels == buffer.getNumChannels()) {
+    return;
+  }
+
+  SharedAudioBusTable* table = bus_.getTable();
+  int64_t samplePosition = 0;
+  if (table == nullptr || !getSamplePosition(samplePosition)) {
+    return;
+  }
+
+  // Plugins don't write blocks larger than the bus carries, so elements beyond
+  // the host bus are silent for them. Mostly seen in offline renders.
+  if (buffer.getNumSamples() > SharedAudioBlock::kMaxSamples) {
+    if (!oversizedBlockLogged_) {
+      oversizedBlockLogged_ = true;
+      LOG_WARNING(0,
+                  "Shared audio bus: host block exceeds the bus block size, "
+                  "audio elements beyond the host bus are silent");
+    }
+    return;
+  }
+
+  // Don't wait on the message thread while it rebuilds the routes
+  const juce::SpinLock::ScopedTryLockType lock(routesLock_);
+  if (!lock.isLocked()) {
+    return;
+  }
+
+  for (const Route& route : routes_) {
+    if (route.firstChannel < 0 ||
+        route.numChannels > SharedAudioBlock::kMaxChannels ||
+        route.firstChannel + route.numChannels > buffer.getNumChannels() ||
+        route.firstChannel + route.numChannels <= hostChannels) {
+      continue;
+    }
+    readBeyondHostBus(*table, route, samplePosition, hostChannels, buffer);
+  }
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "../processor_base/ProcessorBase.h"
+#include "data_repository/implementation/AudioElementRepository.h"
+#include "data_structures/src/SharedAudioBus.h"
+
+//==============================================================================
+// Pulls audio element audio from the shared audio bus into the renderer's
+// processing buffer, for the channels of elements placed beyond the host bus
+// width. Channels the host bus carries always keep the host's audio, which
+// has been through the track's fader and mute. Beyond the host bus, channels
+// without a block written for the current host sample position are silent.
+class SharedAudioBusProcessor final : public ProcessorBase,
+                                      juce::ValueTree::Listener {
+ public:
+  //==============================================================================
+  SharedAudioBusProcessor(ProcessorBase* hostProc,
+                          AudioElementRepository* audioElementData);
+  ~SharedAudioBusProcessor() override;
+
+  //==============================================================================
+  void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+  using AudioProcessor::processBlock;
+
+  void prepareToPlay(double sampleRate, int samplesPerBlock) override;
+
+  //==============================================================================
+  const juce::String getName() const override { return "Shared Audio Bus"; }
+
+  //==============================================================================
+  void valueTreePropertyChanged(juce::ValueTree& treeWhosePropertyHasChanged,
+                                const juce::Identifier& property) override {
+    initializeRoutes();
+  }
+  void valueTreeChildAdded(juce::ValueTree& parentTree,
+                           juce::ValueTree& childWhichHasBeenAdded) override {
+    initializeRoutes();
+  }
+  void valueTreeChildRemoved(juce::ValueTree& parentTree,
+                             juce::ValueTree& childWhichHasBeenRemoved,
+                             int indexFromWhichChildWasRemoved) override {
+    initializeRoutes();
+  }
+
+  void reinitializeAfterStateRestore() { initializeRoutes(); }
+
+  // Read blocks written for this sample position. Used when there is no host
+  // play head to align with.
+  void setSamplePosition(int64_t samplePosition) {
+    samplePosition_ = samplePosition;
+  }
+
+ private:
+  struct Route {
+    juce::Uuid audioElementId;
+    int firstChannel;
+    int numChannels;
+  };
+
+  void initializeRoutes();
+  bool getSamplePosition(int64_t& samplePosition);
+  // Reads the route's channels beyond the host bus, which are left silent if
+  // no block was written for the position.
+  void readBeyondHostBus(const SharedAudioBusTable& table, const Route& route,
+                         int64_t samplePosition, int hostChannels,
+                         juce::AudioBuffer<float>& buffer);
+
+  ProcessorBase* hostProcessor_;
+  AudioElementRepository* audioElementData_;
+  SharedAudioBus bus_;
+  juce::SpinLock routesLock_;
+  std::vector<Route> routes_;
+  uint64_t routesVersion_ = 0;
+  juce::AudioBuffer<float> scratchBuffer_;
+  int64_t samplePosition_ = -1;
+  // Blocks larger than the bus carries are logged once per prepareToPlay
+  bool oversizedBlockLogged_ = false;
+
+  //==============================================================================
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SharedAudioBusProcessor)
+};
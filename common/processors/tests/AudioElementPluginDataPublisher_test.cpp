@@ -0,0 +1,173 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../audioelementplugin_publisher/AudioElementPluginDataPublisher.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "substream_rdr/substream_rdr_utils/Speakers.h"
+
+using namespace std::chrono_literals;
+
+namespace {
+class DummyHostProcessor final : public ProcessorBase {
+ public:
+  void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override {}
+};
+
+// Records what the publisher sends
+class PublishRecorder {
+ public:
+  void publish(const AudioElementUpdateData& data) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    published_.push_back({data, std::chrono::steady_clock::now()});
+    condition_.notify_all();
+  }
+
+  // Waits until there are at least the given number of updates
+  bool waitFor(const size_t count, const std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return condition_.wait_for(lock, timeout,
+                               [&] { return published_.size() >= count; });
+  }
+
+  size_t getCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return published_.size();
+  }
+
+  AudioElementUpdateData getLast() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return published_.back().data;
+  }
+
+  std::chrono::steady_clock::time_point getLastTime() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return published_.back().time;
+  }
+
+ private:
+  struct Update {
+    AudioElementUpdateData data;
+    std::chrono::steady_clock::time_point time;
+  };
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::vector<Update> published_;
+};
+
+// A publisher for a stereo element, publishing to a recorder
+class test_data_publisher : public ::testing::Test {
+ protected:
+  test_data_publisher()
+      : layoutRepository_(juce::ValueTree{"audio_element_spatial_layout"}),
+        parameterTree_(host_) {
+    AudioElementSpatialLayout layout = layoutRepository_.get();
+    layout.setName("Publisher test");
+    layout.setLayout(Speakers::kStereo);
+    layoutRepository_.update(layout);
+  }
+
+  std::unique_ptr<AudioElementPluginDataPublisher> makePublisher(
+      const float publishRateHz = 200.f) {
+    return std::make_unique<AudioElementPluginDataPublisher>(
+        &layoutRepository_, &parameterTree_, publishRateHz,
+        [this](const AudioElementUpdateData& data) {
+          recorder_.publish(data);
+        });
+  }
+
+  // Feeds a block whose loudness is the given level in dB
+  static void processLevel(AudioElementPluginDataPublisher& publisher,
+                           const float levelDb) {
+    juce::AudioBuffer<float> buffer(2, 480);
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch) {
+      juce::FloatVectorOperations::fill(
+          buffer.getWritePointer(ch),
+          juce::Decibels::decibelsToGain(levelDb), buffer.getNumSamples());
+    }
+    juce::MidiBuffer midi;
+    publisher.processBlock(buffer, midi);
+  }
+
+  DummyHostProcessor host_;
+  AudioElementSpatialLayoutRepository layoutRepository_;
+  AudioElementParameterTree parameterTree_;
+  PublishRecorder recorder_;
+};
+}  // namespace
+
+TEST_F(test_data_publisher, small_loudness_changes_are_suppressed) {
+  auto publisher = makePublisher();
+  // The initial state is published right away
+  ASSERT_TRUE(recorder_.waitFor(1, 500ms));
+
+  processLevel(*publisher, -20.f);
+  ASSERT_TRUE(recorder_.waitFor(2, 500ms));
+  EXPECT_NEAR(recorder_.getLast().loudness, -20.f, 0.01f);
+
+  // Below the threshold, so nothing is sent before the heartbeat
+  const size_t count = recorder_.getCount();
+  processLevel(*publisher,
+               -20.f + AudioElementPluginDataPublisher::kLoudnessThresholdDb /
+                           2.f);
+  std::this_thread::sleep_for(300ms);
+  EXPECT_EQ(recorder_.getCount(), count);
+
+  processLevel(*publisher, -19.f);
+  ASSERT_TRUE(recorder_.waitFor(count + 1, 500ms));
+  EXPECT_NEAR(recorder_.getLast().loudness, -19.f, 0.01f);
+}
+
+TEST_F(test_data_publisher, unchanged_state_is_republished_as_heartbeat) {
+  auto publisher = makePublisher();
+  ASSERT_TRUE(recorder_.waitFor(1, 500ms));
+  processLevel(*publisher, -20.f);
+  ASSERT_TRUE(recorder_.waitFor(2, 500ms));
+  const AudioElementUpdateData last = recorder_.getLast();
+  const auto lastTime = recorder_.getLastTime();
+
+  const auto interval = std::chrono::milliseconds(
+      AudioElementPluginDataPublisher::kHeartbeatIntervalMs);
+  ASSERT_TRUE(recorder_.waitFor(3, interval + 500ms));
+  // Not before the interval, give or take a publish period
+  EXPECT_GE(recorder_.getLastTime() - lastTime, interval - 10ms);
+  const AudioElementUpdateData heartbeat = recorder_.getLast();
+  EXPECT_EQ(heartbeat.loudness, last.loudness);
+  EXPECT_EQ(heartbeat.uuid, last.uuid);
+  EXPECT_STREQ(heartbeat.name, "Publisher test");
+}
+
+TEST_F(test_data_publisher, shutdown_joins_sender) {
+  // A slow rate, so the sender is waiting out its period when stopped
+  auto publisher = makePublisher(1.f);
+  processLevel(*publisher, -20.f);
+
+  const auto start = std::chrono::steady_clock::now();
+  publisher.reset();
+  EXPECT_LT(std::chrono::steady_clock::now() - start, 500ms);
+
+  // Nothing is published once the publisher is gone
+  const size_t count = recorder_.getCount();
+  std::this_thread::sleep_for(1200ms);
+  EXPECT_EQ(recorder_.getCount(), count);
+}
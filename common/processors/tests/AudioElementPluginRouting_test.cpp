@@ -212,4 +212,53 @@ TEST(test_routing_processor, test_full_shift) {
       }
     }
   }
-}
\ No newline at end of file
+}
+
+TEST(test_routing_processor, test_overlapping_shift_in_place) {
+  // A four channel element shifted by one channel overlaps its own input
+  AudioElement audioElement(juce::Uuid(), "Test", Speakers::kHOA1, 1);
+  AudioElementRepository audio_element_repository(juce::ValueTree{"test"});
+  audio_element_repository.add(audioElement);
+
+  AudioElementSpatialLayoutRepository audioElementSpatialLayout_repository(
+      juce::ValueTree{"audioElementSpatialLayout_test"});
+  AudioElementSpatialLayout val = audioElementSpatialLayout_repository.get();
+  val.setAudioElementId(audioElement.getId());
+  val.setFirstChannel(0);
+  val.setLayout(audioElement.getChannelConfig());
+  val.setName("TestAudioElementSpatialLayout");
+  audioElementSpatialLayout_repository.update(val);
+
+  TestAudioElementPluginSyncClient sync_client(
+      &audioElementSpatialLayout_repository, 0);
+  sync_client.setAudioElementRepositoryForTesting(audio_element_repository);
+
+  RoutingProcessor routing_processor(&audioElementSpatialLayout_repository,
+                                     &sync_client, 36);
+
+  // Channels 0-3 hold 1-4, the rest hold leftover audio that must be cleared
+  juce::AudioBuffer<float> audio_buffer(10, 10);
+  for (int i = 0; i < 10; i++) {
+    for (int j = 0; j < 10; j++) {
+      audio_buffer.setSample(i, j, i < 4 ? i + 1 : 9.0f);
+    }
+  }
+  const float* firstChannelData = audio_buffer.getReadPointer(0);
+
+  routing_processor.prepareToPlay(10, 10);
+  juce::MidiBuffer midi_buffer;
+  routing_processor.processBlock(audio_buffer, midi_buffer);
+
+  // Routed in place without resizing the buffer
+  EXPECT_EQ(audio_buffer.getNumChannels(), 10);
+  EXPECT_EQ(audio_buffer.getReadPointer(0), firstChannelData);
+  for (int i = 0; i < 10; i++) {
+    for (int j = 0; j < 10; j++) {
+      if (i >= 1 && i < 5) {
+        ASSERT_EQ(audio_buffer.getSample(i, j), i);
+      } else {
+        ASSERT_EQ(audio_buffer.getSample(i, j), 0.0f);
+      }
+    }
+  }
+}
@@ -0,0 +1,84 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../gain/ChannelGainStage.h"
+
+#include <gtest/gtest.h>
+
+namespace {
+juce::AudioBuffer<float> makeBuffer(const int numChannels,
+                                    const int numSamples) {
+  juce::AudioBuffer<float> buffer(numChannels, numSamples);
+  for (int ch = 0; ch < numChannels; ++ch) {
+    juce::FloatVectorOperations::fill(buffer.getWritePointer(ch), 0.5f,
+                                      numSamples);
+  }
+  return buffer;
+}
+}  // namespace
+
+TEST(test_channel_gain_stage, applies_settled_gains) {
+  // Unprepared, gain changes apply immediately
+  ChannelGainStage stage(3);
+  stage.setTargetGain(1, 0.f);
+  stage.setTargetGain(2, 2.f);
+
+  // The fourth channel has no gain and is left as it is
+  juce::AudioBuffer<float> buffer = makeBuffer(4, 16);
+  stage.process(buffer);
+  for (int i = 0; i < 16; ++i) {
+    ASSERT_EQ(buffer.getSample(0, i), 0.5f);
+    ASSERT_EQ(buffer.getSample(1, i), 0.f);
+    ASSERT_EQ(buffer.getSample(2, i), 1.f);
+    ASSERT_EQ(buffer.getSample(3, i), 0.5f);
+  }
+}
+
+TEST(test_channel_gain_stage, ramps_across_blocks) {
+  // A 10 sample ramp, built 4 samples at a time and spread over 3 blocks
+  ChannelGainStage stage(2, 0.01);
+  stage.prepare(1000., 4);
+  stage.setTargetGain(0, 0.f);
+
+  std::vector<float> out;
+  for (const int blockSize : {3, 4, 8}) {
+    juce::AudioBuffer<float> buffer = makeBuffer(2, blockSize);
+    stage.process(buffer);
+    for (int i = 0; i < blockSize; ++i) {
+      out.push_back(buffer.getSample(0, i));
+      ASSERT_EQ(buffer.getSample(1, i), 0.5f);
+    }
+  }
+
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_NEAR(out[i], 0.5f * (1.f - 0.1f * (i + 1)), 1e-6f);
+  }
+  for (int i = 10; i < static_cast<int>(out.size()); ++i) {
+    ASSERT_EQ(out[i], 0.f);
+  }
+  ASSERT_FALSE(stage.isRamping(0));
+  ASSERT_EQ(stage.getCurrentGain(0), 0.f);
+}
+
+TEST(test_channel_gain_stage, reset_skips_ramp) {
+  ChannelGainStage stage(1, 0.01);
+  stage.prepare(48000., 512);
+  stage.setTargetGain(0, 2.f);
+  ASSERT_TRUE(stage.isRamping(0));
+  stage.reset();
+
+  juce::AudioBuffer<float> buffer = makeBuffer(1, 8);
+  stage.process(buffer);
+  ASSERT_EQ(buffer.getSample(0, 0), 1.f);
+}
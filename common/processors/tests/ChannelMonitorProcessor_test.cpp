@@ -63,4 +63,51 @@ TEST(test_channelmonitor_processor, test_getPrerdrLoudness) {
     // Channels with value 0.5 have a rough dB value of -6
     ASSERT_NEAR(channelLoudnessesRead[i], -6.0f, 0.1);
   }
+}
+
+TEST(test_channelmonitor_processor, transaction_syncs_solo_mute) {
+  ChannelMonitorData channelMonitorData;
+  MixPresentationRepository mixPresentationRepository(
+      juce::ValueTree("mixPresentation"));
+  MixPresentationSoloMuteRepository mixPresentationSoloMuteRepository(
+      juce::ValueTree("mixPresentationSoloMute"));
+  ChannelMonitorProcessor channelMonitorProcessor(
+      channelMonitorData, &mixPresentationRepository,
+      &mixPresentationSoloMuteRepository);
+
+  // Add a mix presentation along with its audio element in one action
+  const juce::Uuid firstElement;
+  MixPresentation presentation(juce::Uuid(), "English Mix", 1,
+                               LanguageData::MixLanguages::English, {});
+  {
+    auto transaction = mixPresentationRepository.beginTransaction();
+    mixPresentationRepository.add(presentation);
+    presentation.addAudioElement(firstElement, 1, "First");
+    mixPresentationRepository.update(presentation);
+  }
+  std::optional<MixPresentationSoloMute> soloMute =
+      mixPresentationSoloMuteRepository.get(presentation.getId());
+  ASSERT_TRUE(soloMute.has_value());
+  ASSERT_EQ(soloMute->getAudioElements().size(), 1u);
+
+  // Solo/mute state of elements still in the mix survives later changes
+  soloMute->setAudioElementMute(firstElement, true);
+  mixPresentationSoloMuteRepository.update(*soloMute);
+  const juce::Uuid secondElement;
+  {
+    auto transaction = mixPresentationRepository.beginTransaction();
+    presentation.addAudioElement(secondElement, 1, "Second");
+    mixPresentationRepository.update(presentation);
+  }
+  soloMute = mixPresentationSoloMuteRepository.get(presentation.getId());
+  ASSERT_EQ(soloMute->getAudioElements().size(), 2u);
+  EXPECT_TRUE(soloMute->isAudioElementMuted(firstElement));
+  EXPECT_FALSE(soloMute->isAudioElementMuted(secondElement));
+
+  {
+    auto transaction = mixPresentationRepository.beginTransaction();
+    mixPresentationRepository.remove(presentation);
+  }
+  EXPECT_FALSE(mixPresentationSoloMuteRepository.get(presentation.getId())
+                   .has_value());
 }
\ No newline at end of file
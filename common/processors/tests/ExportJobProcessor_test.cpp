@@ -0,0 +1,271 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "processors/file_output/ExportJobProcessor.h"
+
+#include <gtest/gtest.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "data_repository/implementation/ActiveMixPresentationRepository.h"
+#include "data_repository/implementation/AudioElementRepository.h"
+#include "data_repository/implementation/ExportJobRepository.h"
+#include "data_repository/implementation/FileExportRepository.h"
+#include "data_repository/implementation/MixPresentationRepository.h"
+#include "substream_rdr/rdr_factory/RendererFactory.h"
+#include "substream_rdr/substream_rdr_utils/Speakers.h"
+
+const int kSampleRate = 48000;
+const int kSamplesPerBlock = 128;
+
+class test_export_job_proc : public ::testing::Test {
+ protected:
+  test_export_job_proc()
+      : testState("test_state"),
+        fileExportRepository(
+            testState.getOrCreateChildWithName("file", nullptr)),
+        audioElementRepository(
+            testState.getOrCreateChildWithName("element", nullptr)),
+        mixRepository(testState.getOrCreateChildWithName("mix", nullptr)),
+        activeMixRepository(
+            testState.getOrCreateChildWithName("active_mix", nullptr)) {
+    FileExport ex = fileExportRepository.get();
+    ex.setExportAudio(true);
+    ex.setSampleRate(kSampleRate);
+    fileExportRepository.update(ex);
+
+    // Add a stereo audio element to the active mix presentation.
+    AudioElement ae(juce::Uuid(), "Audio Element", Speakers::kStereo, 0);
+    audioElementRepository.add(ae);
+    MixPresentation mp(juce::Uuid(), "Mix Presentation", 1.f);
+    mp.addAudioElement(ae.getId(), 1.f, ae.getName());
+    mixRepository.add(mp);
+    activeMixRepository.update(mp.getId());
+  }
+
+  juce::File addJob(Speakers::AudioElementSpeakerLayout layout,
+                    const juce::String& name) {
+    juce::File out = juce::File::getCurrentWorkingDirectory().getChildFile(
+        name + ".wav");
+    out.deleteFile();
+    getExportJobRepository(fileExportRepository)
+        .add(ExportJob(juce::Uuid(), layout, out.getFullPathName(), 24));
+    return out;
+  }
+
+  // Distinct signals on the left and right channels of the stereo element, so
+  // a layout that mixes them up does not match.
+  static void fillBlock(juce::AudioBuffer<float>& buffer,
+                        const int firstSample) {
+    buffer.clear();
+    for (int s = 0; s < buffer.getNumSamples(); ++s) {
+      const float t = (float)(firstSample + s) / kSampleRate;
+      buffer.setSample(0, s, 0.5f * std::sin(2 * M_PI * 440 * t));
+      buffer.setSample(1, s, 0.25f * std::sin(2 * M_PI * 1000 * t));
+    }
+  }
+
+  // Bounces numBlocks prepared blocks, passed by the host in blocks of
+  // hostBlockSize samples.
+  void bounce(ExportJobProcessor& proc, const int numBlocks,
+              const int hostBlockSize = kSamplesPerBlock) {
+    juce::AudioBuffer<float> buffer(
+        ProcessorBase::getHostWideLayout().size(), hostBlockSize);
+    juce::MidiBuffer midi;
+    proc.prepareToPlay(kSampleRate, kSamplesPerBlock);
+    proc.setNonRealtime(true);
+    for (int start = 0; start < numBlocks * kSamplesPerBlock;
+         start += hostBlockSize) {
+      fillBlock(buffer, start);
+      proc.processBlock(buffer, midi);
+    }
+    proc.setNonRealtime(false);
+  }
+
+  // Renders the stereo element to the given layout and applies the mix gain,
+  // the way the job is expected to.
+  static juce::AudioBuffer<float> renderExpected(
+      const Speakers::AudioElementSpeakerLayout layout, const float mixGain,
+      const int numBlocks) {
+    std::unique_ptr<Renderer> renderer = createRenderer(
+        Speakers::kStereo, layout, kSamplesPerBlock, kSampleRate);
+    juce::AudioBuffer<float> block(
+        ProcessorBase::getHostWideLayout().size(), kSamplesPerBlock);
+    juce::AudioBuffer<float> input(Speakers::kStereo.getNumChannels(),
+                                   kSamplesPerBlock);
+    juce::AudioBuffer<float> output(layout.getNumChannels(), kSamplesPerBlock);
+    juce::AudioBuffer<float> expected(layout.getNumChannels(),
+                                      numBlocks * kSamplesPerBlock);
+    for (int i = 0; i < numBlocks; ++i) {
+      fillBlock(block, i * kSamplesPerBlock);
+      for (int ch = 0; ch < input.getNumChannels(); ++ch) {
+        input.copyFrom(ch, 0, block, ch, 0, kSamplesPerBlock);
+      }
+      output.clear();
+      renderer->render(input, output);
+      for (int ch = 0; ch < output.getNumChannels(); ++ch) {
+        expected.copyFrom(ch, i * kSamplesPerBlock, output, ch, 0,
+                          kSamplesPerBlock);
+      }
+    }
+    expected.applyGain(mixGain);
+    return expected;
+  }
+
+  // Expects the file to hold the expected mix, then deletes it.
+  static void expectWritten(const juce::File& file,
+                            const juce::AudioBuffer<float>& expected) {
+    juce::WavAudioFormat format;
+    std::unique_ptr<juce::AudioFormatReader> reader(
+        format.createReaderFor(file.createInputStream().release(), true));
+    ASSERT_NE(reader, nullptr);
+    ASSERT_EQ(reader->numChannels, expected.getNumChannels());
+    juce::AudioBuffer<float> written(reader->numChannels,
+                                     (int)reader->lengthInSamples);
+    reader->read(&written, 0, written.getNumSamples(), 0, true, true);
+    reader.reset();
+    file.deleteFile();
+
+    ASSERT_EQ(written.getNumSamples(), expected.getNumSamples());
+    float maxRms = 0.f;
+    for (int ch = 0; ch < expected.getNumChannels(); ++ch) {
+      maxRms = std::max(maxRms,
+                        expected.getRMSLevel(ch, 0, expected.getNumSamples()));
+      for (int s = 0; s < expected.getNumSamples(); ++s) {
+        ASSERT_NEAR(written.getSample(ch, s), expected.getSample(ch, s), 1e-4f)
+            << file.getFileName() << " channel " << ch << " sample " << s;
+      }
+    }
+    // The comparison is only meaningful if the mix is not silent.
+    EXPECT_GT(maxRms, 0.f);
+  }
+
+  // Expects the file to hold the mix rendered to the layout, then deletes it.
+  static void expectRenderedMix(
+      const juce::File& file, const Speakers::AudioElementSpeakerLayout layout,
+      const float mixGain, const int numBlocks) {
+    expectWritten(file, renderExpected(layout, mixGain, numBlocks));
+  }
+
+  juce::ValueTree testState;
+  FileExportRepository fileExportRepository;
+  AudioElementRepository audioElementRepository;
+  MixPresentationRepository mixRepository;
+  ActiveMixRepository activeMixRepository;
+};
+
+// Each export job should produce its own file with its own layout from a
+// single pass.
+TEST_F(test_export_job_proc, one_pass_multiple_layouts) {
+  juce::File stereoOut = addJob(Speakers::kStereo, "job_stereo");
+  juce::File surroundOut = addJob(Speakers::k7Point1Point4, "job_7_1_4");
+
+  ExportJobProcessor proc(fileExportRepository, audioElementRepository,
+                          mixRepository, activeMixRepository);
+  const int kNumBlocks = 10;
+  bounce(proc, kNumBlocks);
+
+  juce::WavAudioFormat format;
+  for (auto [file, layout] :
+       {std::pair{stereoOut, Speakers::kStereo},
+        std::pair{surroundOut, Speakers::k7Point1Point4}}) {
+    ASSERT_TRUE(file.existsAsFile());
+    std::unique_ptr<juce::AudioFormatReader> reader(
+        format.createReaderFor(file.createInputStream().release(), true));
+    ASSERT_NE(reader, nullptr);
+    EXPECT_EQ(reader->numChannels, layout.getNumChannels());
+    EXPECT_EQ(reader->lengthInSamples, kNumBlocks * kSamplesPerBlock);
+    EXPECT_EQ(reader->bitsPerSample, 24);
+    reader.reset();
+    file.deleteFile();
+  }
+}
+
+// Each file should hold the active mix rendered to the job's layout, with the
+// mix presentation gain applied.
+TEST_F(test_export_job_proc, rendered_mix_matches_layout) {
+  const float kMixGain = 0.5f;
+  MixPresentation mp = *mixRepository.getFirst();
+  mp.setDefaultMixGain(kMixGain);
+  mixRepository.update(mp);
+
+  juce::File stereoOut = addJob(Speakers::kStereo, "job_mix_stereo");
+  juce::File surroundOut = addJob(Speakers::k5Point1, "job_mix_5_1");
+
+  ExportJobProcessor proc(fileExportRepository, audioElementRepository,
+                          mixRepository, activeMixRepository);
+  const int kNumBlocks = 4;
+  bounce(proc, kNumBlocks);
+
+  expectRenderedMix(stereoOut, Speakers::kStereo, kMixGain, kNumBlocks);
+  expectRenderedMix(surroundOut, Speakers::k5Point1, kMixGain, kNumBlocks);
+}
+
+// Offline renders may pass blocks larger than prepared. All of each block
+// should be rendered and written.
+TEST_F(test_export_job_proc, blocks_larger_than_prepared) {
+  juce::File surroundOut = addJob(Speakers::k5Point1, "job_oversized_5_1");
+
+  ExportJobProcessor proc(fileExportRepository, audioElementRepository,
+                          mixRepository, activeMixRepository);
+  const int kNumBlocks = 8;
+  bounce(proc, kNumBlocks, 4 * kSamplesPerBlock);
+
+  expectRenderedMix(surroundOut, Speakers::k5Point1, 1.f, kNumBlocks);
+}
+
+// Binaural jobs mix elements rendered binaurally with elements downmixed to
+// stereo. The file should hold the aligned mix from the first sample to the
+// last, without the latency of the binaural renderer.
+TEST_F(test_export_job_proc, binaural_mix_is_aligned) {
+  // Downmix the same signal as the binaural element, from the same channels
+  AudioElement stereoAe(juce::Uuid(), "Stereo Element", Speakers::kStereo, 0);
+  audioElementRepository.add(stereoAe);
+  MixPresentation mp = *mixRepository.getFirst();
+  mp.addAudioElement(stereoAe.getId(), 1.f, stereoAe.getName(), false);
+  mixRepository.update(mp);
+
+  juce::File binauralOut = addJob(Speakers::kBinaural, "job_binaural");
+
+  ExportJobProcessor proc(fileExportRepository, audioElementRepository,
+                          mixRepository, activeMixRepository);
+  const int kNumBlocks = 8;
+  // Blocks shorter than prepared are buffered by the binaural renderer
+  bounce(proc, kNumBlocks, kSamplesPerBlock / 2);
+
+  juce::AudioBuffer<float> expected =
+      renderExpected(Speakers::kBinaural, 1.f, kNumBlocks);
+  const juce::AudioBuffer<float> downmix =
+      renderExpected(Speakers::kStereo, 1.f, kNumBlocks);
+  for (int ch = 0; ch < expected.getNumChannels(); ++ch) {
+    expected.addFrom(ch, 0, downmix, ch, 0, expected.getNumSamples());
+  }
+  expectWritten(binauralOut, expected);
+}
+
+// Disabled jobs should not produce a file.
+TEST_F(test_export_job_proc, disabled_job) {
+  juce::File out = addJob(Speakers::kStereo, "job_disabled");
+  ExportJobRepository jobs = getExportJobRepository(fileExportRepository);
+  ExportJob job = *jobs.getFirst();
+  job.setEnabled(false);
+  jobs.update(job);
+
+  ExportJobProcessor proc(fileExportRepository, audioElementRepository,
+                          mixRepository, activeMixRepository);
+  bounce(proc, 1);
+  EXPECT_FALSE(out.existsAsFile());
+}
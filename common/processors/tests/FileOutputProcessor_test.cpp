@@ -720,4 +720,101 @@ TEST_F(FileOutputProcessorTest, iamf_flac_custom_param) {
     fileExportRepository.update(config);
     bounceExportConfig(config, "Custom OPUC bitrate: " + juce::String(i));
   }
-}
\ No newline at end of file
+}
+
+TEST_F(FileOutputProcessorTest, iamf_export_profile) {
+  setup_1ae_cb();
+  bounceExportConfig(ex, "Export for the profile failed.");
+
+  const juce::File profileFile =
+      ExportProfile::getProfileFile(ex.getExportFile());
+  std::optional<ExportProfile> profile =
+      ExportProfile::readFromFile(profileFile);
+  ASSERT_TRUE(profile.has_value());
+  EXPECT_GT(profile->samplesWritten, 0);
+  EXPECT_GT(profile->bounceWallSeconds, 0.0);
+  EXPECT_GT(profile->encodeWallSeconds, 0.0);
+  EXPECT_GT(profile->outputBytes, 0);
+  EXPECT_EQ(profile->elements.size(), audioElementRepository.getItemCount());
+  for (const ExportProfile::ElementBytes& element : profile->elements) {
+    EXPECT_GT(element.bytes, 0);
+  }
+  profileFile.deleteFile();
+}
+
+// The export range is trimmed to the exact sample, even when the block size
+// does not divide the sample rate, and skipped lead-in blocks are counted.
+TEST_F(FileOutputProcessorTest, iamf_sample_accurate_range) {
+  setup_1ae_cb();
+  ex.setStartTime(1);
+  ex.setEndTime(2);
+  fileExportRepository.update(ex);
+
+  const int kBlockSize = 1024;
+  fio_proc.prepareToPlay(kSampleRate, kBlockSize);
+  fio_proc.setNonRealtime(true);
+
+  juce::AudioBuffer<float> buffer(2, kBlockSize);
+  juce::MidiBuffer midi;
+  const int kSkippedBlocks = (int)kSampleRate / kBlockSize;
+  const int kTotalBlocks = 3 * (int)kSampleRate / kBlockSize;
+  for (int block = 0; block < kTotalBlocks; ++block) {
+    if (block < kSkippedBlocks) {
+      fio_proc.skipBlock(kBlockSize);
+    } else {
+      for (int i = 0; i < kBlockSize; ++i) {
+        buffer.setSample(0, i, 0.1f * std::sin(0.05f * i));
+        buffer.setSample(1, i, 0.1f * std::cos(0.05f * i));
+      }
+      fio_proc.processBlock(buffer, midi);
+    }
+  }
+  fio_proc.setNonRealtime(false);
+
+  EXPECT_EQ(fio_proc.getExportProfile().samplesWritten, (long)kSampleRate);
+  EXPECT_TRUE(std::filesystem::exists(iamfOutPath));
+  ExportProfile::getProfileFile(ex.getExportFile()).deleteFile();
+}
+
+// Metadata changes are re-exported from the substreams of the last bounce,
+// while changes to the audio elements or the encoding need a new bounce.
+TEST_F(FileOutputProcessorTest, iamf_reexport_metadata) {
+  setup_1ae_cb();
+  EXPECT_FALSE(fio_proc.canReexportMetadata());
+  bounceExportConfig(ex, "Export for the re-export failed.");
+  ExportProfile::getProfileFile(ex.getExportFile()).deleteFile();
+  ASSERT_TRUE(fio_proc.canReexportMetadata());
+
+  const juce::File iamfFile(iamfPathStr);
+  ASSERT_TRUE(fio_proc.reexportMetadata());
+  juce::MemoryBlock initial;
+  ASSERT_TRUE(iamfFile.loadFileAsData(initial));
+
+  // Renaming the mix presentation only changes its descriptor
+  MixPresentation mp = *mixRepository.getFirst();
+  mp.setName("Renamed Mix Presentation");
+  mixRepository.update(mp);
+  ASSERT_TRUE(fio_proc.canReexportMetadata());
+  ASSERT_TRUE(fio_proc.reexportMetadata());
+  juce::MemoryBlock renamed;
+  ASSERT_TRUE(iamfFile.loadFileAsData(renamed));
+  EXPECT_NE(initial, renamed);
+
+  // Changing the codec configuration needs a new encode of the bounce
+  FileExport config = fileExportRepository.get();
+  config.setAudioCodec(AudioCodec::FLAC);
+  fileExportRepository.update(config);
+  EXPECT_FALSE(fio_proc.canReexportMetadata());
+  EXPECT_FALSE(fio_proc.reexportMetadata());
+  config.setAudioCodec(ex.getAudioCodec());
+  fileExportRepository.update(config);
+  EXPECT_TRUE(fio_proc.canReexportMetadata());
+
+  // Any change to the audio elements invalidates the bounce
+  AudioElement ae = *audioElementRepository.getFirst();
+  ae.setChannelConfig(Speakers::k5Point1);
+  audioElementRepository.update(ae);
+  EXPECT_FALSE(fio_proc.canReexportMetadata());
+  EXPECT_FALSE(fio_proc.reexportMetadata());
+  iamfFile.deleteFile();
+}
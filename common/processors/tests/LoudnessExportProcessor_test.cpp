@@ -651,4 +651,80 @@ TEST(test_loudness_proc, verify_metadata) {
     EXPECT_NEAR(stats.loudnessDigitalPeak,
                 layoutLoudnessStats.loudnessDigitalPeak, 0.1f);
   }
-}
\ No newline at end of file
+}
+
+// Measures a 5.1 mix presentation fed in host blocks of the given size, with
+// the processor prepared for kSamplesPerFrame.
+MeasureEBU128::LoudnessStats measureWithHostBlocks(const int hostBlockSize) {
+  const int kSampleRate = 48e3;
+  const int kSamplesPerFrame = 128;
+  // A whole number of both block sizes under test
+  const int kTotalSamples = 24 * 1024;
+
+  juce::ValueTree testState("test_state");
+  FileExportRepository fileExportRepository(
+      testState.getOrCreateChildWithName("file", nullptr));
+  MixPresentationLoudnessRepository mixPresentationLoudnessRepository(
+      testState.getOrCreateChildWithName("mixLoudness", nullptr));
+  MixPresentationRepository mixPresentationRepository(
+      testState.getOrCreateChildWithName("mixPres", nullptr));
+  AudioElementRepository audioElementRepository(
+      testState.getOrCreateChildWithName("audioElement", nullptr));
+
+  FileExport ex = fileExportRepository.get();
+  ex.setExportAudio(true);
+  ex.setAudioFileFormat(AudioFileFormat::IAMF);
+  ex.setSampleRate(kSampleRate);
+  fileExportRepository.update(ex);
+
+  const AudioElement audioElement(juce::Uuid(), "AE", Speakers::k5Point1, 0);
+  audioElementRepository.updateOrAdd(audioElement);
+  const juce::Uuid mixId;
+  configureMixPresentations({mixId}, {"Mix"}, {1.f}, {{audioElement}},
+                            mixPresentationRepository);
+  MixPresentationLoudness mixLoudness(mixId);
+  configureMixPresentationLoudness(mixLoudness, Speakers::k5Point1);
+  mixPresentationLoudnessRepository.updateOrAdd(mixLoudness);
+
+  LoudnessExportProcessor loudness_proc(
+      fileExportRepository, mixPresentationRepository,
+      mixPresentationLoudnessRepository, audioElementRepository);
+  loudness_proc.prepareToPlay(kSampleRate, kSamplesPerFrame);
+  loudness_proc.setNonRealtime(true);
+
+  const int numChannels = Speakers::k5Point1.getNumChannels();
+  juce::AudioBuffer<float> audioBuffer(numChannels, hostBlockSize);
+  juce::MidiBuffer midiBuffer;
+  for (int sampsProcd = 0; sampsProcd < kTotalSamples;
+       sampsProcd += hostBlockSize) {
+    for (int i = 0; i < hostBlockSize; ++i) {
+      const float sample =
+          0.1f *
+          std::sin(2 * M_PI * 440 * (float)(sampsProcd + i) / kSampleRate);
+      for (int ch = 0; ch < numChannels; ++ch) {
+        audioBuffer.setSample(ch, i, sample);
+      }
+    }
+    loudness_proc.processBlock(audioBuffer, midiBuffer);
+  }
+  loudness_proc.setNonRealtime(false);
+
+  MeasureEBU128::LoudnessStats stats;
+  loudness_proc.getExportContainers()[0]->loudnessExportData->layoutEBU128.read(
+      stats);
+  return stats;
+}
+
+// Offline renders may pass blocks larger than prepared. They should measure
+// the same as the prepared block size.
+TEST(test_loudness_proc, blocks_larger_than_prepared) {
+  const MeasureEBU128::LoudnessStats prepared = measureWithHostBlocks(128);
+  const MeasureEBU128::LoudnessStats oversized = measureWithHostBlocks(1024);
+
+  EXPECT_GT(prepared.loudnessIntegrated, -100.f);
+  EXPECT_NEAR(prepared.loudnessIntegrated, oversized.loudnessIntegrated,
+              1e-3f);
+  EXPECT_NEAR(prepared.loudnessDigitalPeak, oversized.loudnessDigitalPeak,
+              1e-3f);
+  EXPECT_NEAR(prepared.loudnessTruePeak, oversized.loudnessTruePeak, 1e-3f);
+}
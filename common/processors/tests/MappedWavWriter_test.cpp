@@ -0,0 +1,105 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "processors/file_output/MappedWavWriter.h"
+
+#include <gtest/gtest.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+
+namespace {
+const double kSampleRate = 48e3;
+const int kBlockSize = 480;
+
+juce::AudioBuffer<float> makeSine(const int numChannels, const int block) {
+  juce::AudioBuffer<float> buffer(numChannels, kBlockSize);
+  for (int ch = 0; ch < numChannels; ++ch) {
+    for (int i = 0; i < kBlockSize; ++i) {
+      const int n = block * kBlockSize + i;
+      buffer.setSample(ch, i,
+                       0.5f * std::sin(0.01f * (ch + 1) * (float)n));
+    }
+  }
+  return buffer;
+}
+
+std::unique_ptr<juce::AudioFormatReader> openWav(const juce::File& file) {
+  juce::WavAudioFormat format;
+  return std::unique_ptr<juce::AudioFormatReader>(
+      format.createReaderFor(new juce::FileInputStream(file), true));
+}
+}  // namespace
+
+// Write channels 1-3 of a 4 channel buffer across several mapped regions and
+// read them back with the JUCE WAV reader.
+TEST(test_mapped_wav_writer, round_trip_across_regions) {
+  const juce::File file =
+      juce::File::getCurrentWorkingDirectory().getChildFile("mapped.wav");
+  const int numBlocks = 20;
+  {
+    // A region holds fewer than 3 blocks, forcing the file to be remapped.
+    MappedWavWriter writer(file.getFullPathName(), kSampleRate, 3, 1, 24,
+                           4096);
+    for (int block = 0; block < numBlocks; ++block) {
+      writer.write(makeSine(4, block));
+    }
+    EXPECT_EQ(writer.getFramesWritten(), numBlocks * kBlockSize);
+  }
+
+  std::unique_ptr<juce::AudioFormatReader> reader = openWav(file);
+  ASSERT_NE(reader, nullptr);
+  EXPECT_EQ(reader->numChannels, 3);
+  EXPECT_EQ(reader->bitsPerSample, 24);
+  EXPECT_EQ(reader->sampleRate, kSampleRate);
+  EXPECT_EQ(reader->lengthInSamples, numBlocks * kBlockSize);
+
+  juce::AudioBuffer<float> readBack(3, kBlockSize);
+  for (int block = 0; block < numBlocks; ++block) {
+    reader->read(&readBack, 0, kBlockSize, block * kBlockSize, true, true);
+    const juce::AudioBuffer<float> expected = makeSine(4, block);
+    for (int ch = 0; ch < 3; ++ch) {
+      for (int i = 0; i < kBlockSize; ++i) {
+        ASSERT_NEAR(readBack.getSample(ch, i), expected.getSample(ch + 1, i),
+                    1e-5f);
+      }
+    }
+  }
+  reader.reset();
+  file.deleteFile();
+}
+
+// Out of range samples are clipped and an odd sized data chunk is padded.
+TEST(test_mapped_wav_writer, clip_and_pad) {
+  const juce::File file =
+      juce::File::getCurrentWorkingDirectory().getChildFile("mapped_mono.wav");
+  juce::AudioBuffer<float> buffer(1, 3);
+  buffer.setSample(0, 0, 2.0f);
+  buffer.setSample(0, 1, -2.0f);
+  buffer.setSample(0, 2, 0.25f);
+  {
+    MappedWavWriter writer(file.getFullPathName(), kSampleRate, 1, 0, 24);
+    writer.write(buffer);
+  }
+  EXPECT_EQ(file.getSize() % 2, 0);
+
+  std::unique_ptr<juce::AudioFormatReader> reader = openWav(file);
+  ASSERT_NE(reader, nullptr);
+  EXPECT_EQ(reader->lengthInSamples, 3);
+  juce::AudioBuffer<float> readBack(1, 3);
+  reader->read(&readBack, 0, 3, 0, true, false);
+  EXPECT_NEAR(readBack.getSample(0, 0), 1.0f, 1e-5f);
+  EXPECT_NEAR(readBack.getSample(0, 1), -1.0f, 1e-5f);
+  EXPECT_NEAR(readBack.getSample(0, 2), 0.25f, 1e-5f);
+  reader.reset();
+  file.deleteFile();
+}
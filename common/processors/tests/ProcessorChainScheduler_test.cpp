@@ -0,0 +1,196 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../processor_base/ProcessorChainScheduler.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+namespace {
+// Scales the buffer
+class ScalingProcessor final : public ProcessorBase {
+ public:
+  explicit ScalingProcessor(float gain) : gain_(gain) {}
+
+  void processBlock(juce::AudioBuffer<float>& buffer,
+                    juce::MidiBuffer& midiMessages) override {
+    juce::ignoreUnused(midiMessages);
+    buffer.applyGain(gain_);
+  }
+
+ private:
+  const float gain_;
+};
+
+// Records the first sample of every channel
+class ReadingProcessor final : public ProcessorBase {
+ public:
+  void processBlock(juce::AudioBuffer<float>& buffer,
+                    juce::MidiBuffer& midiMessages) override {
+    juce::ignoreUnused(midiMessages);
+    seen_.clear();
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch) {
+      seen_.push_back(buffer.getSample(ch, 0));
+    }
+    ++calls_;
+  }
+
+  BufferAccess getBufferAccess() const override {
+    return BufferAccess::kReadOnly;
+  }
+
+  using ProcessorBase::setActive;
+
+  std::vector<float> seen_;
+  std::atomic<int> calls_{0};
+};
+
+juce::AudioBuffer<float> makeBuffer(const int numChannels,
+                                    const int numSamples = 64) {
+  juce::AudioBuffer<float> buffer(numChannels, numSamples);
+  for (int ch = 0; ch < numChannels; ++ch) {
+    juce::FloatVectorOperations::fill(buffer.getWritePointer(ch),
+                                      static_cast<float>(ch + 1), numSamples);
+  }
+  return buffer;
+}
+}  // namespace
+
+TEST(test_processor_chain_scheduler, groups_consecutive_readers) {
+  ScalingProcessor scale(2.f);
+  ReadingProcessor readers[3];
+  ProcessorChainScheduler scheduler;
+  scheduler.setProcessors(
+      {&scale, &readers[0], &readers[1], &scale, &readers[2]}, 4);
+
+  // A reader between two writers is a stage of its own
+  ASSERT_EQ(scheduler.getNumStages(), 4);
+  // No workers are started until the chain is made parallel
+  ASSERT_EQ(scheduler.getNumWorkers(), 0);
+  // The widest stage has two readers, one of them on the calling thread
+  scheduler.setParallel(true);
+  ASSERT_EQ(scheduler.getNumWorkers(), 1);
+  // Going serial again keeps the workers for the next parallel run
+  scheduler.setParallel(false);
+  ASSERT_FALSE(scheduler.isParallel());
+  ASSERT_EQ(scheduler.getNumWorkers(), 1);
+}
+
+TEST(test_processor_chain_scheduler, readers_see_preceding_writer) {
+  for (const bool parallel : {true, false}) {
+    ScalingProcessor scale(2.f);
+    ReadingProcessor readers[4];
+    ProcessorChainScheduler scheduler;
+    scheduler.setProcessors(
+        {&scale, &readers[0], &readers[1], &readers[2], &scale, &readers[3]},
+        3);
+    scheduler.prepare(36, 64);
+    scheduler.setParallel(parallel);
+    ASSERT_EQ(scheduler.isParallel(), parallel);
+
+    juce::MidiBuffer midi;
+    // Several blocks, with the host passing different buffers
+    for (int block = 0; block < 100; ++block) {
+      juce::AudioBuffer<float> buffer = makeBuffer(block % 2 ? 36 : 2);
+      scheduler.process(buffer, midi);
+      for (int i = 0; i < 3; ++i) {
+        ASSERT_EQ(readers[i].seen_.size(),
+                  static_cast<size_t>(buffer.getNumChannels()));
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch) {
+          ASSERT_EQ(readers[i].seen_[ch], 2.f * (ch + 1));
+        }
+      }
+      ASSERT_EQ(readers[3].seen_.back(), 4.f * buffer.getNumChannels());
+    }
+    for (const ReadingProcessor& reader : readers) {
+      ASSERT_EQ(reader.calls_, 100);
+    }
+  }
+}
+
+TEST(test_processor_chain_scheduler, skips_inactive_processors) {
+  ScalingProcessor scale(2.f);
+  ReadingProcessor readers[3];
+  readers[1].setActive(false);
+  ProcessorChainScheduler scheduler;
+  scheduler.setProcessors({&readers[0], &readers[1], &scale, &readers[2]}, 2);
+  scheduler.prepare(2, 64);
+  scheduler.setParallel(true);
+  // Workers are started for the readers that may become active
+  ASSERT_EQ(scheduler.getNumWorkers(), 1);
+  ASSERT_EQ(scheduler.getNumStages(), 3);
+
+  juce::AudioBuffer<float> buffer = makeBuffer(2);
+  juce::MidiBuffer midi;
+  scheduler.process(buffer, midi);
+  ASSERT_EQ(readers[0].calls_, 1);
+  ASSERT_EQ(readers[1].calls_, 0);
+
+  // Activity changes are staged before the next block
+  readers[1].setActive(true);
+  readers[2].setActive(false);
+  scheduler.process(buffer, midi);
+  ASSERT_EQ(readers[1].calls_, 1);
+  ASSERT_EQ(readers[2].calls_, 1);
+  // The last reader is dropped and the first two share a stage
+  ASSERT_EQ(scheduler.getNumStages(), 2);
+}
+
+TEST(test_processor_chain_scheduler, serial_without_workers) {
+  ScalingProcessor scale(0.5f);
+  ReadingProcessor readers[2];
+  ProcessorChainScheduler scheduler;
+  scheduler.setProcessors({&readers[0], &readers[1], &scale}, 0);
+  scheduler.setParallel(true);
+  ASSERT_EQ(scheduler.getNumWorkers(), 0);
+  ASSERT_FALSE(scheduler.isParallel());
+
+  juce::AudioBuffer<float> buffer = makeBuffer(2);
+  juce::MidiBuffer midi;
+  scheduler.process(buffer, midi);
+  ASSERT_EQ(readers[1].seen_[1], 2.f);
+  ASSERT_EQ(buffer.getSample(1, 0), 1.f);
+
+  // Stopping the workers leaves an empty chain
+  scheduler.setProcessors({});
+  ASSERT_EQ(scheduler.getNumStages(), 0);
+  scheduler.process(buffer, midi);
+}
+
+TEST(test_processor_chain_scheduler, larger_buffers_run_serially) {
+  ScalingProcessor scale(2.f);
+  ReadingProcessor readers[2];
+  ProcessorChainScheduler scheduler;
+  scheduler.setProcessors({&scale, &readers[0], &readers[1]}, 1);
+  scheduler.setParallel(true);
+  ASSERT_TRUE(scheduler.isParallel());
+
+  // Unprepared, then wider and longer than prepared
+  juce::MidiBuffer midi;
+  for (const auto& [numChannels, numSamples] :
+       {std::pair{2, 64}, std::pair{36, 32}, std::pair{2, 128}}) {
+    juce::AudioBuffer<float> buffer = makeBuffer(numChannels, numSamples);
+    scheduler.process(buffer, midi);
+    for (const ReadingProcessor& reader : readers) {
+      ASSERT_EQ(reader.seen_.size(), static_cast<size_t>(numChannels));
+      ASSERT_EQ(reader.seen_.back(), 2.f * numChannels);
+    }
+    scheduler.prepare(2, 64);
+  }
+  ASSERT_EQ(readers[0].calls_, 3);
+  ASSERT_EQ(readers[1].calls_, 3);
+}
@@ -158,3 +158,39 @@ TEST(test_remapping_processor, test_output_buffer) {
 
   testBufferRemap(hostProcessor, true);
 }
+
+TEST(test_remapping_processor, test_remap_preserves_other_channels) {
+  DummyHostProcessor hostProcessor;
+  juce::AudioProcessor::BusesLayout busesLayout;
+  busesLayout.inputBuses.add(juce::AudioChannelSet::create7point1point4());
+  busesLayout.outputBuses.add(juce::AudioChannelSet::create7point1point4());
+  hostProcessor.setBusesLayout(busesLayout);
+  RemappingProcessor remappingProcessor(&hostProcessor, false);
+  remappingProcessor.prepareToPlay(44100.0, 4);
+
+  // Every channel holds its own index, and the buffer is wider than the bus
+  juce::AudioBuffer<float> buffer(16, 4);
+  for (int channel = 0; channel < buffer.getNumChannels(); ++channel) {
+    for (int sample = 0; sample < buffer.getNumSamples(); ++sample) {
+      buffer.setSample(channel, sample, static_cast<float>(channel));
+    }
+  }
+
+  juce::MidiBuffer midiBuffer;
+  remappingProcessor.processBlock(buffer, midiBuffer);
+
+  // The remapped channels form cycles, which are permuted in place. All other
+  // channels keep their audio
+  std::vector<float> expected(buffer.getNumChannels());
+  for (int channel = 0; channel < buffer.getNumChannels(); ++channel) {
+    expected[channel] = static_cast<float>(channel);
+  }
+  for (const auto& remap : remappingProcessor.getRemapTable()) {
+    expected[remap.targetChannel] = static_cast<float>(remap.sourceChannel);
+  }
+  for (int channel = 0; channel < buffer.getNumChannels(); ++channel) {
+    for (int sample = 0; sample < buffer.getNumSamples(); ++sample) {
+      EXPECT_EQ(buffer.getSample(channel, sample), expected[channel]);
+    }
+  }
+}
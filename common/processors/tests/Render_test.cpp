@@ -215,6 +215,41 @@ void ensureStereoToStereoIsRenderedCorrectly(
   }
 }
 
+void ensureVariableBlocksAreRenderedCorrectly(
+    RoomSetupRepository roomSetupData, AudioElementRepository audioElementData,
+    MixPresentationRepository mixPresData, ActiveMixRepository activeMixdata,
+    SpeakerMonitorData& rtData) {
+  RenderProcessor rProcessor(&hostProc, &roomSetupData, &audioElementData,
+                             &mixPresData, &activeMixdata, rtData);
+
+  RoomSetup setupInfo = roomSetupData.get();
+  setupInfo.setSpeakerLayout(
+      speakerLayoutConfigurationOptions[0]);  // Stereo speakers
+  roomSetupData.update(setupInfo);
+
+  rProcessor.prepareToPlay(kSampleRate, 24);
+  juce::MidiBuffer midiBuffer;
+
+  // Blocks both larger and smaller than prepared, the larger one not a whole
+  // number of prepared blocks
+  for (const int numSamples : {60, 10, 24}) {
+    juce::AudioBuffer<float> testDataBuffer(2, numSamples);
+    for (int i = 0; i < numSamples; i++) {
+      testDataBuffer.setSample(0, i, i);
+      testDataBuffer.setSample(1, i, -i);
+    }
+    rProcessor.processBlock(testDataBuffer, midiBuffer);
+
+    // Stereo->Stereo should output the same data
+    for (int i = 0; i < numSamples; i++) {
+      ASSERT_EQ(testDataBuffer.getSample(0, i), i);
+      ASSERT_EQ(testDataBuffer.getSample(1, i), -i);
+    }
+  }
+  // Stereo playback is rendered without latency
+  ASSERT_EQ(hostProc.getLatencySamples(), 0);
+}
+
 void ensureRoomUpdatesWhenRoomSetupChanges(
     RoomSetupRepository roomSetupData, AudioElementRepository audioElementData,
     MixPresentationRepository mixPresData, ActiveMixRepository activeMixdata,
@@ -294,6 +329,9 @@ TEST(test_render_processor, addbus) {
   ensureStereoToStereoIsRenderedCorrectly(roomSetupData, audioElementData,
                                           mixPresData, activeMixPresData,
                                           spkrMonitorData);
+  ensureVariableBlocksAreRenderedCorrectly(roomSetupData, audioElementData,
+                                           mixPresData, activeMixPresData,
+                                           spkrMonitorData);
   ensureStereoToFiveOneIsRenderedCorrectly(roomSetupData, audioElementData,
                                            mixPresData, activeMixPresData,
                                            spkrMonitorData);
@@ -741,6 +779,18 @@ TEST_F(test_render_proc, binaural_renderers) {
   for (int i = 0; i < kNumAudioElements; ++i) {
     ASSERT_EQ(renderers[i]->kIsBinaural, mpAE[i].isBinaural());
   }
+  // Prepared blocks are rendered directly
+  ASSERT_EQ(host.getLatencySamples(), 0);
+
+  // Buffering blocks, binaural playback trails by a block from then on,
+  // whatever the size of the blocks that follow
+  proc.setBufferBlocks(true);
+  ASSERT_EQ(host.getLatencySamples(), kSamplesPerBlock);
+  juce::AudioBuffer<float> unevenBuffer(kDefaultBusLayout.getNumChannels(),
+                                        kSamplesPerBlock / 3);
+  unevenBuffer.clear();
+  proc.processBlock(unevenBuffer, emptyMidi);
+  ASSERT_EQ(host.getLatencySamples(), kSamplesPerBlock);
 
   const juce::Uuid mpId2;
   MixPresentation mp2(mpId2, "Non-Binaural AEs", 1.f,
@@ -764,4 +814,36 @@ TEST_F(test_render_proc, binaural_renderers) {
   for (int i = 0; i < kNumAudioElements; ++i) {
     ASSERT_EQ(renderers[i]->kIsBinaural, mp2AE[i].isBinaural());
   }
+  // Without binaural renderers there is nothing to delay
+  ASSERT_EQ(host.getLatencySamples(), 0);
+}
+
+// Verify that elements rendered without OBR stay aligned with those rendered
+// with it
+TEST_F(test_render_proc, binaural_mix_is_aligned) {
+  Speakers::AudioElementSpeakerLayout layout = Speakers::kBinaural;
+  room.setSpeakerLayout(RoomLayout(layout, layout.toString().toStdString()));
+  roomSetupData.update(room);
+
+  const juce::Uuid mpId;
+  MixPresentation mp(mpId, "Mixed AEs", 1.f,
+                     LanguageData::MixLanguages::English, {});
+  for (int i = 0; i < 2; ++i) {
+    AudioElement ae(juce::Uuid(), "Stereo " + std::to_string(i),
+                    Speakers::kStereo, i * 2);
+    audioElementData.add(ae);
+    mp.addAudioElement(ae.getId(), 1.f, ae.getName(), i == 0);
+  }
+  mixPresData.updateOrAdd(mp);
+  activeMix.updateActiveMixId(mpId);
+  activeMixPresData.update(activeMix);
+
+  proc.prepareToPlay(kSampleRate, kSamplesPerBlock);
+  proc.setBufferBlocks(true);
+
+  for (const AudioElementRenderer* renderer : proc.getAudioElementRenderers()) {
+    ASSERT_EQ(renderer->rendererBinaural->getLatencySamples(),
+              kSamplesPerBlock);
+  }
+  ASSERT_EQ(host.getLatencySamples(), kSamplesPerBlock);
 }
\ No newline at end of file
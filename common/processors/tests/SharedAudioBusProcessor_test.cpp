@@ -0,0 +1,135 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../routing/SharedAudioBusProcessor.h"
+
+#include <gtest/gtest.h>
+
+#include "data_structures/src/SharedAudioBus.h"
+
+namespace {
+constexpr int kSamples = 128;
+constexpr int kHostChannels = 4;
+
+// Host of a renderer whose bus carries kHostChannels channels
+class NarrowHostProcessor final : public ProcessorBase {
+ public:
+  NarrowHostProcessor()
+      : ProcessorBase(juce::AudioChannelSet::discreteChannels(kHostChannels),
+                      juce::AudioChannelSet::discreteChannels(kHostChannels)) {
+  }
+  void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override {}
+};
+
+juce::AudioBuffer<float> makeBlock(const int numChannels, const int numSamples,
+                                   const float value) {
+  juce::AudioBuffer<float> buffer(numChannels, numSamples);
+  for (int ch = 0; ch < numChannels; ++ch) {
+    juce::FloatVectorOperations::fill(buffer.getWritePointer(ch),
+                                      value + (float)ch, numSamples);
+  }
+  return buffer;
+}
+
+class test_shared_audio_bus_processor : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // One element carried by the host bus, one straddling its last channels
+    // and one beyond it
+    audioElements_.add(inside_);
+    audioElements_.add(straddling_);
+    audioElements_.add(beyond_);
+    if (!writer_.isAvailable()) {
+      GTEST_SKIP() << "Shared memory is unavailable";
+    }
+    proc_.prepareToPlay(48000, kSamples);
+  }
+
+  // The host bus carries 10 + channel on its channels, the channels beyond it
+  // start out holding leftovers of a previous block
+  juce::AudioBuffer<float> hostBuffer(const int numSamples) {
+    juce::AudioBuffer<float> buffer = makeBlock(8, numSamples, 10.f);
+    for (int ch = kHostChannels; ch < buffer.getNumChannels(); ++ch) {
+      juce::FloatVectorOperations::fill(buffer.getWritePointer(ch), -1.f,
+                                        numSamples);
+    }
+    return buffer;
+  }
+
+  const AudioElement inside_{juce::Uuid(), "Inside", Speakers::kStereo, 0};
+  const AudioElement straddling_{juce::Uuid(), "Straddling", Speakers::kStereo,
+                                 3};
+  const AudioElement beyond_{juce::Uuid(), "Beyond", Speakers::kStereo, 6};
+  AudioElementRepository audioElements_{juce::ValueTree{"test"}};
+  NarrowHostProcessor host_;
+  SharedAudioBusProcessor proc_{&host_, &audioElements_};
+  SharedAudioBusWriter writer_;
+  juce::MidiBuffer midi_;
+};
+}  // namespace
+
+TEST_F(test_shared_audio_bus_processor, reads_beyond_host_bus_only) {
+  ASSERT_TRUE(
+      writer_.write(inside_.getId(), makeBlock(2, kSamples, 1.f), 2, 4800));
+  ASSERT_TRUE(
+      writer_.write(straddling_.getId(), makeBlock(2, kSamples, 3.f), 2, 4800));
+  ASSERT_TRUE(
+      writer_.write(beyond_.getId(), makeBlock(2, kSamples, 5.f), 2, 4800));
+
+  proc_.setSamplePosition(4800);
+  juce::AudioBuffer<float> buffer = hostBuffer(kSamples);
+  proc_.processBlock(buffer, midi_);
+
+  // The host bus keeps the host's audio, including the first channel of the
+  // straddling element
+  for (int ch = 0; ch < kHostChannels; ++ch) {
+    EXPECT_EQ(buffer.getSample(ch, 0), 10.f + ch);
+  }
+  // The rest is read from the shared bus
+  EXPECT_EQ(buffer.getSample(4, kSamples - 1), 4.f);
+  EXPECT_EQ(buffer.getSample(5, 0), 0.f);
+  EXPECT_EQ(buffer.getSample(6, 0), 5.f);
+  EXPECT_EQ(buffer.getSample(7, kSamples - 1), 6.f);
+}
+
+TEST_F(test_shared_audio_bus_processor, silent_without_a_block) {
+  ASSERT_TRUE(
+      writer_.write(beyond_.getId(), makeBlock(2, kSamples, 5.f), 2, 4800));
+
+  // No block was written for this position
+  proc_.setSamplePosition(4800 + kSamples);
+  juce::AudioBuffer<float> buffer = hostBuffer(kSamples);
+  proc_.processBlock(buffer, midi_);
+
+  for (int ch = 0; ch < kHostChannels; ++ch) {
+    EXPECT_EQ(buffer.getSample(ch, 0), 10.f + ch);
+  }
+  for (int ch = kHostChannels; ch < buffer.getNumChannels(); ++ch) {
+    EXPECT_EQ(buffer.getMagnitude(ch, 0, kSamples), 0.f);
+  }
+}
+
+TEST_F(test_shared_audio_bus_processor, oversized_blocks_are_silent) {
+  const int numSamples = SharedAudioBlock::kMaxSamples + 1;
+  proc_.setSamplePosition(0);
+  juce::AudioBuffer<float> buffer = hostBuffer(numSamples);
+  proc_.processBlock(buffer, midi_);
+
+  for (int ch = 0; ch < kHostChannels; ++ch) {
+    EXPECT_EQ(buffer.getSample(ch, numSamples - 1), 10.f + ch);
+  }
+  for (int ch = kHostChannels; ch < buffer.getNumChannels(); ++ch) {
+    EXPECT_EQ(buffer.getMagnitude(ch, 0, numSamples), 0.f);
+  }
+}
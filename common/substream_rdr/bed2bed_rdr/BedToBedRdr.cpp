@@ -70,12 +70,13 @@ void BedToBedRdr::render(const FBuffer& srcBuffer, FBuffer& outBuffer) {
 }
 
 inline void BedToBedRdr::prepInterBuff(const int numSamples) {
-  // Allocate a new buffer if necessary.
+  // Allocate a new buffer if necessary. Shorter blocks reuse the
+  // allocation.
   if (interBuffer_.getNumChannels() !=
           kInputLayout_.getExplBaseLayout().getNumChannels() ||
       interBuffer_.getNumSamples() != numSamples) {
     interBuffer_.setSize(kInputLayout_.getExplBaseLayout().getNumChannels(),
-                         numSamples);
+                         numSamples, false, false, true);
   }
   interBuffer_.clear();
 }
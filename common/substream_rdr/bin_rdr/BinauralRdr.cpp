@@ -61,10 +61,11 @@ static obr::AudioElementType asOBRLayout(
 
 std::unique_ptr<Renderer> BinauralRdr::createBinauralRdr(
     const Speakers::AudioElementSpeakerLayout layout, const int numSamples,
-    const int sampleRate) {
+    const int sampleRate, const bool bufferBlocks) {
   // Input layout == output layout. No rendering to be done.
   if (layout == Speakers::kBinaural) {
-    return std::unique_ptr<Renderer>(new BinauralCopyRdr());
+    return std::unique_ptr<Renderer>(
+        new BinauralCopyRdr(bufferBlocks ? numSamples : 0));
   }
 
   // Check that a binaural renderer can be created for the given layout.
@@ -82,12 +83,13 @@ std::unique_ptr<Renderer> BinauralRdr::createBinauralRdr(
 
   // Construct the binaural renderer.
   return std::unique_ptr<Renderer>(
-      new BinauralRdr(inputType, layout, numSamples, sampleRate));
+      new BinauralRdr(inputType, layout, numSamples, sampleRate, bufferBlocks));
 }
 
 BinauralRdr::BinauralRdr(const obr::AudioElementType layout,
                          const Speakers::AudioElementSpeakerLayout spkrLayout,
-                         const int numSamples, const int sampleRate)
+                         const int numSamples, const int sampleRate,
+                         const bool bufferBlocks)
     : audioElementlayout_(spkrLayout), numSamplesIn_(numSamples) {
   binauralRdr_ = std::make_unique<obr::ObrImpl>(numSamplesIn_, sampleRate);
   binauralRdr_->AddAudioElement(layout);
@@ -99,37 +101,46 @@ BinauralRdr::BinauralRdr(const obr::AudioElementType layout,
       obr::AudioBuffer(Speakers::kBinaural.getNumChannels(), numSamplesIn_);
   inputBufferPlanar_.Clear();
   outputBufferPlanar_.Clear();
+  blockAdapter_.prepare(numSamplesIn_, bufferBlocks);
 }
 
 BinauralRdr::~BinauralRdr() {}
 
 void BinauralRdr::render(const juce::AudioBuffer<float>& inputBuffer,
                          juce::AudioBuffer<float>& outputBuffer) {
-  // For non-expanded layouts, copy input buffer to planar buffer directly
-  if (!audioElementlayout_.isExpandedLayout()) {
-    for (int i = 0; i < audioElementlayout_.getNumChannels(); ++i) {
-      const float* rPtr = inputBuffer.getReadPointer(i);
-      for (int j = 0; j < numSamplesIn_; ++j) {
-        inputBufferPlanar_[i][j] = rPtr[j];
-      }
-    }
-  } else {
-    // For expanded layouts, copy the input channels into the correct positions
-    // in the planar buffer.
-    const auto& validChannels = audioElementlayout_.getExplValidChannels();
-    for (int i = 0; i < validChannels->size(); i++) {
-      const float* rPtr = inputBuffer.getReadPointer(i);
-      for (int j = 0; j < numSamplesIn_; ++j) {
-        inputBufferPlanar_[validChannels->at(i)][j] = rPtr[j];
-      }
-    }
-  }
-
-  binauralRdr_->Process(inputBufferPlanar_, &outputBufferPlanar_);
-
-  for (int i = 0; i < Speakers::kBinaural.getNumChannels(); i++) {
-    for (int j = 0; j < numSamplesIn_; j++) {
-      outputBuffer.setSample(i, j, outputBufferPlanar_[i][j]);
-    }
-  }
+  blockAdapter_.process(
+      inputBuffer.getNumSamples(),
+      [&](const int hostOffset, const int blockOffset, const int num) {
+        // For non-expanded layouts, copy input buffer to planar buffer
+        // directly
+        if (!audioElementlayout_.isExpandedLayout()) {
+          for (int i = 0; i < audioElementlayout_.getNumChannels(); ++i) {
+            const float* rPtr = inputBuffer.getReadPointer(i, hostOffset);
+            for (int j = 0; j < num; ++j) {
+              inputBufferPlanar_[i][blockOffset + j] = rPtr[j];
+            }
+          }
+        } else {
+          // For expanded layouts, copy the input channels into the correct
+          // positions in the planar buffer.
+          const auto& validChannels =
+              audioElementlayout_.getExplValidChannels();
+          for (int i = 0; i < validChannels->size(); i++) {
+            const float* rPtr = inputBuffer.getReadPointer(i, hostOffset);
+            for (int j = 0; j < num; ++j) {
+              inputBufferPlanar_[validChannels->at(i)][blockOffset + j] =
+                  rPtr[j];
+            }
+          }
+        }
+      },
+      [&] { binauralRdr_->Process(inputBufferPlanar_, &outputBufferPlanar_); },
+      [&](const int blockOffset, const int hostOffset, const int num) {
+        for (int i = 0; i < Speakers::kBinaural.getNumChannels(); i++) {
+          float* wPtr = outputBuffer.getWritePointer(i, hostOffset);
+          for (int j = 0; j < num; j++) {
+            wPtr[j] = outputBufferPlanar_[i][blockOffset + j];
+          }
+        }
+      });
 }
\ No newline at end of file
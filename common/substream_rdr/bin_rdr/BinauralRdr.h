@@ -18,28 +18,39 @@
 
 #include "renderer/obr_impl.h"
 #include "substream_rdr/rdr_factory/Renderer.h"
+#include "substream_rdr/substream_rdr_utils/FixedBlockAdapter.h"
 #include "substream_rdr/substream_rdr_utils/Speakers.h"
 
 class BinauralRdr : public Renderer {
  public:
+  // With bufferBlocks, host blocks of any size are buffered into blocks of
+  // numSamples, delaying the output by a block. Otherwise blocks are rendered
+  // directly, and should be numSamples long.
   static std::unique_ptr<Renderer> createBinauralRdr(
       const Speakers::AudioElementSpeakerLayout layout, const int numSamples,
-      const int sampleRate);
+      const int sampleRate, const bool bufferBlocks = false);
 
   ~BinauralRdr();
 
   void render(const juce::AudioBuffer<float>& inputBuffer,
               juce::AudioBuffer<float>& outputBuffer) override;
 
+  int getLatencySamples() const override {
+    return blockAdapter_.getLatencySamples();
+  }
+
  private:
   BinauralRdr(const obr::AudioElementType layout,
               const Speakers::AudioElementSpeakerLayout spkrLayout,
-              const int numSamples, const int sampleRate);
+              const int numSamples, const int sampleRate,
+              const bool bufferBlocks);
 
   int numSamplesIn_;
   obr::AudioBuffer inputBufferPlanar_, outputBufferPlanar_;
   std::unique_ptr<obr::ObrImpl> binauralRdr_;
   Speakers::AudioElementSpeakerLayout audioElementlayout_;
+  // OBR only processes blocks of numSamplesIn_
+  FixedBlockAdapter blockAdapter_;
 };
 
 /**
@@ -48,14 +59,64 @@ class BinauralRdr : public Renderer {
  * E.g. rendering a stereo bed from a stereo input layout does an implicit copy,
  * this mimics that behavior.
  *
+ * When created with a number of samples, the copy is delayed like a BinauralRdr
+ * buffering blocks of the same number, keeping it aligned in a mix with them.
+ * Given a source renderer, the source's two channel output is copied instead,
+ * which aligns renderers without latency of their own.
  */
 class BinauralCopyRdr : public Renderer {
  public:
+  explicit BinauralCopyRdr(const int numSamples = 0,
+                           std::unique_ptr<Renderer> source = nullptr)
+      : block_(Speakers::kBinaural.getNumChannels(), numSamples),
+        source_(std::move(source)) {
+    blockAdapter_.prepare(numSamples, true);
+    if (source_ != nullptr) {
+      sourceOutput_.setSize(Speakers::kBinaural.getNumChannels(), numSamples);
+    }
+  }
+
   void render(const juce::AudioBuffer<float>& inputBuffer,
               juce::AudioBuffer<float>& outputBuffer) override {
-    for (int i = 0; i < Speakers::kBinaural.getNumChannels(); ++i) {
-      outputBuffer.copyFrom(i, 0, inputBuffer, i, 0,
-                            inputBuffer.getNumSamples());
+    const int numChannels = Speakers::kBinaural.getNumChannels();
+    const int numSamples = inputBuffer.getNumSamples();
+    const juce::AudioBuffer<float>* copied = &inputBuffer;
+    if (source_ != nullptr) {
+      sourceOutput_.setSize(numChannels, numSamples, false, false, true);
+      sourceOutput_.clear();
+      source_->render(inputBuffer, sourceOutput_);
+      copied = &sourceOutput_;
     }
+
+    if (block_.getNumSamples() == 0) {
+      for (int i = 0; i < numChannels; ++i) {
+        outputBuffer.copyFrom(i, 0, *copied, i, 0, numSamples);
+      }
+      return;
+    }
+    blockAdapter_.process(
+        numSamples,
+        [&](int hostOffset, int blockOffset, int num) {
+          for (int i = 0; i < numChannels; ++i) {
+            block_.copyFrom(i, blockOffset, *copied, i, hostOffset, num);
+          }
+        },
+        [] {},
+        [&](int blockOffset, int hostOffset, int num) {
+          for (int i = 0; i < numChannels; ++i) {
+            outputBuffer.copyFrom(i, hostOffset, block_, i, blockOffset, num);
+          }
+        });
+  }
+
+  int getLatencySamples() const override {
+    return blockAdapter_.getLatencySamples();
   }
+
+ private:
+  // Copied in and out in place
+  juce::AudioBuffer<float> block_;
+  FixedBlockAdapter blockAdapter_;
+  std::unique_ptr<Renderer> source_;
+  juce::AudioBuffer<float> sourceOutput_;
 };
\ No newline at end of file
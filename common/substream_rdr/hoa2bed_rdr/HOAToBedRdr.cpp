@@ -109,10 +109,12 @@ void HOAToBedRdr::render(const FBuffer& srcBuffer, FBuffer& outBuffer) {
 inline void HOAToBedRdr::prepInterBuff(
     const Speakers::AudioElementSpeakerLayout interLayout,
     const int numSamples) {
-  // Allocate a new buffer if necessary.
+  // Allocate a new buffer if necessary. Shorter blocks reuse the
+  // allocation.
   if (interBuffer_.getNumChannels() != kInterLayout_.getNumChannels() ||
       interBuffer_.getNumSamples() != numSamples) {
-    interBuffer_.setSize(kInterLayout_.getNumChannels(), numSamples);
+    interBuffer_.setSize(kInterLayout_.getNumChannels(), numSamples, false,
+                         false, true);
   }
   interBuffer_.clear();
 }
@@ -24,5 +24,10 @@ class Renderer {
   using FBuffer = Speakers::FBuffer;
 
   virtual ~Renderer() {};
+  // Renders as many samples as the source holds. Renderers that only process
+  // blocks of one size may delay their output, see getLatencySamples().
   virtual void render(const FBuffer& srcBuffer, FBuffer& outBuffer) = 0;
+
+  // Samples by which the rendered output trails the source.
+  virtual int getLatencySamples() const { return 0; }
 };
\ No newline at end of file
@@ -22,10 +22,11 @@
 std::unique_ptr<Renderer> createRenderer(
     const Speakers::AudioElementSpeakerLayout inputLayout,
     const Speakers::AudioElementSpeakerLayout playbackLayout,
-    const int numSamples, const int sampleRate) {
+    const int numSamples, const int sampleRate, const bool bufferBlocks) {
   // Binaural rendering is handled by a separate renderer.
   if (playbackLayout == Speakers::kBinaural) {
-    return BinauralRdr::createBinauralRdr(inputLayout, numSamples, sampleRate);
+    return BinauralRdr::createBinauralRdr(inputLayout, numSamples, sampleRate,
+                                          bufferBlocks);
   }
   // All other rendering is Channel-based or Scene-based.
   else {
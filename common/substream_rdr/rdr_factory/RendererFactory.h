@@ -26,9 +26,12 @@ class Renderer;
  *
  * @param inputLayout Input channel positioning within buffer.
  * @param playbackLayout Playback layout the input stream is to be rendered to.
+ * @param bufferBlocks Buffer binaural rendering into blocks of numSamples, for
+ * hosts passing blocks of varying size. This delays the output by a block.
  * @return std::unique_ptr<Renderer>
  */
 std::unique_ptr<Renderer> createRenderer(
     const Speakers::AudioElementSpeakerLayout inputLayout,
     const Speakers::AudioElementSpeakerLayout playbackLayout,
-    const int numSamples = 0, const int sampleRate = 48e3);
\ No newline at end of file
+    const int numSamples = 0, const int sampleRate = 48e3,
+    const bool bufferBlocks = false);
\ No newline at end of file
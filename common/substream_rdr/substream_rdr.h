@@ -37,6 +37,7 @@ END_JUCE_MODULE_DECLARATION
 #include "hoa2bed_rdr/HOAToBedRdr.h"
 #include "passthrough_rdr/PassthroughRdr.h"
 #include "rdr_factory/RendererFactory.h"
+#include "substream_rdr_utils/FixedBlockAdapter.h"
 #include "substream_rdr_utils/Speakers.h"
 #include "surround_panner/AmbisonicPanner.h"
 #include "surround_panner/AudioPanner.h"
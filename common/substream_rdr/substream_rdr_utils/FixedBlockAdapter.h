@@ -0,0 +1,108 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+
+/**
+ * @brief Feeds a processor that only takes blocks of one size from host blocks
+ * of any size.
+ *
+ * By default host blocks are processed directly, a processor block at a time,
+ * without latency. A host block shorter than the processor block is processed
+ * with the rest of the processor block left over from the block before, so
+ * hosts that vary their block size should prepare the adapter buffered.
+ *
+ * Buffered, samples pass through a FIFO of one processor block, so the output
+ * trails the input by a block whatever the sizes of the host blocks. The
+ * latency is fixed when the adapter is prepared rather than when a block fails
+ * to line up. The adapter only keeps positions; the processor owns the block
+ * buffers, so nothing is allocated while processing.
+ */
+class FixedBlockAdapter {
+ public:
+  void prepare(const int blockSize, const bool buffered = false) {
+    blockSize_ = blockSize;
+    buffered_ = buffered;
+    reset();
+  }
+
+  // Empties the FIFO, so the next block of output is silent.
+  void reset() {
+    outputValid_ = false;
+    fill_ = 0;
+  }
+
+  int getBlockSize() const { return blockSize_; }
+  bool isBuffered() const { return buffered_; }
+  int getLatencySamples() const { return buffered_ ? blockSize_ : 0; }
+
+  /**
+   * @brief Moves numSamples of a host block through the processor.
+   *
+   * @param copyIn(hostOffset, blockOffset, num) copies host input into the
+   *        processor's input block.
+   * @param process() processes a full block.
+   * @param copyOut(blockOffset, hostOffset, num) copies the processor's output
+   *        block to the host output. When buffered, host output before the
+   *        first block is processed is not written, and should be cleared by
+   *        the caller. The host input and output must not overlap.
+   */
+  template <typename CopyIn, typename Process, typename CopyOut>
+  void process(const int numSamples, CopyIn&& copyIn, Process&& process,
+               CopyOut&& copyOut) {
+    if (blockSize_ <= 0) {
+      return;
+    }
+
+    if (!buffered_) {
+      for (int pos = 0; pos < numSamples; pos += blockSize_) {
+        const int num = std::min(numSamples - pos, blockSize_);
+        copyIn(pos, 0, num);
+        process();
+        copyOut(0, pos, num);
+      }
+      return;
+    }
+
+    int pos = 0;
+    while (pos < numSamples) {
+      const int num = std::min(numSamples - pos, blockSize_ - fill_);
+      // The output for these samples comes from the block processed before,
+      // and is read out before the processor input is overwritten
+      if (outputValid_) {
+        copyOut(fill_, pos, num);
+      }
+      copyIn(pos, fill_, num);
+      fill_ += num;
+      pos += num;
+      if (fill_ == blockSize_) {
+        process();
+        fill_ = 0;
+        outputValid_ = true;
+      }
+    }
+  }
+
+ private:
+  int blockSize_ = 0;
+  bool buffered_ = false;
+  // Whether the processor's output block holds output yet
+  bool outputValid_ = false;
+  // Samples in the processor's input block
+  int fill_ = 0;
+};
@@ -44,8 +44,12 @@ void AmbisonicPanner::process(juce::AudioBuffer<float>& inputBuffer,
 
   // Fetch the data for the first channel, since it's the only channel we will
   // pan
+  // The encoder keeps no state between blocks, so a shorter block is encoded
+  // as the start of a full one
+  const int numSamples =
+      std::min(inputBuffer.getNumSamples(), kSamplesPerBlock_);
   const float* rPtr = inputBuffer.getReadPointer(0);
-  for (int j = 0; j < kSamplesPerBlock_; ++j) {
+  for (int j = 0; j < numSamples; ++j) {
     inputBufferPlanar_[0][j] = rPtr[j];
   }
 
@@ -54,7 +58,7 @@ void AmbisonicPanner::process(juce::AudioBuffer<float>& inputBuffer,
 
   // Write the processed planar output data to the intermediate buffer.
   for (int i = 0; i < kPannedLayout_.getNumChannels(); i++) {
-    for (int j = 0; j < kSamplesPerBlock_; j++) {
+    for (int j = 0; j < numSamples; j++) {
       outputBuffer.setSample(i, j, outputBufferPlanar_[i][j]);
     }
   }
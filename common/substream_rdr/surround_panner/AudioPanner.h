@@ -88,6 +88,9 @@ class AudioPanner {
   virtual void process(juce::AudioBuffer<float>& inputBuffer,
                        juce::AudioBuffer<float>& outputBuffer) = 0;
 
+  // Samples by which the panned output trails the input.
+  virtual int getLatencySamples() const { return 0; }
+
  protected:
   virtual void positionUpdated() = 0;
 
@@ -14,7 +14,8 @@
 
 #include "BinauralPanner.h"
 
-BinauralPanner::BinauralPanner(const int samplesPerBlock, const int sampleRate)
+BinauralPanner::BinauralPanner(const int samplesPerBlock, const int sampleRate,
+                               const bool bufferBlocks)
     : encoder_(nullptr),
       AudioPanner(Speakers::kBinaural, samplesPerBlock, sampleRate) {
   // Create the encoder for encoding to the desired ambisonic order.
@@ -25,6 +26,7 @@ BinauralPanner::BinauralPanner(const int samplesPerBlock, const int sampleRate)
   inputBufferPlanar_ = obr::AudioBuffer(1, samplesPerBlock);
   outputBufferPlanar_ =
       obr::AudioBuffer(Speakers::kBinaural.getNumChannels(), samplesPerBlock);
+  blockAdapter_.prepare(samplesPerBlock, bufferBlocks);
 }
 
 BinauralPanner::~BinauralPanner() {}
@@ -38,19 +40,26 @@ void BinauralPanner::process(juce::AudioBuffer<float>& inputBuffer,
                              juce::AudioBuffer<float>& outputBuffer) {
   outputBuffer.clear();
 
-  // Fetch the first channel, which is the only channel to be panned
-  const float* rPtr = inputBuffer.getReadPointer(0);
-  for (int j = 0; j < kSamplesPerBlock_; ++j) {
-    inputBufferPlanar_[0][j] = rPtr[j];
-  }
-
-  // Convert input buffer to planar vector and add spatial information.
-  encoder_->Process(inputBufferPlanar_, &outputBufferPlanar_);
-
-  // Write the processed planar output data to the intermediate buffer.
-  for (int i = 0; i < Speakers::kBinaural.getNumChannels(); i++) {
-    for (int j = 0; j < kSamplesPerBlock_; j++) {
-      outputBuffer.setSample(i, j, outputBufferPlanar_[i][j]);
-    }
-  }
+  blockAdapter_.process(
+      inputBuffer.getNumSamples(),
+      [&](const int hostOffset, const int blockOffset, const int num) {
+        // Fetch the first channel, which is the only channel to be panned
+        const float* rPtr = inputBuffer.getReadPointer(0, hostOffset);
+        for (int j = 0; j < num; ++j) {
+          inputBufferPlanar_[0][blockOffset + j] = rPtr[j];
+        }
+      },
+      [&] {
+        // Convert input buffer to planar vector and add spatial information.
+        encoder_->Process(inputBufferPlanar_, &outputBufferPlanar_);
+      },
+      [&](const int blockOffset, const int hostOffset, const int num) {
+        // Write the processed planar output data to the intermediate buffer.
+        for (int i = 0; i < Speakers::kBinaural.getNumChannels(); i++) {
+          float* wPtr = outputBuffer.getWritePointer(i, hostOffset);
+          for (int j = 0; j < num; j++) {
+            wPtr[j] = outputBufferPlanar_[i][blockOffset + j];
+          }
+        }
+      });
 }
\ No newline at end of file
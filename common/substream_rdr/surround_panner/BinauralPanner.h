@@ -19,10 +19,14 @@
 
 #include "AudioPanner.h"
 #include "renderer/obr_impl.h"
+#include "substream_rdr/substream_rdr_utils/FixedBlockAdapter.h"
 
 class BinauralPanner : public AudioPanner {
  public:
-  BinauralPanner(const int samplesPerBlock, const int sampleRate);
+  // With bufferBlocks, host blocks of any size are buffered into blocks of
+  // samplesPerBlock, delaying the output by a block.
+  BinauralPanner(const int samplesPerBlock, const int sampleRate,
+                 const bool bufferBlocks = false);
 
   ~BinauralPanner();
 
@@ -31,7 +35,7 @@ class BinauralPanner : public AudioPanner {
    *        output buffer.
    * @pre Input buffer must have the same number of channels as the input
    * layout.
-   * @pre Input buffer must have the same number of samples as the panner was
+   * @pre Input buffer must have at most as many samples as the panner was
    *      constructed with.
    * @param inputBuffer
    * @param outputBuffer
@@ -39,10 +43,16 @@ class BinauralPanner : public AudioPanner {
   void process(juce::AudioBuffer<float>& inputBuffer,
                juce::AudioBuffer<float>& outputBuffer) override;
 
+  int getLatencySamples() const override {
+    return blockAdapter_.getLatencySamples();
+  }
+
  protected:
   void positionUpdated() override;
 
  private:
   obr::AudioBuffer inputBufferPlanar_, outputBufferPlanar_;
   std::unique_ptr<obr::ObrImpl> encoder_;
+  // OBR only processes blocks of the size it was created with
+  FixedBlockAdapter blockAdapter_;
 };
\ No newline at end of file
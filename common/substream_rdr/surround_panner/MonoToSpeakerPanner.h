@@ -33,7 +33,7 @@ class MonoToSpeakerPanner : public AudioPanner {
    *        output buffer.
    * @pre Input buffer must have the same number of channels as the input
    * layout.
-   * @pre Input buffer must have the same number of samples as the panner was
+   * @pre Input buffer must have at most as many samples as the panner was
    *      constructed with.
    * @param inputBuffer
    * @param outputBuffer
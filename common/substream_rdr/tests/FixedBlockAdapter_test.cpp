@@ -0,0 +1,141 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "substream_rdr/substream_rdr_utils/FixedBlockAdapter.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "substream_rdr/bin_rdr/BinauralRdr.h"
+
+namespace {
+// Passes host blocks of the given sizes through a processor that doubles
+// blocks of blockSize samples, returning the output and the blocks processed.
+std::vector<float> runBlocks(FixedBlockAdapter& adapter,
+                             const std::vector<int>& hostBlocks,
+                             int& numProcessed) {
+  std::vector<float> input(adapter.getBlockSize());
+  std::vector<float> output(adapter.getBlockSize());
+  std::vector<float> result;
+  float next = 1.f;
+  for (const int numSamples : hostBlocks) {
+    std::vector<float> host(numSamples), hostOut(numSamples, 0.f);
+    for (float& sample : host) {
+      sample = next++;
+    }
+    adapter.process(
+        numSamples,
+        [&](int hostOffset, int blockOffset, int num) {
+          std::copy_n(host.begin() + hostOffset, num,
+                      input.begin() + blockOffset);
+        },
+        [&] {
+          for (int i = 0; i < adapter.getBlockSize(); ++i) {
+            output[i] = 2.f * input[i];
+          }
+          ++numProcessed;
+        },
+        [&](int blockOffset, int hostOffset, int num) {
+          std::copy_n(output.begin() + blockOffset, num,
+                      hostOut.begin() + hostOffset);
+        });
+    result.insert(result.end(), hostOut.begin(), hostOut.end());
+  }
+  return result;
+}
+}  // namespace
+
+namespace {
+// Checks the output is the doubled input delayed by a block of 4 samples
+void expectDelayedByABlock(const std::vector<float>& out) {
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_EQ(out[i], 0.f);
+  }
+  for (int i = 4; i < static_cast<int>(out.size()); ++i) {
+    ASSERT_EQ(out[i], 2.f * (i - 3));
+  }
+}
+}  // namespace
+
+TEST(test_fixed_block_adapter, whole_blocks_pass_through) {
+  FixedBlockAdapter adapter;
+  adapter.prepare(4);
+  ASSERT_FALSE(adapter.isBuffered());
+  ASSERT_EQ(adapter.getLatencySamples(), 0);
+  int numProcessed = 0;
+  const std::vector<float> out = runBlocks(adapter, {4, 8, 4}, numProcessed);
+
+  ASSERT_EQ(numProcessed, 4);
+  for (int i = 0; i < static_cast<int>(out.size()); ++i) {
+    ASSERT_EQ(out[i], 2.f * (i + 1));
+  }
+}
+
+TEST(test_fixed_block_adapter, whole_blocks_delay_by_a_block) {
+  FixedBlockAdapter adapter;
+  adapter.prepare(4, true);
+  // The latency is known before any block is processed
+  ASSERT_EQ(adapter.getLatencySamples(), 4);
+  int numProcessed = 0;
+  const std::vector<float> out = runBlocks(adapter, {4, 8, 4}, numProcessed);
+
+  ASSERT_EQ(adapter.getLatencySamples(), 4);
+  ASSERT_EQ(numProcessed, 4);
+  expectDelayedByABlock(out);
+}
+
+TEST(test_fixed_block_adapter, uneven_blocks_delay_by_a_block) {
+  FixedBlockAdapter adapter;
+  adapter.prepare(4, true);
+  int numProcessed = 0;
+  const std::vector<float> out =
+      runBlocks(adapter, {4, 3, 1, 6, 2, 4}, numProcessed);
+
+  // Whole and uneven blocks share the same latency
+  ASSERT_EQ(adapter.getLatencySamples(), 4);
+  ASSERT_EQ(numProcessed, 5);
+  expectDelayedByABlock(out);
+
+  // Preparing again empties the FIFO
+  adapter.prepare(4, true);
+  numProcessed = 0;
+  expectDelayedByABlock(runBlocks(adapter, {2, 6}, numProcessed));
+  ASSERT_EQ(numProcessed, 2);
+}
+
+TEST(test_fixed_block_adapter, binaural_copy_stays_aligned) {
+  // Without buffering the copy is direct
+  ASSERT_EQ(BinauralRdr::createBinauralRdr(Speakers::kBinaural, 4, 48000)
+                ->getLatencySamples(),
+            0);
+
+  std::unique_ptr<Renderer> renderer =
+      BinauralRdr::createBinauralRdr(Speakers::kBinaural, 4, 48000, true);
+  juce::AudioBuffer<float> input(2, 3), output(2, 3);
+  for (int i = 0; i < 3; ++i) {
+    input.setSample(0, i, i + 1.f);
+    input.setSample(1, i, -(i + 1.f));
+  }
+  output.clear();
+  // The copy is delayed like a binaural renderer of the same block size
+  ASSERT_EQ(renderer->getLatencySamples(), 4);
+  renderer->render(input, output);
+  ASSERT_EQ(output.getSample(0, 2), 0.f);
+
+  renderer->render(input, output);
+  ASSERT_EQ(output.getSample(0, 0), 0.f);
+  ASSERT_EQ(output.getSample(0, 1), 1.f);
+  ASSERT_EQ(output.getSample(1, 2), -2.f);
+}
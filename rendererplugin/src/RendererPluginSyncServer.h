@@ -17,25 +17,23 @@
 #pragma once
 
 #include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <thread>
 #include <vector>
 
+#include "SyncSocketServer.h"
 #include "data_repository/implementation/AudioElementRepository.h"
 #include "data_repository/implementation/AudioElementSpatialLayoutRepository.h"
 #include "data_repository/repository_base/RepositoryBase.h"
 #include "data_structures/src/AudioElementSpatialLayout.h"
 #include "data_structures/src/RepositoryItem.h"
+#include "data_structures/src/RepositorySync.h"
+#include "data_structures/src/SyncConnectionManager.h"
 #include "substream_rdr/substream_rdr_utils/Speakers.h"
 
-class AudioElementPluginConnection;
-
-class SyncServer {
- public:
-  virtual void repositoryUpdated(
-      AudioElementPluginConnection* updatedAudioElementPlugin) = 0;
-  virtual void connectionLost(AudioElementPluginConnection* connection) = 0;
-};
-
 class AudioElementPluginUpdateListener {
  public:
   virtual void updateAudioElementPluginInformation(
@@ -46,26 +44,21 @@ class AudioElementPluginUpdateListener {
 
 /* ================
 AudioElementPlugin Connection class for maintaining information about
-connections to Audio Element Plugins
+connections to Audio Element Plugins. Only used on the message thread.
 ==================*/
-class AudioElementPluginConnection : public juce::InterprocessConnection {
+class AudioElementPluginConnection {
  private:
   AudioElementSpatialLayoutRepository sharedRepository_;
-  juce::CriticalSection repositoryLock_;  // Use lock to prevent read/write
-                                          // conflicts on the repository
-  SyncServer* managingServer_;
+  RepositorySync::Decoder decoder_;
   bool initialized_;
+  // Set until the client has been sent the full audio element repository
+  bool needsFullState_;
 
  public:
-  AudioElementPluginConnection(SyncServer* managingServerInstance)
-      : sharedRepository_(),
-        managingServer_(managingServerInstance),
-        initialized_(false) {}
-
-  ~AudioElementPluginConnection() override { disconnect(30000); }
+  AudioElementPluginConnection()
+      : sharedRepository_(), initialized_(false), needsFullState_(true) {}
 
   juce::Uuid getId() const {
-    const juce::ScopedLock lock(repositoryLock_);
     if (initialized_) {
       return sharedRepository_.get().getId();
     } else {
@@ -74,7 +67,6 @@ class AudioElementPluginConnection : public juce::InterprocessConnection {
   }
 
   juce::Uuid getAudioElementId() const {
-    const juce::ScopedLock lock(repositoryLock_);
     if (initialized_) {
       return sharedRepository_.get().getAudioElementId();
     } else {
@@ -83,8 +75,6 @@ class AudioElementPluginConnection : public juce::InterprocessConnection {
   }
 
   juce::String getName() const {
-    const juce::ScopedLock lock(repositoryLock_);
-
     if (initialized_) {
       return sharedRepository_.get().getName();
     } else {
@@ -92,23 +82,26 @@ class AudioElementPluginConnection : public juce::InterprocessConnection {
     }
   }
 
-  void sendRepository(juce::MemoryBlock& block) { sendMessage(block); }
-
-  void connectionMade() override {}
+  bool isInitialized() const { return initialized_; }
 
-  void connectionLost() override { managingServer_->connectionLost(this); }
+  bool needsFullState() const { return needsFullState_; }
 
-  void messageReceived(const juce::MemoryBlock& message) override {
-    juce::MemoryInputStream stream(message, false);
-    juce::ValueTree repository = juce::ValueTree::readFromStream(stream);
-
-    // Lock before we write to ensure no conflicts
-    const juce::ScopedLock lock(repositoryLock_);
-    sharedRepository_.setStateTree(repository);
-    initialized_ = true;
+  void setNeedsFullState(const bool needsFullState) {
+    needsFullState_ = needsFullState;
+  }
 
-    // Finally, notify the managing server
-    managingServer_->repositoryUpdated(this);
+  // Apply a message from the plugin to its layout repository
+  RepositorySync::Decoder::Result receive(const juce::MemoryBlock& message) {
+    juce::ValueTree repository = sharedRepository_.getTree();
+    const RepositorySync::Decoder::Result result =
+        decoder_.apply(message, repository);
+    if (result == RepositorySync::Decoder::Result::kApplied) {
+      if (repository != sharedRepository_.getTree()) {
+        sharedRepository_.setStateTree(repository);
+      }
+      initialized_ = true;
+    }
+    return result;
   }
 };
 
@@ -116,27 +109,32 @@ class AudioElementPluginConnection : public juce::InterprocessConnection {
 Renderer Plugin Server class for distributing information about the audio
 elements to AudioElementPlugins and registering AudioElementPlugin instances
 
-Note that this needs to all be handled in a header file due the
-juce::InterprocessConnectionServer implementation not fixing an incomplete
-type error during compilation.
+All plugin connections are served by a single SyncSocketServer thread, whose
+events are handled on the message thread.
 ==================*/
-class RendererPluginSyncServer : public juce::InterprocessConnectionServer,
-                                 juce::ValueTree::Listener,
-                                 SyncServer {
+class RendererPluginSyncServer : SyncSocketServer::Listener,
+                                 juce::ValueTree::Listener {
  private:
+  using ConnectionId = SyncSocketServer::ConnectionId;
+
   AudioElementRepository*
       outgoingRepository_;  // The audio element repository to be sent to all
                             // Audio Element Plugins
 
-  std::vector<AudioElementPluginConnection*>
+  std::map<ConnectionId, std::unique_ptr<AudioElementPluginConnection>>
       connections_;  // All currently registered AudioElementPlugins
   juce::CriticalSection
       repositoryLock_;  // Use lock to prevent writing from multiple threads
   AudioElementPluginUpdateListener* listener_;
   int connectionPort;
+  RepositorySync::Encoder encoder_;  // Guarded by repositoryLock_
+  SyncSocketServer socketServer_;
+  juce::WeakReference<RendererPluginSyncServer> self_;
 
   // Variables for retrying the connections and handling premature deletion
   bool closing;
+  bool listening;
+  SyncServerPresence presence;  // Tells plugins when the server comes up
   std::thread connectionThread;
   std::mutex connectionMutex;
   std::condition_variable connectionCondition;
@@ -147,26 +145,41 @@ class RendererPluginSyncServer : public juce::InterprocessConnectionServer,
       : outgoingRepository_(toShare),
         listener_(listener),
         connectionPort(port),
-        closing(false) {
+        socketServer_(*this),
+        closing(false),
+        listening(false) {
+    self_ = this;
     outgoingRepository_->registerListener(this);
 
     connectionThread = std::thread([&]() {
       std::unique_lock<std::mutex> lock(connectionMutex);
+      int backoffMs = SyncConnectionManager::kMinBackoffMs;
       while (true) {
         if (closing) {
           return;
         }
         // Connect to the socket
-        bool res = beginWaitingForSocket(connectionPort);
+        bool res = socketServer_.start(connectionPort);
         if (!res) {
-          // If the connection fails, wait for a short amount of time and try
-          // again We want to retry fairly rapidly since we don't expect there
-          // to be multiple instances, and if we don't retry quickly things
-          // start to look weird on the AudioElementPlugins. Use a condition
-          // variable to wake up if we need to be deleted to avoid locking
-          // everything up on delete
-          connectionCondition.wait_for(lock, std::chrono::seconds(10));
+          // If the connection fails, most likely another renderer holds the
+          // port. Back off, but retry at once when a server stops listening.
+          // Use a condition variable to wake up if we need to be deleted to
+          // avoid locking everything up on delete
+          const uint32_t generation = presence.getGeneration();
+          const auto retryAt = std::chrono::steady_clock::now() +
+                               std::chrono::milliseconds(backoffMs);
+          while (!closing && presence.getGeneration() == generation &&
+                 std::chrono::steady_clock::now() < retryAt) {
+            connectionCondition.wait_for(
+                lock, std::chrono::milliseconds(
+                          SyncConnectionManager::kPresencePollMs));
+          }
+          backoffMs =
+              std::min(backoffMs * 2, SyncConnectionManager::kMaxBackoffMs);
         } else {
+          // Wake up the plugins waiting to connect
+          listening = true;
+          presence.notifyChanged();
           break;
         }
       }
@@ -174,41 +187,24 @@ class RendererPluginSyncServer : public juce::InterprocessConnectionServer,
   }
 
   ~RendererPluginSyncServer() override {
-    for (auto connection : connections_) {
-      connection->disconnect();
-      delete connection;
-    }
-    connections_.clear();
+    outgoingRepository_->deregisterListener(this);
     connectionMutex.lock();
     closing = true;
-    stop();
     connectionCondition.notify_all();
     connectionMutex.unlock();
     connectionThread.join();
-  }
 
-  // This callback is called each time a new client connects
-  juce::InterprocessConnection* createConnectionObject() override {
-    AudioElementPluginConnection* connection =
-        new AudioElementPluginConnection(this);
-    connections_.push_back(connection);
-    return connection;
-  }
+    socketServer_.stop();
+    connections_.clear();
 
-  // This callback is called each time a connection is disconnected
-  // and is used to remove the connection from the list of tracked connections
-  void connectionLost(AudioElementPluginConnection* connection) override {
-    AudioElementSpatialLayout audioElementSpatialLayoutInfo =
-        AudioElementSpatialLayout(connection->getId(), connection->getName(),
-                                  connection->getAudioElementId(), 0,
-                                  Speakers::kMono);
-    listener_->removeAudioElementPlugin(audioElementSpatialLayoutInfo);
-    connections_.erase(
-        std::remove(connections_.begin(), connections_.end(), connection),
-        connections_.end());
-    delete connection;
+    // Let a renderer waiting for the port take over
+    if (listening) {
+      presence.notifyChanged();
+    }
   }
 
+  int getNumConnections() const { return socketServer_.getNumConnections(); }
+
   void valueTreePropertyChanged(juce::ValueTree& treeWhosePropertyHasChanged,
                                 const juce::Identifier& property) override {
     juce::ignoreUnused(treeWhosePropertyHasChanged);
@@ -232,23 +228,106 @@ class RendererPluginSyncServer : public juce::InterprocessConnectionServer,
     updateClients();
   }
 
+  // Send the changes to the repository since the last update to the clients,
+  // and the full repository to clients that are new or lost track
   void updateClients() {
     // Prevent update clients from being called from
     // multiple threads simultaneuously
     juce::ScopedLock lock(repositoryLock_);
 
     juce::MemoryBlock block;
-    juce::MemoryOutputStream stream(block, false);
-    outgoingRepository_->writeToStream(stream);
-    for (auto connection : connections_) {
-      connection->sendRepository(block);
+    if (encoder_.encodeDelta(outgoingRepository_->getValueTree(), block)) {
+      for (auto& [id, connection] : connections_) {
+        if (!connection->needsFullState()) {
+          socketServer_.send(id, block);
+        }
+      }
+    }
+
+    for (auto& [id, connection] : connections_) {
+      if (connection->needsFullState()) {
+        socketServer_.send(id, encoder_.encodeLastState());
+        connection->setNeedsFullState(false);
+      }
     }
   }
 
-  void repositoryUpdated(AudioElementPluginConnection* updatedPanner) override {
-    juce::ignoreUnused(updatedPanner);
-    // First, update the clients (thread safe, since this is a callback
-    // thread)
+  // Send the full repository to every client, e.g. after it was replaced
+  void resyncClients() {
+    juce::ScopedLock lock(repositoryLock_);
+    for (auto& [id, connection] : connections_) {
+      connection->setNeedsFullState(true);
+    }
+    updateClients();
+  }
+
+ private:
+  // SyncSocketServer events arrive on its thread, handle them on the message
+  // thread like the repository changes
+  template <typename Callback>
+  void callOnMessageThread(Callback callback) {
+    juce::MessageManager::callAsync([self = self_, callback] {
+      if (self != nullptr) {
+        callback();
+      }
+    });
+  }
+
+  void connectionOpened(ConnectionId id) override {
+    callOnMessageThread([this, id] {
+      connections_[id] = std::make_unique<AudioElementPluginConnection>();
+      // Send the repository right away, so the plugin has it without waiting
+      // for its own layout to arrive
+      updateClients();
+    });
+  }
+
+  // Used to remove the connection from the list of tracked connections
+  void connectionClosed(ConnectionId id) override {
+    callOnMessageThread([this, id] {
+      auto it = connections_.find(id);
+      if (it == connections_.end()) {
+        return;
+      }
+      if (it->second->isInitialized()) {
+        AudioElementSpatialLayout audioElementSpatialLayoutInfo =
+            AudioElementSpatialLayout(it->second->getId(),
+                                      it->second->getName(),
+                                      it->second->getAudioElementId(), 0,
+                                      Speakers::kMono);
+        listener_->removeAudioElementPlugin(audioElementSpatialLayoutInfo);
+      }
+      connections_.erase(it);
+    });
+  }
+
+  void messageReceived(ConnectionId id,
+                       const juce::MemoryBlock& message) override {
+    callOnMessageThread([this, id, message] {
+      auto it = connections_.find(id);
+      if (it == connections_.end()) {
+        return;
+      }
+      AudioElementPluginConnection* connection = it->second.get();
+      switch (connection->receive(message)) {
+        case RepositorySync::Decoder::Result::kApplied:
+          repositoryUpdated(connection);
+          break;
+        case RepositorySync::Decoder::Result::kResyncRequired:
+          socketServer_.send(id, RepositorySync::encodeResyncRequest());
+          break;
+        case RepositorySync::Decoder::Result::kResyncRequested:
+          connection->setNeedsFullState(true);
+          updateClients();
+          break;
+        case RepositorySync::Decoder::Result::kInvalid:
+          break;
+      }
+    });
+  }
+
+  void repositoryUpdated(AudioElementPluginConnection* updatedPanner) {
+    // First, update the clients
     updateClients();
 
     // Need to callback here to something, probably the renderer plugin, to
@@ -260,4 +339,6 @@ class RendererPluginSyncServer : public juce::InterprocessConnectionServer,
     listener_->updateAudioElementPluginInformation(
         audioElementSpatialLayoutInfo);
   }
+
+  JUCE_DECLARE_WEAK_REFERENCEABLE(RendererPluginSyncServer)
 };
@@ -20,6 +20,7 @@
 #include "RendererVersionConverter.h"
 #include "data_repository/implementation/ActiveMixPresentationRepository.h"
 #include "data_structures/src/ActiveMixPresentation.h"
+#include "data_structures/src/CompactTreeCodec.h"
 #include "data_structures/src/MixPresentation.h"
 #include "data_structures/src/RoomSetup.h"
 #include "logger/logger.h"
@@ -30,6 +31,8 @@ RendererProcessor::RendererProcessor()
     : ProcessorBase(getHostWideLayout(), juce::AudioChannelSet::stereo()),
       // Load persistent state. Initialize repositories from persistent state.
       persistentState_(kRendererStateKey),
+      persistentStateCache_(persistentState_,
+                            CompactTreeCodec::Compression::kZlib),
       roomSetupRepository_(getTreeWithId(kRoomSetupKey)),
       audioElementRepository_(getTreeWithId(kAudioElementsKey)),
       mixPresentationRepository_(getTreeWithId(kMixPresentationsKey)),
@@ -52,6 +55,8 @@ RendererProcessor::RendererProcessor()
   LOG_ANALYTICS(instanceId_, "RendererProcessor instantiated.");
 
   // Construct processor chain.
+  audioProcessors_.push_back(std::make_unique<SharedAudioBusProcessor>(
+      this, &audioElementRepository_));
   audioProcessors_.push_back(
       std::make_unique<GainProcessor>(&multichannelgainRepository_));
   if (juce::PluginHostType().isPremiere()) {
@@ -70,6 +75,11 @@ RendererProcessor::RendererProcessor()
         fileExportRepository_, audioElementRepository_,
         mixPresentationRepository_, mixPresentationLoudnessRepository_));
   }
+  // Renders the additional export job layouts from the same pass as the
+  // primary export.
+  audioProcessors_.push_back(std::make_unique<ExportJobProcessor>(
+      fileExportRepository_, audioElementRepository_,
+      mixPresentationRepository_, activeMixPresentationRepository_));
   audioProcessors_.push_back(std::make_unique<ChannelMonitorProcessor>(
       channelMonitorData_, &mixPresentationRepository_,
       &mixPresentationSoloMuteRepository_));
@@ -83,6 +93,17 @@ RendererProcessor::RendererProcessor()
   audioProcessors_.push_back(std::make_unique<MixMonitorProcessor>(
       roomSetupRepository_, monitorData_));
   audioProcessors_.push_back(std::make_unique<RemappingProcessor>(this, true));
+
+  // The loudness, file and channel monitoring processors before the renderer
+  // only read the buffer and run together. They only have work to share
+  // during an export, so the chain runs serially, without starting any
+  // workers, until the host first goes offline.
+  std::vector<ProcessorBase*> chain;
+  for (const auto& proc : audioProcessors_) {
+    chain.push_back(proc.get());
+  }
+  chainScheduler_.setProcessors(chain);
+
   // 28 is the maximum number of channels an IAMF file can contain
   juce::AudioChannelSet outputChannels;
   for (int i = 0; i < 28; i++) {
@@ -94,7 +115,11 @@ RendererProcessor::RendererProcessor()
   roomSetupRepository_.registerListener(this);
 }
 
-RendererProcessor::~RendererProcessor() { audioProcessors_.clear(); }
+RendererProcessor::~RendererProcessor() {
+  // Stop the chain's workers before the processors they run go away
+  chainScheduler_.setProcessors({});
+  audioProcessors_.clear();
+}
 
 bool RendererProcessor::isBusesLayoutSupported(
     const BusesLayout& layouts) const {
@@ -153,7 +178,19 @@ void RendererProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
   for (const auto& proc : audioProcessors_) {
     proc->prepareToPlay(sampleRate, samplesPerBlock);
   }
-  processingBuffer_.setSize(getMainBusNumInputChannels(), samplesPerBlock);
+  isPrepared_ = true;
+  // Audio elements read from the shared audio bus may be placed beyond the
+  // host bus, up to the largest profile's channel count, in blocks of up to
+  // the bus's block size
+  const int numChannels =
+      std::max(getMainBusNumInputChannels(),
+               FileProfileHelper::profileChannels(BASE_ENHANCED));
+  const int maxSamples =
+      std::max(samplesPerBlock, SharedAudioBlock::kMaxSamples);
+  processingBuffer_.prepare(numChannels, maxSamples);
+  channelPointers_.assign(numChannels, nullptr);
+  chainScheduler_.prepare(numChannels, maxSamples);
+  exportRange_.rewind();
   LOG_ANALYTICS(instanceId_, "activeMixPresentation Uuid: " +
                                  activeMixPresentationRepository_.get()
                                      .getActiveMixId()
@@ -165,6 +202,7 @@ void RendererProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
 void RendererProcessor::releaseResources() {
   // When playback stops, you can use this as an opportunity to free up any
   // spare memory, etc.
+  isPrepared_ = false;
 }
 
 void RendererProcessor::setNonRealtime(bool isNonRealtime) noexcept {
@@ -173,6 +211,13 @@ void RendererProcessor::setNonRealtime(bool isNonRealtime) noexcept {
   for (const auto& proc : audioProcessors_) {
     proc->setNonRealtime(isNonRealtime);
   }
+  chainScheduler_.setParallel(isNonRealtime);
+
+  const FileExport config = fileExportRepository_.get();
+  exportRange_.reset(getSampleRate(), config.getStartTime(),
+                     config.getEndTime());
+  skippingLeadIn_ =
+      isNonRealtime && config.getExportAudio() && config.getStartTime() > 0;
 }
 
 void RendererProcessor::processBlock(juce::AudioBuffer<float>& buffer,
@@ -196,22 +241,51 @@ void RendererProcessor::processBlock(juce::AudioBuffer<float>& buffer,
   for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
     buffer.clear(i, 0, buffer.getNumSamples());
 
-  // Copy the input buffer into the processing buffer
-  // We do this since we may want to modify audio element audio or render
-  // to more channels than are available on output. ProTools makes channels
-  // beyond the playback layout channel read-only in the buffer, so we
-  // need to copy the data into a buffer we can modify.
-  for (int ch = 0; ch < totalNumInputChannels; ++ch) {
-    processingBuffer_.copyFrom(ch, 0, buffer, ch, 0, buffer.getNumSamples());
+  // Nothing before the start of an offline export's range is exported, so
+  // skip rendering, loudness measurement and encoding for those blocks.
+  if (skippingLeadIn_) {
+    if (exportRange_.isBeforeStart(buffer.getNumSamples())) {
+      exportRange_.advance(buffer.getNumSamples());
+      for (const auto& proc : audioProcessors_) {
+        proc->skipBlock(buffer.getNumSamples());
+      }
+      buffer.clear();
+      return;
+    }
+    skippingLeadIn_ = false;
   }
 
-  for (const auto& proc : audioProcessors_)
-    proc->processBlock(processingBuffer_, midiMessages);
+  // The chain runs on the host's output channels in place. We may modify
+  // audio element audio or render to more channels than are available on
+  // output, and ProTools makes channels beyond the playback layout read-only
+  // in the buffer, so the remaining channels are scratch channels holding a
+  // copy of any input they carry.
+  const int numChannels = processingBuffer_.getMaxChannels();
+  const int numWritable = std::min(
+      {totalNumOutputChannels, buffer.getNumChannels(), numChannels});
+  const int numInputs = std::min(
+      {totalNumInputChannels, buffer.getNumChannels(), numChannels});
+  // Some hosts pass larger blocks than prepared, mostly when rendering
+  // offline. The chain runs on those a prepared block at a time; the shared
+  // audio bus carries nothing for them anyway.
+  const int numSamples = buffer.getNumSamples();
+  const int blockSize = processingBuffer_.getMaxSamples();
+  for (int start = 0; start < numSamples && blockSize > 0;
+       start += blockSize) {
+    const int blockSamples = std::min(blockSize, numSamples - start);
+    for (int ch = 0; ch < numWritable; ++ch) {
+      channelPointers_[ch] = buffer.getWritePointer(ch, start);
+    }
+    juce::AudioBuffer<float>& block = processingBuffer_.alias(
+        numChannels, blockSamples, channelPointers_.data(), numWritable);
+    for (int ch = numWritable; ch < numInputs; ++ch) {
+      block.copyFrom(ch, 0, buffer, ch, start, blockSamples);
+    }
+    for (int ch = std::max(numWritable, numInputs); ch < numChannels; ++ch) {
+      block.clear(ch, 0, blockSamples);
+    }
 
-  // Copy the processing buffer back to the output buffer
-  // Copy back only the number of channels that the DAW expects to render
-  for (int ch = 0; ch < totalNumOutputChannels; ++ch) {
-    buffer.copyFrom(ch, 0, processingBuffer_, ch, 0, buffer.getNumSamples());
+    chainScheduler_.process(block, midiMessages);
   }
 }
 
@@ -234,23 +308,31 @@ void RendererProcessor::getStateInformation(juce::MemoryBlock& destData) {
   persistentState_.setProperty("version", ECLIPSA_VERSION, nullptr);
 #endif
 
-  copyXmlToBinary(*persistentState_.createXml(), destData);
+  destData = persistentStateCache_.getEncoded();
 }
 
 void RendererProcessor::setStateInformation(const void* data, int sizeInBytes) {
   LOG_ANALYTICS(instanceId_, "RendererProcessor setStateInformation \n");
-  std::unique_ptr<juce::XmlElement> xmlState(
-      getXmlFromBinary(data, sizeInBytes));
-
-  if (xmlState.get() && xmlState->hasTagName(persistentState_.getType())) {
-    persistentState_ = juce::ValueTree::fromXml(*xmlState);
+  juce::ValueTree state = CompactTreeCodec::decode(data, sizeInBytes);
+  if (!state.isValid()) {
+    // Sessions saved before the compact encoding store XML
+    std::unique_ptr<juce::XmlElement> xmlState(
+        getXmlFromBinary(data, sizeInBytes));
+    if (xmlState.get()) {
+      state = juce::ValueTree::fromXml(*xmlState);
+    }
   }
 
-  // Check the version converstion to see if version upgrade is needed and apply
-  // upgrades Do this before updating repositories since if we load the
-  // repositories and then update their values, it will cause tree change events
-  // on the processors, which normally updating the repositories would not do.
-  RendererVersionConverter::convertToLatestVersion(xmlState);
+  if (state.hasType(persistentState_.getType())) {
+    // Check the version converstion to see if version upgrade is needed and
+    // apply upgrades Do this before updating repositories since if we load the
+    // repositories and then update their values, it will cause tree change
+    // events on the processors, which normally updating the repositories would
+    // not do.
+    RendererVersionConverter::convertToLatestVersion(state);
+    persistentState_ = state;
+    persistentStateCache_.setStateTree(persistentState_);
+  }
 
   updateRepositories();
 
@@ -493,7 +575,13 @@ void RendererProcessor::configureOutputBus() {
 
 void RendererProcessor::reinitializeAfterStateRestore() {
   // Broadcast initial element list/layout to plugins after state load
-  syncServer_.updateClients();
+  syncServer_.resyncClients();
+
+  // Every processor rebuilds from the restored repositories in prepareToPlay,
+  // so renderers are not constructed until the host is about to play
+  if (!isPrepared_) {
+    return;
+  }
 
   // Notify and reinitialize all child processors as needed
   for (auto& proc : audioProcessors_) {
@@ -20,7 +20,9 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <processors/processors.h>
 
+#include <atomic>
 #include <memory>
+#include <vector>
 
 #include "RendererPluginSyncServer.h"
 #include "data_repository/implementation/AudioElementSpatialLayoutRepository.h"
@@ -29,7 +31,9 @@
 #include "data_repository/implementation/RoomSetupRepository.h"
 #include "data_structures/src/AudioElementCommunication.h"
 #include "data_structures/src/ChannelMonitorData.h"
+#include "data_structures/src/CompactStateCache.h"
 #include "data_structures/src/RepositoryCollection.h"
+#include "processors/file_output/ExportRange.h"
 #include "processors/processor_base/ProcessorBase.h"
 
 //==============================================================================
@@ -118,8 +122,17 @@ class RendererProcessor final : public ProcessorBase,
   juce::ValueTree getTreeWithId(const juce::Identifier& id);
 
   std::vector<std::unique_ptr<ProcessorBase>> audioProcessors_;
+  ProcessorChainScheduler chainScheduler_;
 
-  juce::AudioBuffer<float> processingBuffer_;
+  // The host buffer's output channels followed by scratch channels, see
+  // processBlock
+  ChannelAliasBuffer processingBuffer_;
+  std::vector<float*> channelPointers_;
+
+  // Position of an offline export, used to skip the chain for the blocks
+  // before the start time.
+  ExportRange exportRange_;
+  bool skippingLeadIn_ = false;
 
   AudioElementSubscriber audioElementSubscriber_;
 
@@ -130,6 +143,12 @@ class RendererProcessor final : public ProcessorBase,
 
   juce::ValueTree persistentState_;
   inline static const juce::Identifier kRendererStateKey{"re_state"};
+  // Hosts autosave far more often than the state changes
+  CompactStateCache persistentStateCache_;
+
+  // Set between prepareToPlay and releaseResources. A state restored before
+  // then leaves rebuilding the processor chain to prepareToPlay.
+  std::atomic<bool> isPrepared_{false};
 
   RoomSetupRepository roomSetupRepository_;
   inline static const juce::Identifier kRoomSetupKey{"room_setup"};
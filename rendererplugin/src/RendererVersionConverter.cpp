@@ -35,3 +35,15 @@ void RendererVersionConverter::convertFrom_NoVersion_To_1p1p1(
     std::unique_ptr<juce::XmlElement>& xmlState) {
   xmlState->setAttribute("version", "1.1.1");
 }
+
+void RendererVersionConverter::convertToLatestVersion(juce::ValueTree& state) {
+  // Kept in step with the XML conversions above
+  if (!state.hasProperty("version")) {
+    convertFrom_NoVersion_To_1p1p1(state);
+  }
+}
+
+void RendererVersionConverter::convertFrom_NoVersion_To_1p1p1(
+    juce::ValueTree& state) {
+  state.setProperty("version", "1.1.1", nullptr);
+}
@@ -25,8 +25,13 @@ class RendererVersionConverter {
   static void convertToLatestVersion(
       std::unique_ptr<juce::XmlElement>& xmlState);
 
+  // As above, for state restored as a tree, e.g. from the compact binary
+  // encoding.
+  static void convertToLatestVersion(juce::ValueTree& state);
+
  private:
   // Helper function to convert from an older version to a newer version.
   static void convertFrom_NoVersion_To_1p1p1(
       std::unique_ptr<juce::XmlElement>& xmlState);
+  static void convertFrom_NoVersion_To_1p1p1(juce::ValueTree& state);
 };
\ No newline at end of file
@@ -0,0 +1,325 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SyncSocketServer.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+
+namespace {
+#if defined(MSG_NOSIGNAL)
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0;  // SO_NOSIGPIPE is set on the socket instead
+#endif
+
+constexpr size_t kHeaderBytes = 2 * sizeof(uint32_t);
+
+bool setNonBlocking(const int fd) {
+  const int flags = ::fcntl(fd, F_GETFL, 0);
+  return flags >= 0 && ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+void configureConnection(const int fd) {
+  setNonBlocking(fd);
+  const int enable = 1;
+  // Repository updates are small, send them without waiting to coalesce
+  ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+#if defined(SO_NOSIGPIPE)
+  ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &enable, sizeof(enable));
+#endif
+}
+}  // namespace
+
+SyncSocketServer::SyncSocketServer(Listener& listener, const uint32_t magic)
+    : listener_(listener), magic_(magic) {}
+
+SyncSocketServer::~SyncSocketServer() { stop(); }
+
+bool SyncSocketServer::start(const int port) {
+  if (running_) {
+    return true;
+  }
+
+  const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0) {
+    return false;
+  }
+  const int enable = 1;
+  ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(static_cast<uint16_t>(port));
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+      ::listen(fd, SOMAXCONN) < 0 || !setNonBlocking(fd)) {
+    ::close(fd);
+    return false;
+  }
+  if (::pipe(wakeFds_) < 0) {
+    ::close(fd);
+    return false;
+  }
+  setNonBlocking(wakeFds_[0]);
+  setNonBlocking(wakeFds_[1]);
+
+  listenFd_ = fd;
+  running_ = true;
+  thread_ = std::thread([this] { run(); });
+  return true;
+}
+
+void SyncSocketServer::stop() {
+  if (!running_.exchange(false)) {
+    return;
+  }
+  wake();
+  thread_.join();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& [id, connection] : connections_) {
+    ::close(connection.fd);
+  }
+  connections_.clear();
+  ::close(listenFd_);
+  ::close(wakeFds_[0]);
+  ::close(wakeFds_[1]);
+  listenFd_ = wakeFds_[0] = wakeFds_[1] = -1;
+}
+
+bool SyncSocketServer::send(const ConnectionId id,
+                            const juce::MemoryBlock& message) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = connections_.find(id);
+  if (it == connections_.end() || it->second.closing) {
+    return false;
+  }
+
+  Connection& connection = it->second;
+  const size_t queued = connection.output.size() - connection.outputOffset;
+  if (queued + kHeaderBytes + message.getSize() > kMaxQueuedBytes) {
+    connection.closing = true;
+    wake();
+    return false;
+  }
+
+  const uint32_t header[2] = {
+      juce::ByteOrder::swapIfBigEndian(magic_),
+      juce::ByteOrder::swapIfBigEndian(
+          static_cast<uint32_t>(message.getSize()))};
+  const char* headerBytes = reinterpret_cast<const char*>(header);
+  const char* data = static_cast<const char*>(message.getData());
+  connection.output.insert(connection.output.end(), headerBytes,
+                           headerBytes + kHeaderBytes);
+  connection.output.insert(connection.output.end(), data,
+                           data + message.getSize());
+
+  // Write straight away if nothing was queued, the server's thread only
+  // needs to get involved when the socket is full
+  if (queued == 0) {
+    if (!flush(connection)) {
+      connection.closing = true;
+      wake();
+      return false;
+    }
+    if (connection.output.empty()) {
+      return true;
+    }
+  }
+  wake();
+  return true;
+}
+
+void SyncSocketServer::close(const ConnectionId id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = connections_.find(id);
+  if (it != connections_.end()) {
+    it->second.closing = true;
+    wake();
+  }
+}
+
+int SyncSocketServer::getNumConnections() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return static_cast<int>(connections_.size());
+}
+
+void SyncSocketServer::run() {
+  std::vector<pollfd> fds;
+  std::vector<ConnectionId> ids;
+  while (running_) {
+    fds.clear();
+    ids.clear();
+    fds.push_back({listenFd_, POLLIN, 0});
+    fds.push_back({wakeFds_[0], POLLIN, 0});
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (const auto& [id, connection] : connections_) {
+        short events = POLLIN;
+        if (connection.outputOffset < connection.output.size()) {
+          events |= POLLOUT;
+        }
+        fds.push_back({connection.fd, events, 0});
+        ids.push_back(id);
+      }
+    }
+
+    if (::poll(fds.data(), static_cast<nfds_t>(fds.size()), -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;
+    }
+    if (fds[1].revents & POLLIN) {
+      char drain[64];
+      while (::read(wakeFds_[0], drain, sizeof(drain)) > 0) {
+      }
+    }
+    if (!running_) {
+      break;
+    }
+    if (fds[0].revents & POLLIN) {
+      acceptConnections();
+    }
+
+    // Only this thread removes connections, so the entries stay valid
+    for (size_t i = 0; i < ids.size(); ++i) {
+      const short events = fds[i + 2].revents;
+      Connection& connection = connections_.at(ids[i]);
+      const bool failed = (events & (POLLERR | POLLNVAL)) ||
+                          ((events & POLLHUP) && !(events & POLLIN));
+      if (failed || ((events & POLLIN) && !readFrom(ids[i], connection))) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        connection.closing = true;
+      }
+    }
+
+    std::vector<ConnectionId> closed;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (auto& [id, connection] : connections_) {
+        if (connection.closing || !flush(connection)) {
+          ::close(connection.fd);
+          closed.push_back(id);
+        }
+      }
+      for (const ConnectionId id : closed) {
+        connections_.erase(id);
+      }
+    }
+    for (const ConnectionId id : closed) {
+      listener_.connectionClosed(id);
+    }
+  }
+}
+
+void SyncSocketServer::acceptConnections() {
+  while (true) {
+    const int fd = ::accept(listenFd_, nullptr, nullptr);
+    if (fd < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return;
+    }
+    configureConnection(fd);
+
+    ConnectionId id;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      id = nextId_++;
+      connections_[id].fd = fd;
+    }
+    listener_.connectionOpened(id);
+  }
+}
+
+bool SyncSocketServer::readFrom(const ConnectionId id,
+                                Connection& connection) {
+  std::vector<char>& input = connection.input;
+  char buffer[64 * 1024];
+  while (true) {
+    const ssize_t numRead = ::recv(connection.fd, buffer, sizeof(buffer), 0);
+    if (numRead > 0) {
+      input.insert(input.end(), buffer, buffer + numRead);
+      if (static_cast<size_t>(numRead) < sizeof(buffer)) {
+        break;
+      }
+    } else if (numRead == 0) {
+      return false;
+    } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      break;
+    } else if (errno != EINTR) {
+      return false;
+    }
+  }
+
+  // Dispatch every complete message
+  while (input.size() - connection.inputOffset >= kHeaderBytes) {
+    const char* frame = input.data() + connection.inputOffset;
+    const uint32_t magic = juce::ByteOrder::littleEndianInt(frame);
+    const uint32_t size = juce::ByteOrder::littleEndianInt(frame + 4);
+    if (magic != magic_ || size > kMaxMessageBytes) {
+      return false;
+    }
+    if (input.size() - connection.inputOffset - kHeaderBytes < size) {
+      break;
+    }
+    const juce::MemoryBlock message(frame + kHeaderBytes, size);
+    connection.inputOffset += kHeaderBytes + size;
+    if (size > 0) {
+      listener_.messageReceived(id, message);
+    }
+  }
+
+  // Keep only the partial message
+  input.erase(input.begin(), input.begin() + connection.inputOffset);
+  connection.inputOffset = 0;
+  return true;
+}
+
+bool SyncSocketServer::flush(Connection& connection) {
+  while (connection.outputOffset < connection.output.size()) {
+    const char* data = connection.output.data() + connection.outputOffset;
+    const size_t size = connection.output.size() - connection.outputOffset;
+    const ssize_t numSent = ::send(connection.fd, data, size, kSendFlags);
+    if (numSent > 0) {
+      connection.outputOffset += static_cast<size_t>(numSent);
+    } else if (numSent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      return true;
+    } else if (numSent < 0 && errno == EINTR) {
+      continue;
+    } else {
+      return false;
+    }
+  }
+  connection.output.clear();
+  connection.outputOffset = 0;
+  return true;
+}
+
+void SyncSocketServer::wake() {
+  const char byte = 0;
+  // A full pipe already guarantees a wakeup
+  [[maybe_unused]] const ssize_t numWritten =
+      ::write(wakeFds_[1], &byte, sizeof(byte));
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Accepts connections from juce::InterprocessConnection clients on the
+// loopback interface, and serves all of them from a single poll() thread.
+// Messages use the InterprocessConnection framing: a magic number and a
+// payload size, both little endian 32 bit, followed by the payload.
+class SyncSocketServer {
+ public:
+  using ConnectionId = uint32_t;
+
+  // Called on the server's thread. The listener may call send() and close().
+  class Listener {
+   public:
+    virtual ~Listener() = default;
+    virtual void connectionOpened(ConnectionId id) = 0;
+    virtual void connectionClosed(ConnectionId id) = 0;
+    virtual void messageReceived(ConnectionId id,
+                                 const juce::MemoryBlock& message) = 0;
+  };
+
+  // Default magic number of juce::InterprocessConnection
+  inline static constexpr uint32_t kDefaultMagic = 0xf2b49e2c;
+  // Larger incoming messages close the connection
+  inline static constexpr uint32_t kMaxMessageBytes = 16 * 1024 * 1024;
+  // A client that falls this far behind is disconnected, it resyncs when it
+  // reconnects
+  inline static constexpr size_t kMaxQueuedBytes = 4 * 1024 * 1024;
+
+  explicit SyncSocketServer(Listener& listener, uint32_t magic = kDefaultMagic);
+  ~SyncSocketServer();
+
+  // Start listening on the port, returns false if it cannot be bound.
+  bool start(int port);
+
+  // Close all connections without notifying the listener, and stop.
+  void stop();
+
+  bool isRunning() const { return running_; }
+
+  // Queue a message for a connection. Returns false if the connection is
+  // gone, or was closed because its queue overflowed. Thread safe.
+  bool send(ConnectionId id, const juce::MemoryBlock& message);
+
+  // Close a connection, the listener is notified. Thread safe.
+  void close(ConnectionId id);
+
+  int getNumConnections() const;
+
+ private:
+  struct Connection {
+    int fd = -1;
+    std::vector<char> input;
+    size_t inputOffset = 0;  // Start of the first unparsed frame
+    std::vector<char> output;
+    size_t outputOffset = 0;  // Start of the unsent bytes
+    bool closing = false;
+  };
+
+  void run();
+  void acceptConnections();
+  // Read and dispatch complete messages, returns false to close
+  bool readFrom(ConnectionId id, Connection& connection);
+  // Send queued bytes until the socket is full, returns false to close
+  bool flush(Connection& connection);
+  void wake();
+
+  Listener& listener_;
+  const uint32_t magic_;
+  int listenFd_ = -1;
+  int wakeFds_[2] = {-1, -1};
+  std::atomic<bool> running_{false};
+  std::thread thread_;
+
+  // Guards the connection map and the output queues. Connections are only
+  // added and removed by the server's thread, which also owns the input.
+  mutable std::mutex mutex_;
+  std::unordered_map<ConnectionId, Connection> connections_;
+  ConnectionId nextId_ = 1;
+};
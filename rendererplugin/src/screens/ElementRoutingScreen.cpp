@@ -276,13 +276,17 @@ void ElementRoutingScreen::updateAudioElementChannels() {
   bool success = true;
   int currentChannelNumber = 0;
   int totalChannels = 0;
-  for (auto* audioElement : audioElementArray) {
-    audioElement->setFirstChannel(currentChannelNumber);
-    audioElementRepository_->update(*audioElement);
-    currentChannelNumber += audioElement->getChannelCount();
-    audioElementColumns_.push_back(
-        std::make_unique<AudioElementColumn>(*audioElement, this));
-    totalChannels += audioElement->getChannelCount();
+  {
+    // Renumbering every element is one change for listeners that rebuild
+    auto transaction = audioElementRepository_->beginTransaction();
+    for (auto* audioElement : audioElementArray) {
+      audioElement->setFirstChannel(currentChannelNumber);
+      audioElementRepository_->update(*audioElement);
+      currentChannelNumber += audioElement->getChannelCount();
+      audioElementColumns_.push_back(
+          std::make_unique<AudioElementColumn>(*audioElement, this));
+      totalChannels += audioElement->getChannelCount();
+    }
   }
 
   // Validate the profile selection and revert if necessary
@@ -18,6 +18,8 @@
 #include "components/src/EclipsaColours.h"
 #include "data_structures/src/FileExport.h"
 #include "data_structures/src/MixPresentation.h"
+#include "data_structures/src/RoomSetup.h"
+#include "processors/file_output/iamf_export_utils/ExportProfile.h"
 
 FileExportScreen::FileExportScreen(MainEditor& editor,
                                    RepositoryCollection repos)
@@ -38,6 +40,8 @@ FileExportScreen::FileExportScreen(MainEditor& editor,
       muxVidoeLabel_("MuxVideoLbl", "Mux video"),
       exportVideoFolder_("Save video to ..."),
       videoSource_("Video source"),
+      exportJobLayoutSelector_("Additional layout"),
+      clearExportJobsButton_("Clear layouts"),
       audioOutputSelect_(
           "Select a file to export audio to",
           juce::File::getSpecialLocation(juce::File::userDesktopDirectory),
@@ -50,6 +54,10 @@ FileExportScreen::FileExportScreen(MainEditor& editor,
           "Select a file to output mux video to",
           juce::File::getSpecialLocation(juce::File::userDesktopDirectory),
           "*.mp4;*.mov"),
+      exportJobSelect_(
+          "Select a WAV file to export the layout to",
+          juce::File::getSpecialLocation(juce::File::userDesktopDirectory),
+          "*.wav"),
       exportButton_("Start Export"),
       repository_(&repos.fioRepo_),
       aeRepository_(&repos.aeRepo_),
@@ -66,7 +74,9 @@ FileExportScreen::FileExportScreen(MainEditor& editor,
   juce::Colour textColour = juce::Colour(221, 228, 227);
   exportAudioElementsLabel_.setColour(juce::Label::textColourId, textColour);
   exportAudioLabel_.setColour(juce::Label::textColourId, textColour);
+  exportProfileLabel_.setColour(juce::Label::textColourId, textColour);
   muxVidoeLabel_.setColour(juce::Label::textColourId, textColour);
+  exportJobsLabel_.setColour(juce::Label::textColourId, textColour);
   startTimerErrorLabel_.setColour(juce::Label::ColourIds::textColourId,
                                   EclipsaColours::red);
   endTimerErrorLabel_.setColour(juce::Label::ColourIds::textColourId,
@@ -81,6 +91,10 @@ FileExportScreen::FileExportScreen(MainEditor& editor,
       juce::Font("Roboto", 16.0f, juce::Font::plain));
   exportAudioLabel_.setFont(textFont);
   muxVidoeLabel_.setFont(textFont);
+  exportProfileLabel_.setFont(juce::Font("Roboto", 12.0f, juce::Font::plain));
+  exportProfileLabel_.setJustificationType(juce::Justification::topLeft);
+  exportJobsLabel_.setFont(juce::Font("Roboto", 12.0f, juce::Font::plain));
+  exportJobsLabel_.setJustificationType(juce::Justification::topLeft);
   startTimerErrorLabel_.setFont(juce::Font("Roboto", 12.0f, juce::Font::plain));
   endTimerErrorLabel_.setFont(juce::Font("Roboto", 12.0f, juce::Font::plain));
   startTimerErrorLabel_.setJustificationType(juce::Justification::topLeft);
@@ -114,6 +128,10 @@ FileExportScreen::FileExportScreen(MainEditor& editor,
                                      juce::Colours::transparentBlack,
                                      folderImage, 0.5f, juce::Colours::grey,
                                      folderImage, 0.8f, juce::Colours::white);
+  browseExportJobButton_.setImages(false, true, true, folderImage, 1.0f,
+                                   juce::Colours::transparentBlack, folderImage,
+                                   0.5f, juce::Colours::grey, folderImage, 0.8f,
+                                   juce::Colours::white);
 
   // Add the format options
   formatSelector_.addOption("IAMF");
@@ -200,6 +218,24 @@ FileExportScreen::FileExportScreen(MainEditor& editor,
   };
   videoSource_.setText(config.getVideoSource());
 
+  // Configure the additional layouts rendered during the export
+  for (const RoomLayout& layout : speakerLayoutConfigurationOptions) {
+    exportJobLayoutSelector_.addOption(layout.getDescription());
+  }
+  browseExportJobButton_.onClick = [this] {
+    exportJobSelect_.launchAsync(
+        juce::FileBrowserComponent::saveMode |
+            juce::FileBrowserComponent::canSelectFiles,
+        [this](const auto& file) {
+          if (file.getResult() != juce::File()) {
+            addExportJob(file.getResult().withFileExtension(".wav"));
+          }
+        });
+  };
+  clearExportJobsButton_.onClick = [this] {
+    getExportJobRepository(*repository_).clear();
+  };
+
   exportAudioElementsToggle_.setToggleState(
       config.getExportAudioElements(),
       juce::NotificationType::dontSendNotification);
@@ -279,6 +315,9 @@ FileExportScreen::FileExportScreen(MainEditor& editor,
       exportVideoFolder_.setEnabled(false);
       browseVideoButton_.setEnabled(false);
       browseVideoSourceButton_.setEnabled(false);
+      exportJobLayoutSelector_.setEnabled(false);
+      browseExportJobButton_.setEnabled(false);
+      clearExportJobsButton_.setEnabled(false);
 
     } else {
       startTimer_.setEnabled(true);
@@ -295,6 +334,9 @@ FileExportScreen::FileExportScreen(MainEditor& editor,
       exportVideoFolder_.setEnabled(true);
       browseVideoButton_.setEnabled(true);
       browseVideoSourceButton_.setEnabled(true);
+      exportJobLayoutSelector_.setEnabled(true);
+      browseExportJobButton_.setEnabled(true);
+      clearExportJobsButton_.setEnabled(true);
     }
     repaint();
   };
@@ -307,6 +349,7 @@ FileExportScreen::FileExportScreen(MainEditor& editor,
   warningLabel_.setColour(juce::Label::ColourIds::textColourId,
                           EclipsaColours::red);
   refreshFileExportComponents();
+  refreshExportJobComponents();
 }
 
 FileExportScreen::~FileExportScreen() {
@@ -397,6 +440,13 @@ void FileExportScreen::paint(juce::Graphics& g) {
   addAndMakeVisible(audioElements_);
   audioElements_.setBounds(row.removeFromLeft(componentWidth));
 
+  // Draw in the timings of the last export
+  leftSideBounds.removeFromTop(columnPadding);
+  row = leftSideBounds.removeFromTop(rowHeight);
+  addAndMakeVisible(exportProfileLabel_);
+  exportProfileLabel_.setBounds(
+      row.removeFromLeft(componentWidth * 2 + rowPadding));
+
   /* ==============================================
    *  Draw in the right side file selection options
    * ==============================================
@@ -429,6 +479,20 @@ void FileExportScreen::paint(juce::Graphics& g) {
   addAndMakeVisible(exportAudioElementsLabel_);
   exportAudioElementsLabel_.setBounds(row.removeFromLeft(componentWidth));
 
+  // Add the additional layouts rendered during the export
+  row = bounds.removeFromTop(rowHeight);
+  addAndMakeVisible(exportJobLayoutSelector_);
+  exportJobLayoutSelector_.setBounds(row.removeFromLeft(175));
+  addAndMakeVisible(browseExportJobButton_);
+  browseExportJobButton_.setBounds(
+      row.removeFromLeft(75).withTrimmedTop(10).reduced(20));
+  addAndMakeVisible(clearExportJobsButton_);
+  clearExportJobsButton_.setBounds(
+      row.removeFromLeft(125).withTrimmedTop(20).reduced(0, 5));
+  row.removeFromLeft(rowPadding);
+  addAndMakeVisible(exportJobsLabel_);
+  exportJobsLabel_.setBounds(row.withTrimmedTop(20));
+
   // Only draw video export options if the audio export is enabled.
   if (enableFileExport_.getToggleState()) {
     // Add the mux video components
@@ -599,6 +663,7 @@ void FileExportScreen::valueTreeRedirected(
     juce::ValueTree& treeWhichHasBeenChanged) {
   if (treeWhichHasBeenChanged.getType() == repository_->getTree().getType()) {
     refreshFileExportComponents();
+    refreshExportJobComponents();
   } else {
     refreshComponents();
   }
@@ -610,6 +675,8 @@ void FileExportScreen::valueTreePropertyChanged(
   if (treeWhosePropertyHasChanged.getType() ==
       repository_->getTree().getType()) {
     refreshFileExportComponents();
+  } else if (treeWhosePropertyHasChanged.getType() == ExportJob::kTreeType) {
+    refreshExportJobComponents();
   } else {
     refreshComponents();
   }
@@ -619,6 +686,8 @@ void FileExportScreen::valueTreeChildAdded(
     juce::ValueTree& parentTree, juce::ValueTree& childWhichHasBeenAdded) {
   if (childWhichHasBeenAdded.getType() == repository_->getTree().getType()) {
     refreshFileExportComponents();
+  } else if (childWhichHasBeenAdded.getType() == ExportJob::kTreeType) {
+    refreshExportJobComponents();
   } else {
     refreshComponents();
   }
@@ -629,6 +698,8 @@ void FileExportScreen::valueTreeChildRemoved(
     int indexFromWhichChildWasRemoved) {
   if (childWhichHasBeenRemoved.getType() == repository_->getTree().getType()) {
     refreshFileExportComponents();
+  } else if (childWhichHasBeenRemoved.getType() == ExportJob::kTreeType) {
+    refreshExportJobComponents();
   } else {
     refreshComponents();
   }
@@ -651,9 +722,43 @@ void FileExportScreen::refreshFileExportComponents() {
                             EclipsaColours::green);
   }
 
+  // Show the profile written by the last export to the configured file
+  std::optional<ExportProfile> profile = ExportProfile::readFromFile(
+      ExportProfile::getProfileFile(config.getExportFile()));
+  exportProfileLabel_.setText(profile ? profile->getSummary() : "",
+                              juce::NotificationType::dontSendNotification);
+
+  repaint();
+}
+
+void FileExportScreen::refreshExportJobComponents() {
+  juce::OwnedArray<ExportJob> jobs;
+  getExportJobRepository(*repository_).getAll(jobs);
+
+  // List each additional layout with the file it is exported to
+  juce::StringArray jobDescriptions;
+  for (const ExportJob* job : jobs) {
+    jobDescriptions.add(job->getLayout().toString() + ": " +
+                        juce::File(job->getExportFile()).getFileName());
+  }
+  exportJobsLabel_.setText(jobDescriptions.joinIntoString("\n"),
+                           juce::NotificationType::dontSendNotification);
   repaint();
 }
 
+void FileExportScreen::addExportJob(const juce::File& file) {
+  const int layoutIndex = exportJobLayoutSelector_.getSelectedIndex();
+  if (layoutIndex < 0) {
+    return;
+  }
+  const RoomLayout& layout = speakerLayoutConfigurationOptions[layoutIndex];
+  getExportJobRepository(*repository_)
+      .add(ExportJob(juce::Uuid(), layout.getRoomSpeakerLayout(),
+                     file.getFullPathName(), repository_->get().getBitDepth()));
+  LOG_ANALYTICS(RendererProcessor::instanceId_,
+                "Added export job: " + layout.getDescription().toStdString());
+}
+
 bool FileExportScreen::validFileExportConfig(const FileExport& config) {
   // Check if the export file is valid
   if (config.getExportFile().isEmpty()) {
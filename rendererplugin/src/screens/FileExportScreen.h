@@ -23,6 +23,7 @@
 #include "components/src/TitledLabel.h"
 #include "components/src/TitledTextBox.h"
 #include "data_repository/implementation/AudioElementRepository.h"
+#include "data_repository/implementation/ExportJobRepository.h"
 #include "data_repository/implementation/FileExportRepository.h"
 #include "data_repository/implementation/MixPresentationRepository.h"
 #include "data_structures/src/FileExport.h"
@@ -38,6 +39,8 @@ class FileExportScreen : public juce::Component,
 
   void refreshFileExportComponents();
 
+  void refreshExportJobComponents();
+
   void paint(juce::Graphics& g);
 
   void valueTreeRedirected(juce::ValueTree& treeWhichHasBeenChanged) override;
@@ -56,6 +59,9 @@ class FileExportScreen : public juce::Component,
 
   bool validFileExportConfig(const FileExport& config);
 
+  // Add an export job rendering the selected layout to the given WAV file.
+  void addExportJob(const juce::File& file);
+
   FileExportRepository* repository_;
   AudioElementRepository* aeRepository_;
   MixPresentationRepository* mpRepository_;
@@ -81,6 +87,7 @@ class FileExportScreen : public juce::Component,
   juce::Label customCodecParameterErrorLabel_;
   TitledLabel mixPresentations_;
   TitledLabel audioElements_;
+  juce::Label exportProfileLabel_;
 
   // Right side elements
   juce::Label exportAudioLabel_;
@@ -95,11 +102,16 @@ class FileExportScreen : public juce::Component,
   juce::ImageButton browseVideoButton_;
   TitledTextBox videoSource_;
   juce::ImageButton browseVideoSourceButton_;
+  SelectionBox exportJobLayoutSelector_;
+  juce::ImageButton browseExportJobButton_;
+  juce::Label exportJobsLabel_;
+  juce::TextButton clearExportJobsButton_;
 
   // File selection elements
   juce::FileChooser audioOutputSelect_;
   juce::FileChooser muxVideoSourceSelect_;
   juce::FileChooser muxVideoOutputSelect_;
+  juce::FileChooser exportJobSelect_;
 
   // Manual export button -- To be removed later
   juce::TextButton exportButton_;
@@ -231,33 +231,51 @@ void RoomMonitoringScreen::updateRoomView() {
 // with audio elements that are a part of the active mix presentation.
 void RoomMonitoringScreen::updateActiveIDs(
     RepositoryCollection& repos, std::unique_ptr<PerspectiveRoomView>& prv) {
-  const juce::Uuid kActiveMix = repos.activeMPRepo_.get().getActiveMixId();
-  const MixPresentation kActiveMixPres = repos.mpRepo_.get(kActiveMix).value();
+  const juce::Uuid kActiveMix =
+      repos.activeMPRepo_.getSnapshot()->item.getActiveMixId();
+  const auto mixPresentations = repos.mpRepo_.getSnapshot();
   activeAudioElementIDs_.clear();
-  for (const MixPresentationAudioElement& ae :
-       kActiveMixPres.getAudioElements()) {
-    activeAudioElementIDs_.insert(ae.getId());
+  for (const MixPresentation& mixPres : mixPresentations->items) {
+    if (mixPres.getId() != kActiveMix) {
+      continue;
+    }
+    for (const MixPresentationAudioElement& ae : mixPres.getAudioElements()) {
+      activeAudioElementIDs_.insert(ae.getId());
+    }
   }
+  // Look the active tracks up again on the next refresh
+  activeTracksVersion_ = 0;
 }
 
 void RoomMonitoringScreen::updateActiveTrackData() {
+  // The tracks in the active mix only change with the spatial layouts or the
+  // active mix, not on every refresh
+  const auto spatialLayouts =
+      repos_.audioElementSpatialLayoutRepo_.getSnapshot();
+  if (spatialLayouts->version != activeTracksVersion_) {
+    activeTracksVersion_ = spatialLayouts->version;
+    activeTrackIDs_.clear();
+    for (const AudioElementSpatialLayout& spatialLayout :
+         spatialLayouts->items) {
+      if (activeAudioElementIDs_.contains(spatialLayout.getAudioElementId())) {
+        activeTrackIDs_.insert(spatialLayout.getId());
+      }
+    }
+  }
+
   std::vector<AudioElementUpdateData> activeTracks;
-  repos_.audioElementSubscriber_.getData([&](AudioElementUpdateData data) {
+  repos_.audioElementSubscriber_.getSnapshot(trackSnapshot_);
+  for (const AudioElementUpdateData& data : trackSnapshot_) {
     // First check if this track is part of the active mix, with a memcpy to
     // circumvent illegal pointer conversions.
     juce::uint8 rawUUID[sizeof(AudioElementUpdateData::uuid)];
     std::memcpy(rawUUID, data.uuid.data(),
                 sizeof(AudioElementUpdateData::uuid));
 
-    const std::optional<AudioElementSpatialLayout> kAudioElementSpatialLayout =
-        repos_.audioElementSpatialLayoutRepo_.get(juce::Uuid(rawUUID));
-
-    if (kAudioElementSpatialLayout &&
-        activeAudioElementIDs_.contains(
-            kAudioElementSpatialLayout->getAudioElementId())) {
+    if (activeTrackIDs_.contains(juce::Uuid(rawUUID))) {
       activeTracks.push_back(data);
     }
-  });
+  }
   roomView_->setTracks(activeTracks);
 }
 
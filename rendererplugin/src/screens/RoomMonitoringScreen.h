@@ -50,6 +50,11 @@ class RoomMonitoringScreen : public juce::Component,
   RepositoryCollection repos_;
   SpeakerMonitorData& monitorData_;
   std::unordered_set<juce::Uuid> activeAudioElementIDs_;
+  // Spatial layout IDs of the tracks in the active mix, as of the spatial
+  // layout repository version they were looked up from
+  std::unordered_set<juce::Uuid> activeTrackIDs_;
+  uint64_t activeTracksVersion_ = 0;
+  std::vector<AudioElementUpdateData> trackSnapshot_;
   // Components.
   SelectionBox speakerSetup_;
   ImageTextButton exportButton;
@@ -388,7 +388,12 @@ void PresentationEditorTab::audioElementChangedCallback() {
                                 .value_or(MixPresentation());
   mixPres.addAudioElement(allAudioElementsArray_[index]->getId(), 1,
                           allAudioElementsArray_[index]->getName());
-  mixPresentationRepository_->update(mixPres);
+  {
+    // The update replaces all of the mix presentation's children, listeners
+    // that rebuild on changes should only do so once
+    auto transaction = mixPresentationRepository_->beginTransaction();
+    mixPresentationRepository_->update(mixPres);
+  }
   addToAlreadyDrawnMap(allAudioElementsArray_[index]->getId());
 
   repaint();
@@ -496,7 +501,10 @@ void PresentationEditorTab::buttonClicked(juce::Button* button) {
           mixPresentationRepository_->get(mixPresentationId_)
               .value_or(MixPresentation());
       mixPres.removeAudioElement(pair.first);
-      mixPresentationRepository_->update(mixPres);
+      {
+        auto transaction = mixPresentationRepository_->beginTransaction();
+        mixPresentationRepository_->update(mixPres);
+      }
       removeFromAlreadyDrawnMap(pair.first);
       return;
     }
@@ -130,6 +130,36 @@ TEST(test_renderer_processor, processor_chain) {
   }
 }
 
+TEST(test_renderer_processor, processes_each_host_buffer) {
+  const int kSampleRate = 48e3;
+  const int kSamplesPerFrame = 128;
+  const int kNumChannels_ = Speakers::kHOA5.getNumChannels();
+  const float kGain = 0.5f;
+
+  RendererProcessor rendererProcessor;
+  manuallyConfigureRepositories(rendererProcessor);
+  MultiChannelRepository& multiChannelRepository =
+      rendererProcessor.getRepositories().chGainRepo_;
+  ChannelGains channelGains = multiChannelRepository.get();
+  channelGains.setChannelGain(0, kGain);
+  multiChannelRepository.update(channelGains);
+  rendererProcessor.prepareToPlay(kSampleRate, kSamplesPerFrame);
+
+  // The chain runs in place on whichever buffer the host passes, including
+  // a shorter block than prepared
+  juce::MidiBuffer midiBuffer;
+  for (const int numSamples : {kSamplesPerFrame, kSamplesPerFrame / 2}) {
+    juce::AudioBuffer<float> audioBuffer(kNumChannels_, numSamples);
+    for (int i = 0; i < numSamples; ++i) {
+      audioBuffer.setSample(0, i, 0.1f);
+    }
+    rendererProcessor.processBlock(audioBuffer, midiBuffer);
+    for (int i = 0; i < numSamples; ++i) {
+      ASSERT_FLOAT_EQ(audioBuffer.getSample(0, i), 0.1f * kGain);
+    }
+  }
+}
+
 std::filesystem::path manuallyConfigureFileExport(
     RendererProcessor& rendererProcessor, const juce::String& fileName,
     const float kAudioDuration_s, const int& kSampleRate) {
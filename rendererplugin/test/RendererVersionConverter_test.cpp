@@ -32,4 +32,14 @@ TEST(RendererVersionConverterTest, DoesNotOverwriteExistingVersion) {
 
   RendererVersionConverter::convertToLatestVersion(xml);
   EXPECT_EQ(xml->getStringAttribute("version"), "1.1.1");
-}
\ No newline at end of file
+}
+
+TEST(RendererVersionConverterTest, AddsVersionPropertyToRestoredTree) {
+  juce::ValueTree state("State");
+  RendererVersionConverter::convertToLatestVersion(state);
+  EXPECT_EQ(state["version"].toString(), "1.1.1");
+
+  state.setProperty("version", "1.2.0", nullptr);
+  RendererVersionConverter::convertToLatestVersion(state);
+  EXPECT_EQ(state["version"].toString(), "1.2.0");
+}
@@ -0,0 +1,209 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../src/SyncSocketServer.h"
+
+#include <gtest/gtest.h>
+#include <juce_events/juce_events.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+
+namespace {
+class TestListener : public SyncSocketServer::Listener {
+ public:
+  SyncSocketServer* server = nullptr;
+
+  void connectionOpened(SyncSocketServer::ConnectionId id) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    opened_.push_back(id);
+    condition_.notify_all();
+  }
+
+  void connectionClosed(SyncSocketServer::ConnectionId id) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++numClosed_;
+    condition_.notify_all();
+  }
+
+  // Echo messages back to the sender
+  void messageReceived(SyncSocketServer::ConnectionId id,
+                       const juce::MemoryBlock& message) override {
+    server->send(id, message);
+  }
+
+  bool waitForOpened(const size_t count) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return condition_.wait_for(lock, std::chrono::seconds(10),
+                               [&] { return opened_.size() >= count; });
+  }
+
+  bool waitForClosed(const int count) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return condition_.wait_for(lock, std::chrono::seconds(10),
+                               [&] { return numClosed_ >= count; });
+  }
+
+  std::vector<SyncSocketServer::ConnectionId> getOpened() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return opened_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::vector<SyncSocketServer::ConnectionId> opened_;
+  int numClosed_ = 0;
+};
+
+// A simulated audio element plugin, connecting the way the plugins do
+class TestClient : public juce::InterprocessConnection {
+ public:
+  TestClient() : juce::InterprocessConnection(false) {}
+  ~TestClient() override { disconnect(); }
+
+  void connectionMade() override {}
+  void connectionLost() override {}
+
+  void messageReceived(const juce::MemoryBlock& message) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++numReceived_;
+    lastMessage_ = message;
+    condition_.notify_all();
+  }
+
+  bool waitForMessages(const int count) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return condition_.wait_for(lock, std::chrono::seconds(10),
+                               [&] { return numReceived_ >= count; });
+  }
+
+  juce::MemoryBlock getLastMessage() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lastMessage_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  int numReceived_ = 0;
+  juce::MemoryBlock lastMessage_;
+};
+
+int startOnFreePort(SyncSocketServer& server) {
+  for (int port = 23400; port < 23500; ++port) {
+    if (server.start(port)) {
+      return port;
+    }
+  }
+  return -1;
+}
+}  // namespace
+
+TEST(test_sync_socket_server, echo_and_port_in_use) {
+  TestListener listener;
+  SyncSocketServer server(listener);
+  listener.server = &server;
+  const int port = startOnFreePort(server);
+  ASSERT_GT(port, 0);
+
+  TestListener otherListener;
+  SyncSocketServer other(otherListener);
+  EXPECT_FALSE(other.start(port));
+
+  TestClient client;
+  ASSERT_TRUE(client.connectToSocket("localhost", port, 1000));
+  ASSERT_TRUE(listener.waitForOpened(1));
+
+  const juce::MemoryBlock message("repository", 10);
+  ASSERT_TRUE(client.sendMessage(message));
+  ASSERT_TRUE(client.waitForMessages(1));
+  EXPECT_EQ(client.getLastMessage(), message);
+
+  client.disconnect();
+  EXPECT_TRUE(listener.waitForClosed(1));
+  EXPECT_EQ(server.getNumConnections(), 0);
+}
+
+// Load test: fan an update out to a large session's worth of plugins
+TEST(test_sync_socket_server, fan_out_to_many_clients) {
+  constexpr int kNumClients = 200;
+  constexpr int kNumUpdates = 20;
+
+  TestListener listener;
+  SyncSocketServer server(listener);
+  listener.server = &server;
+  const int port = startOnFreePort(server);
+  ASSERT_GT(port, 0);
+
+  std::vector<std::unique_ptr<TestClient>> clients;
+  for (int i = 0; i < kNumClients; ++i) {
+    clients.push_back(std::make_unique<TestClient>());
+    ASSERT_TRUE(clients.back()->connectToSocket("localhost", port, 1000));
+  }
+  ASSERT_TRUE(listener.waitForOpened(kNumClients));
+  EXPECT_EQ(server.getNumConnections(), kNumClients);
+  const std::vector<SyncSocketServer::ConnectionId> ids = listener.getOpened();
+
+  // A typical delta is a few dozen bytes
+  juce::MemoryBlock update;
+  update.setSize(64, true);
+  double worstMs = 0.0;
+  double totalMs = 0.0;
+  for (int i = 1; i <= kNumUpdates; ++i) {
+    const double start = juce::Time::getMillisecondCounterHiRes();
+    for (const SyncSocketServer::ConnectionId id : ids) {
+      ASSERT_TRUE(server.send(id, update));
+    }
+    for (const auto& client : clients) {
+      ASSERT_TRUE(client->waitForMessages(i));
+    }
+    const double elapsedMs = juce::Time::getMillisecondCounterHiRes() - start;
+    worstMs = std::max(worstMs, elapsedMs);
+    totalMs += elapsedMs;
+  }
+
+  RecordProperty("mean_fan_out_us", (int)(1000.0 * totalMs / kNumUpdates));
+  RecordProperty("worst_fan_out_us", (int)(1000.0 * worstMs));
+  EXPECT_LT(worstMs, 1000.0);
+
+  clients.clear();
+  EXPECT_TRUE(listener.waitForClosed(kNumClients));
+}
+
+TEST(test_sync_socket_server, slow_client_is_disconnected) {
+  TestListener listener;
+  SyncSocketServer server(listener);
+  listener.server = &server;
+  const int port = startOnFreePort(server);
+  ASSERT_GT(port, 0);
+
+  // Connects but never reads
+  juce::StreamingSocket socket;
+  ASSERT_TRUE(socket.connect("localhost", port, 1000));
+  ASSERT_TRUE(listener.waitForOpened(1));
+  const SyncSocketServer::ConnectionId id = listener.getOpened().front();
+
+  juce::MemoryBlock update;
+  update.setSize(64 * 1024, true);
+  // Well past the queue bound plus what the kernel buffers
+  const size_t maxSends = 8 * SyncSocketServer::kMaxQueuedBytes / 65536;
+  size_t numSent = 0;
+  while (numSent < maxSends && server.send(id, update)) {
+    ++numSent;
+  }
+  EXPECT_LT(numSent, maxSends);
+  EXPECT_TRUE(listener.waitForClosed(1));
+}